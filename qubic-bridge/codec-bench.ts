@@ -0,0 +1,156 @@
+// Contract codec round-trip benchmark
+// Encodes sample values for every struct in contract-schema.ts, times the
+// binary codec against the previous JSON+hex encoding, then sends the bytes
+// through qubic-native/bin/codec_roundtrip and checks that the C++ structs
+// decode the same field values.
+//
+// Usage: npm run qubic:codec-bench [-- iterations]
+
+import { spawnSync } from 'child_process';
+import path from 'path';
+import { fileURLToPath } from 'url';
+import type { StructLayout } from './contract-schema';
+import type { StructInput } from './contract-codec';
+import { STRUCT_LAYOUTS } from './contract-schema';
+import { getCodec, hashFields } from './contract-codec';
+
+const ROOT = path.resolve(path.dirname(fileURLToPath(import.meta.url)), '..');
+const NATIVE_BIN = process.env.QUBIC_CODEC_ROUNDTRIP || path.join(ROOT, 'qubic-native/bin/codec_roundtrip');
+const ITERATIONS = parseInt(process.argv[2] || '200000');
+
+const RECORD_HEADER_SIZE = 8;
+
+// Deterministic sample values that exercise every byte of every field
+function sampleValue(layout: StructLayout, seed: number): StructInput {
+  let state = seed * 2654435761 + 1;
+  const next = () => {
+    state = (Math.imul(state, 1103515245) + 12345) >>> 0;
+    return state;
+  };
+
+  const value: StructInput = {};
+  for (const field of layout.fields) {
+    if (field.type === 'char') {
+      const text = Array.from({ length: field.length - 1 }, () =>
+        String.fromCharCode(32 + (next() % 95))
+      ).join('');
+      value[field.name] = text;
+      continue;
+    }
+
+    const element = () => {
+      switch (field.type) {
+        case 'uint8':
+          return next() & 0xff;
+        case 'uint16':
+          return next() & 0xffff;
+        case 'uint64':
+          return (next() & 0x1fffff) * 0x100000000 + next();
+        case 'sint64':
+          return ((next() & 0x1fffff) - 0x100000) * 0x100000000 + next();
+        default:
+          return next();
+      }
+    };
+
+    value[field.name] = field.length > 1 ? Array.from({ length: field.length }, element) : element();
+  }
+  return value;
+}
+
+function timeLoop(iterations: number, body: () => void): number {
+  // Warm up so the JIT has optimized the body before timing starts
+  for (let i = 0; i < Math.min(iterations, 10000); i++) {
+    body();
+  }
+
+  const start = process.hrtime.bigint();
+  for (let i = 0; i < iterations; i++) {
+    body();
+  }
+  return Number(process.hrtime.bigint() - start) / iterations;
+}
+
+function benchmarkStruct(layout: StructLayout, sample: StructInput) {
+  const codec = getCodec(layout.name);
+  const decoded = codec.create();
+  const encoded = Buffer.from(codec.encode(sample));
+
+  const encodeNs = timeLoop(ITERATIONS, () => codec.encode(sample));
+  const decodeNs = timeLoop(ITERATIONS, () => codec.decodeInto(encoded, 0, decoded));
+  const jsonHex = Buffer.from(JSON.stringify(sample)).toString('hex');
+  const jsonNs = timeLoop(ITERATIONS, () => Buffer.from(JSON.stringify(sample)).toString('hex'));
+
+  return {
+    name: layout.name,
+    binaryBytes: layout.size,
+    jsonBytes: jsonHex.length / 2,
+    encodeNs,
+    decodeNs,
+    jsonNs
+  };
+}
+
+function verifyNative(samples: Map<StructLayout, StructInput>): boolean {
+  const records: Buffer[] = [];
+  const expected: { layout: StructLayout; bytes: Buffer; hash: number }[] = [];
+
+  for (const [layout, sample] of samples) {
+    const codec = getCodec(layout.name);
+    const bytes = Buffer.from(codec.encode(sample));
+    const header = Buffer.alloc(RECORD_HEADER_SIZE);
+    header.writeUInt16LE(layout.id, 0);
+    header.writeUInt32LE(bytes.length, 4);
+    records.push(header, bytes);
+    expected.push({ layout, bytes, hash: hashFields(layout, codec.decode(bytes)) });
+  }
+
+  const result = spawnSync(NATIVE_BIN, ['--bench', String(ITERATIONS)], {
+    input: Buffer.concat(records),
+    maxBuffer: 64 * 1024 * 1024
+  });
+
+  if (result.error || result.status !== 0) {
+    console.error(`Could not run ${NATIVE_BIN}: ${result.error?.message ?? result.stderr.toString()}`);
+    console.error('Build it with: make -C qubic-native');
+    return false;
+  }
+
+  let offset = 0;
+  let ok = true;
+  const output = result.stdout;
+  for (const { layout, bytes, hash } of expected) {
+    const status = output.readUInt16LE(offset + 2);
+    const nativeHash = output.readUInt32LE(offset + 4);
+    const echoed = output.subarray(offset + RECORD_HEADER_SIZE, offset + RECORD_HEADER_SIZE + bytes.length);
+    offset += RECORD_HEADER_SIZE + bytes.length;
+
+    if (status !== 0 || nativeHash !== hash || !echoed.equals(bytes)) {
+      console.error(
+        `MISMATCH ${layout.name}: status=${status} hash ts=${hash.toString(16)} cpp=${nativeHash.toString(16)}`
+      );
+      ok = false;
+    }
+  }
+
+  console.log('\nNative struct round trip (C++ memcpy decode + member hash):');
+  process.stdout.write(result.stderr.toString());
+  return ok;
+}
+
+const samples = new Map<StructLayout, StructInput>();
+STRUCT_LAYOUTS.forEach((layout, index) => samples.set(layout, sampleValue(layout, index + 1)));
+
+console.log(`Contract codec benchmark, ${ITERATIONS} iterations per struct\n`);
+console.log('struct                     binary    json   encode ns   decode ns   json+hex ns');
+for (const [layout, sample] of samples) {
+  const row = benchmarkStruct(layout, sample);
+  console.log(
+    `${row.name.padEnd(24)} ${String(row.binaryBytes).padStart(8)} ${String(row.jsonBytes).padStart(7)}` +
+    ` ${row.encodeNs.toFixed(1).padStart(11)} ${row.decodeNs.toFixed(1).padStart(11)} ${row.jsonNs.toFixed(1).padStart(13)}`
+  );
+}
+
+const agreed = verifyNative(samples);
+console.log(agreed ? '\nAll structs round-trip identically in TypeScript and C++.' : '\nRound trip FAILED.');
+process.exit(agreed ? 0 : 1);
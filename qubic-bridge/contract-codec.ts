@@ -0,0 +1,226 @@
+// PredictoR contract binary codec
+// Encodes and decodes the packed HM25.h input/output structs using the layouts
+// in contract-schema.ts. Encoding writes into a reusable buffer and decoding
+// fills a caller-owned object, so the hot path does not allocate.
+
+import type { StructLayout, FieldLayout } from './contract-schema';
+import { STRUCT_LAYOUTS, getStructLayout } from './contract-schema';
+
+// Char fields decode into a fixed-size Buffer; numeric arrays into number[]
+export type FieldValue = number | number[] | Buffer;
+export type StructValue = Record<string, FieldValue>;
+
+// Accepted on encode: strings and byte arrays for char fields, bigint for uint64 / sint64
+export type FieldInput = FieldValue | string | Uint8Array | bigint | bigint[];
+export type StructInput = Record<string, FieldInput | undefined>;
+
+const TWO_POW_32 = 0x100000000;
+
+export class StructCodec {
+  readonly layout: StructLayout;
+  private readonly scratch: Buffer;
+
+  constructor(layout: StructLayout) {
+    this.layout = layout;
+    this.scratch = Buffer.alloc(layout.size);
+  }
+
+  get size(): number {
+    return this.layout.size;
+  }
+
+  // Encode into the codec's scratch buffer. The returned Buffer is reused by
+  // the next call, so consume or copy it first.
+  encode(value: StructInput): Buffer {
+    this.encodeInto(value, this.scratch, 0);
+    return this.scratch;
+  }
+
+  encodeInto(value: StructInput, target: Buffer, offset = 0): number {
+    // Padding bytes are zeroed so equal values always produce equal bytes
+    target.fill(0, offset, offset + this.layout.size);
+
+    for (const field of this.layout.fields) {
+      const fieldValue = value[field.name];
+      if (fieldValue === undefined) {
+        continue;
+      }
+
+      const base = offset + field.offset;
+      if (field.type === 'char') {
+        writeChars(field, fieldValue, target, base);
+      } else if (field.length === 1 && !Array.isArray(fieldValue)) {
+        writeScalar(field, fieldValue as number | bigint, target, base);
+      } else {
+        const values = fieldValue as ArrayLike<number | bigint>;
+        const count = Math.min(values.length, field.length);
+        for (let i = 0; i < count; i++) {
+          writeScalar(field, values[i], target, base + i * field.elementSize);
+        }
+      }
+    }
+
+    return this.layout.size;
+  }
+
+  // Allocate an output object with every field pre-sized, for reuse with decodeInto
+  create(): StructValue {
+    const value: StructValue = {};
+    for (const field of this.layout.fields) {
+      if (field.type === 'char') {
+        value[field.name] = Buffer.alloc(field.length);
+      } else if (field.length > 1) {
+        value[field.name] = new Array(field.length).fill(0);
+      } else {
+        value[field.name] = 0;
+      }
+    }
+    return value;
+  }
+
+  decode(source: Buffer, offset = 0): StructValue {
+    return this.decodeInto(source, offset, this.create());
+  }
+
+  decodeInto(source: Buffer, offset: number, out: StructValue): StructValue {
+    if (source.length - offset < this.layout.size) {
+      throw new RangeError(
+        `${this.layout.name} needs ${this.layout.size} bytes, got ${source.length - offset}`
+      );
+    }
+
+    for (const field of this.layout.fields) {
+      const base = offset + field.offset;
+      if (field.type === 'char') {
+        source.copy(out[field.name] as Buffer, 0, base, base + field.length);
+      } else if (field.length > 1) {
+        const values = out[field.name] as number[];
+        for (let i = 0; i < field.length; i++) {
+          values[i] = readScalar(field, source, base + i * field.elementSize);
+        }
+      } else {
+        out[field.name] = readScalar(field, source, base);
+      }
+    }
+
+    return out;
+  }
+}
+
+function writeScalar(field: FieldLayout, value: number | bigint, target: Buffer, offset: number): void {
+  switch (field.type) {
+    case 'uint8':
+      target.writeUInt8(Number(value) & 0xff, offset);
+      break;
+    case 'uint16':
+      target.writeUInt16LE(Number(value) & 0xffff, offset);
+      break;
+    case 'uint32':
+      target.writeUInt32LE(Number(value) >>> 0, offset);
+      break;
+    case 'uint64':
+      if (typeof value === 'bigint') {
+        target.writeBigUInt64LE(value, offset);
+      } else {
+        target.writeUInt32LE(value % TWO_POW_32, offset);
+        target.writeUInt32LE(Math.floor(value / TWO_POW_32), offset + 4);
+      }
+      break;
+    case 'sint64':
+      if (typeof value === 'bigint') {
+        target.writeBigInt64LE(value, offset);
+      } else {
+        const high = Math.floor(value / TWO_POW_32);
+        target.writeUInt32LE(value - high * TWO_POW_32, offset);
+        target.writeInt32LE(high, offset + 4);
+      }
+      break;
+  }
+}
+
+// 64-bit fields decode as numbers; counters stay exact up to 2^53
+function readScalar(field: FieldLayout, source: Buffer, offset: number): number {
+  switch (field.type) {
+    case 'uint8':
+      return source.readUInt8(offset);
+    case 'uint16':
+      return source.readUInt16LE(offset);
+    case 'uint64':
+      return source.readUInt32LE(offset + 4) * TWO_POW_32 + source.readUInt32LE(offset);
+    case 'sint64':
+      return source.readInt32LE(offset + 4) * TWO_POW_32 + source.readUInt32LE(offset);
+    default:
+      return source.readUInt32LE(offset);
+  }
+}
+
+function writeChars(field: FieldLayout, value: FieldInput, target: Buffer, offset: number): void {
+  if (typeof value === 'string') {
+    target.write(value, offset, field.length, 'utf8');
+  } else if (Buffer.isBuffer(value) || value instanceof Uint8Array) {
+    target.set(value.subarray(0, field.length), offset);
+  } else if (Array.isArray(value)) {
+    const count = Math.min(value.length, field.length);
+    for (let i = 0; i < count; i++) {
+      target[offset + i] = Number(value[i]) & 0xff;
+    }
+  }
+}
+
+// Read a NUL-terminated char field as a string
+export function readCString(bytes: Buffer): string {
+  const end = bytes.indexOf(0);
+  return bytes.toString('utf8', 0, end === -1 ? bytes.length : end);
+}
+
+// FNV-1a over the canonical field bytes. The generated C++ header computes the
+// same hash from struct members, so matching hashes prove both sides agree on
+// every field's value, not just on the raw bytes.
+export function hashFields(layout: StructLayout, value: StructValue): number {
+  let hash = 0x811c9dc5;
+  const mix = (byte: number) => {
+    hash = Math.imul(hash ^ (byte & 0xff), 0x01000193) >>> 0;
+  };
+
+  for (const field of layout.fields) {
+    const fieldValue = value[field.name];
+    if (field.type === 'char') {
+      const bytes = fieldValue as Buffer;
+      for (let i = 0; i < field.length; i++) {
+        mix(bytes[i]);
+      }
+      continue;
+    }
+
+    const values = field.length > 1 ? (fieldValue as number[]) : [fieldValue as number];
+    for (const element of values) {
+      // Two's complement bytes for negative sint64 values
+      let high = Math.floor(element / TWO_POW_32);
+      let low = element - high * TWO_POW_32;
+      for (let i = 0; i < field.elementSize; i++) {
+        if (i < 4) {
+          mix(low);
+          low = Math.floor(low / 256);
+        } else {
+          mix(high);
+          high = Math.floor(high / 256);
+        }
+      }
+    }
+  }
+
+  return hash;
+}
+
+const codecs = new Map<string, StructCodec>(
+  STRUCT_LAYOUTS.map((layout) => [layout.name, new StructCodec(layout)])
+);
+
+export function getCodec(structName: string): StructCodec {
+  let codec = codecs.get(structName);
+  if (!codec) {
+    codec = new StructCodec(getStructLayout(structName));
+    codecs.set(structName, codec);
+  }
+  return codec;
+}
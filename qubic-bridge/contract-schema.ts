@@ -0,0 +1,462 @@
+// PredictoR contract I/O schema
+// Single description of the packed input/output structs in qubic-contracts/HM25.h.
+// The bridge codec (contract-codec.ts) and the generated C++ layout assertions
+// (qubic-native/include/contract_layout.h) are both derived from this file.
+
+export type ScalarType = 'uint8' | 'uint16' | 'uint32' | 'uint64' | 'sint64' | 'char';
+
+export interface FieldSchema {
+  name: string;
+  type: ScalarType;
+  length?: number;  // Array length; omitted for scalar fields
+}
+
+export interface StructSchema {
+  name: string;
+  fields: FieldSchema[];
+}
+
+export interface FieldLayout extends FieldSchema {
+  length: number;
+  elementSize: number;
+  offset: number;
+  size: number;
+  align: number;
+}
+
+export interface StructLayout {
+  id: number;
+  name: string;
+  fields: FieldLayout[];
+  size: number;
+  align: number;
+}
+
+export interface FunctionSchema {
+  index: number;
+  name: string;
+  input: string;
+  output: string;
+}
+
+const ELEMENT_SIZES: Record<ScalarType, number> = {
+  uint8: 1,
+  uint16: 2,
+  uint32: 4,
+  uint64: 8,
+  sint64: 8,
+  char: 1
+};
+
+// Counter array lengths (STAT_PROCEDURE_COUNT / REJECT_REASON_COUNT in HM25.h)
+export const STAT_PROCEDURE_COUNT = 22;
+export const REJECT_REASON_COUNT = 14;
+
+// Entries per ResolveEvents call (MAX_RESOLVE_BATCH in HM25.h)
+export const MAX_RESOLVE_BATCH = 64;
+
+// Users kept on the leaderboard (LEADERBOARD_SIZE in HM25.h)
+export const LEADERBOARD_SIZE = 50;
+
+// Outcomes of one market (MAX_OUTCOMES in HM25.h)
+export const MAX_OUTCOMES = 16;
+
+// Struct definitions, in the same order and with the same field names as HM25.h
+export const CONTRACT_STRUCTS: StructSchema[] = [
+  {
+    name: 'RegisterUserInput',
+    fields: [
+      { name: 'username', type: 'char', length: 32 },
+      { name: 'passwordHash', type: 'char', length: 32 }
+    ]
+  },
+  {
+    name: 'RegisterUserOutput',
+    fields: [
+      { name: 'userId', type: 'uint32' },
+      { name: 'balance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'CreateEventInput',
+    fields: [
+      { name: 'title', type: 'char', length: 128 },
+      { name: 'description', type: 'char', length: 256 },
+      { name: 'category', type: 'char', length: 32 },
+      { name: 'endsAt', type: 'uint32' },
+      { name: 'outcomeCount', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'CreateEventOutput',
+    fields: [
+      { name: 'eventId', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'PlaceBetInput',
+    fields: [
+      { name: 'userId', type: 'uint32' },
+      { name: 'eventId', type: 'uint32' },
+      { name: 'prediction', type: 'uint8' },
+      { name: 'amount', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'PlaceBetOutput',
+    fields: [
+      { name: 'betId', type: 'uint32' },
+      { name: 'newBalance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ResolveEventInput',
+    fields: [
+      { name: 'eventId', type: 'uint32' },
+      { name: 'correctAnswer', type: 'uint8' },
+      { name: 'confidence', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ResolveEventOutput',
+    fields: [
+      { name: 'winnersCount', type: 'uint32' },
+      { name: 'totalPayout', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetBalanceInput',
+    fields: [
+      { name: 'userId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetBalanceOutput',
+    fields: [
+      { name: 'balance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetEventsInput',
+    fields: [
+      { name: 'startIndex', type: 'uint32' },
+      { name: 'count', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetEventsOutput',
+    fields: [
+      { name: 'eventCount', type: 'uint32' },
+      { name: 'events', type: 'char', length: 1000 },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetContractStatsInput',
+    fields: []
+  },
+  {
+    name: 'GetContractStatsOutput',
+    fields: [
+      { name: 'invocationCount', type: 'uint32', length: STAT_PROCEDURE_COUNT },
+      { name: 'rejectionCount', type: 'uint32', length: REJECT_REASON_COUNT },
+      { name: 'elementsScanned', type: 'uint64', length: STAT_PROCEDURE_COUNT },
+      { name: 'lastElementsScanned', type: 'uint32', length: STAT_PROCEDURE_COUNT },
+      { name: 'settlementBacklog', type: 'uint32' },
+      { name: 'userCount', type: 'uint32' },
+      { name: 'eventCount', type: 'uint32' },
+      { name: 'betCount', type: 'uint32' },
+      { name: 'totalVolume', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'PlaceOrderInput',
+    fields: [
+      { name: 'userId', type: 'uint32' },
+      { name: 'eventId', type: 'uint32' },
+      { name: 'quantity', type: 'uint32' },
+      { name: 'side', type: 'uint8' },
+      { name: 'price', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'PlaceOrderOutput',
+    fields: [
+      { name: 'orderId', type: 'uint32' },
+      { name: 'filledQuantity', type: 'uint32' },
+      { name: 'restingQuantity', type: 'uint32' },
+      { name: 'fillCost', type: 'uint32' },
+      { name: 'newBalance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'CancelOrderInput',
+    fields: [
+      { name: 'userId', type: 'uint32' },
+      { name: 'orderId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'CancelOrderOutput',
+    fields: [
+      { name: 'refund', type: 'uint32' },
+      { name: 'newBalance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetBestBidAskInput',
+    fields: [
+      { name: 'eventId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetBestBidAskOutput',
+    fields: [
+      { name: 'bidQuantity', type: 'uint32' },
+      { name: 'askQuantity', type: 'uint32' },
+      { name: 'bestBid', type: 'uint8' },
+      { name: 'bestAsk', type: 'uint8' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'EnableMarketMakerInput',
+    fields: [
+      { name: 'eventId', type: 'uint32' },
+      { name: 'liquidity', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'EnableMarketMakerOutput',
+    fields: [
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'QuoteBetInput',
+    fields: [
+      { name: 'eventId', type: 'uint32' },
+      { name: 'amount', type: 'uint32' },
+      { name: 'prediction', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'QuoteBetOutput',
+    fields: [
+      { name: 'cost', type: 'uint32' },
+      { name: 'yesPriceBps', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ConfigureShardInput',
+    fields: [
+      { name: 'shardIndex', type: 'uint32' },
+      { name: 'shardCount', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'ConfigureShardOutput',
+    fields: [
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ShardTransferInput',
+    fields: [
+      { name: 'userId', type: 'uint32' },
+      { name: 'amount', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'ShardTransferOutput',
+    fields: [
+      { name: 'newBalance', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ResolveEventsInput',
+    fields: [
+      { name: 'eventIds', type: 'uint32', length: MAX_RESOLVE_BATCH },
+      { name: 'correctAnswers', type: 'uint8', length: MAX_RESOLVE_BATCH },
+      { name: 'confidences', type: 'uint8', length: MAX_RESOLVE_BATCH },
+      { name: 'count', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'ResolveEventsOutput',
+    fields: [
+      { name: 'winnersCount', type: 'uint32', length: MAX_RESOLVE_BATCH },
+      { name: 'totalPayout', type: 'uint32', length: MAX_RESOLVE_BATCH },
+      { name: 'resolved', type: 'uint8', length: MAX_RESOLVE_BATCH },
+      { name: 'resolvedCount', type: 'uint8' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetLeaderboardInput',
+    fields: [
+      { name: 'count', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetLeaderboardOutput',
+    fields: [
+      { name: 'userIds', type: 'uint32', length: LEADERBOARD_SIZE },
+      { name: 'totalWins', type: 'uint32', length: LEADERBOARD_SIZE },
+      { name: 'totalBets', type: 'uint32', length: LEADERBOARD_SIZE },
+      { name: 'balances', type: 'uint32', length: LEADERBOARD_SIZE },
+      { name: 'count', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetUserSummaryInput',
+    fields: [
+      { name: 'userId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetUserSummaryOutput',
+    fields: [
+      { name: 'openStake', type: 'uint64' },
+      { name: 'realizedPnl', type: 'sint64' },
+      { name: 'balance', type: 'uint32' },
+      { name: 'totalBets', type: 'uint32' },
+      { name: 'totalWins', type: 'uint32' },
+      { name: 'openBets', type: 'uint32' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'GetOutcomeTallyInput',
+    fields: [
+      { name: 'eventId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'GetOutcomeTallyOutput',
+    fields: [
+      { name: 'bets', type: 'uint32', length: MAX_OUTCOMES },
+      { name: 'outcomeCount', type: 'uint8' },
+      { name: 'isResolved', type: 'uint8' },
+      { name: 'correctAnswer', type: 'uint8' },
+      { name: 'hasMarketMaker', type: 'uint8' },
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'UnregisterUserInput',
+    fields: [
+      { name: 'userId', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'UnregisterUserOutput',
+    fields: [
+      { name: 'success', type: 'uint8' }
+    ]
+  },
+  {
+    name: 'SetMaxOpenStakeInput',
+    fields: [
+      { name: 'maxOpenStake', type: 'uint32' }
+    ]
+  },
+  {
+    name: 'SetMaxOpenStakeOutput',
+    fields: [
+      { name: 'success', type: 'uint8' }
+    ]
+  }
+];
+
+// Registered entry points (REGISTER_USER_FUNCTION indices in HM25.h)
+export const CONTRACT_FUNCTIONS: FunctionSchema[] = [
+  { index: 0, name: 'RegisterUser', input: 'RegisterUserInput', output: 'RegisterUserOutput' },
+  { index: 1, name: 'CreateEvent', input: 'CreateEventInput', output: 'CreateEventOutput' },
+  { index: 2, name: 'PlaceBet', input: 'PlaceBetInput', output: 'PlaceBetOutput' },
+  { index: 3, name: 'ResolveEvent', input: 'ResolveEventInput', output: 'ResolveEventOutput' },
+  { index: 4, name: 'GetBalance', input: 'GetBalanceInput', output: 'GetBalanceOutput' },
+  { index: 5, name: 'GetEvents', input: 'GetEventsInput', output: 'GetEventsOutput' },
+  { index: 6, name: 'GetUserBets', input: 'GetBalanceInput', output: 'GetBalanceOutput' },
+  { index: 7, name: 'GetContractStats', input: 'GetContractStatsInput', output: 'GetContractStatsOutput' },
+  { index: 8, name: 'PlaceOrder', input: 'PlaceOrderInput', output: 'PlaceOrderOutput' },
+  { index: 9, name: 'CancelOrder', input: 'CancelOrderInput', output: 'CancelOrderOutput' },
+  { index: 10, name: 'GetBestBidAsk', input: 'GetBestBidAskInput', output: 'GetBestBidAskOutput' },
+  { index: 11, name: 'EnableMarketMaker', input: 'EnableMarketMakerInput', output: 'EnableMarketMakerOutput' },
+  { index: 12, name: 'QuoteBet', input: 'QuoteBetInput', output: 'QuoteBetOutput' },
+  { index: 13, name: 'ConfigureShard', input: 'ConfigureShardInput', output: 'ConfigureShardOutput' },
+  { index: 14, name: 'ShardTransferOut', input: 'ShardTransferInput', output: 'ShardTransferOutput' },
+  { index: 15, name: 'ShardTransferIn', input: 'ShardTransferInput', output: 'ShardTransferOutput' },
+  { index: 16, name: 'ResolveEvents', input: 'ResolveEventsInput', output: 'ResolveEventsOutput' },
+  { index: 17, name: 'GetLeaderboard', input: 'GetLeaderboardInput', output: 'GetLeaderboardOutput' },
+  { index: 18, name: 'GetUserSummary', input: 'GetUserSummaryInput', output: 'GetUserSummaryOutput' },
+  { index: 19, name: 'GetOutcomeTally', input: 'GetOutcomeTallyInput', output: 'GetOutcomeTallyOutput' },
+  { index: 20, name: 'UnregisterUser', input: 'UnregisterUserInput', output: 'UnregisterUserOutput' },
+  { index: 21, name: 'SetMaxOpenStake', input: 'SetMaxOpenStakeInput', output: 'SetMaxOpenStakeOutput' }
+];
+
+function alignUp(value: number, align: number): number {
+  return Math.ceil(value / align) * align;
+}
+
+// Lay out a struct with the natural alignment rules the C++ compiler uses
+export function layoutStruct(schema: StructSchema, id: number): StructLayout {
+  let offset = 0;
+  let align = 1;
+
+  const fields = schema.fields.map((field) => {
+    const elementSize = ELEMENT_SIZES[field.type];
+    const length = field.length ?? 1;
+    offset = alignUp(offset, elementSize);
+
+    const layout: FieldLayout = {
+      ...field,
+      length,
+      elementSize,
+      offset,
+      size: elementSize * length,
+      align: elementSize
+    };
+
+    offset += layout.size;
+    align = Math.max(align, elementSize);
+    return layout;
+  });
+
+  // Empty structs still occupy one byte in C++
+  const size = fields.length === 0 ? 1 : alignUp(offset, align);
+
+  return { id, name: schema.name, fields, size, align };
+}
+
+export const STRUCT_LAYOUTS: StructLayout[] = CONTRACT_STRUCTS.map(layoutStruct);
+
+const layoutsByName = new Map(STRUCT_LAYOUTS.map((layout) => [layout.name, layout]));
+const functionsByName = new Map(CONTRACT_FUNCTIONS.map((fn) => [fn.name, fn]));
+
+export function getStructLayout(name: string): StructLayout {
+  const layout = layoutsByName.get(name);
+  if (!layout) {
+    throw new Error(`Unknown contract struct: ${name}`);
+  }
+  return layout;
+}
+
+export function getFunction(name: string): FunctionSchema {
+  const fn = functionsByName.get(name);
+  if (!fn) {
+    throw new Error(`Unknown contract function: ${name}`);
+  }
+  return fn;
+}
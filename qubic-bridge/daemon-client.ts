@@ -0,0 +1,185 @@
+// qubic_clientd client
+// Keeps one persistent local socket to the native daemon and multiplexes
+// requests over it by requestId, so many calls can be in flight at once.
+// A request fails when the connection drops or no response arrives within
+// the timeout; the daemon may still deliver a transaction it timed out on.
+
+import net from 'net';
+import type { FrameHeader } from './wire-protocol';
+import {
+  FRAME_HEADER_SIZE,
+  TRANSACTION_PREFIX_SIZE,
+  MAX_FRAME_SIZE,
+  FrameType,
+  readFrameHeader,
+  writeFrameHeader
+} from './wire-protocol';
+
+export interface DaemonResponse {
+  status: number;
+  payload: Buffer;
+}
+
+interface PendingCall {
+  resolve: (response: DaemonResponse) => void;
+  reject: (error: Error) => void;
+  timer: NodeJS.Timeout;
+}
+
+export const DEFAULT_DAEMON_TIMEOUT_MS = 10000;
+
+export class DaemonClient {
+  private socketPath: string;
+  private socket: net.Socket | null = null;
+  private connecting: Promise<net.Socket> | null = null;
+  private pending: Map<number, PendingCall> = new Map();
+  private nextRequestId = 1;
+  private input: Buffer = Buffer.alloc(0);
+  private timeoutMs: number;
+
+  constructor(socketPath: string, timeoutMs = DEFAULT_DAEMON_TIMEOUT_MS) {
+    this.socketPath = socketPath;
+    this.timeoutMs = timeoutMs;
+  }
+
+  callFunction(inputType: number, input: Buffer, contractIndex = 0): Promise<DaemonResponse> {
+    return this.request(FrameType.CALL_FUNCTION, inputType, contractIndex, input);
+  }
+
+  sendTransaction(inputType: number, input: Buffer, amount: number, contractIndex = 0): Promise<DaemonResponse> {
+    const payload = Buffer.alloc(TRANSACTION_PREFIX_SIZE + input.length);
+    payload.writeBigUInt64LE(BigInt(amount), 0);
+    input.copy(payload, TRANSACTION_PREFIX_SIZE);
+    return this.request(FrameType.SEND_TRANSACTION, inputType, contractIndex, payload);
+  }
+
+  getTick(): Promise<DaemonResponse> {
+    return this.request(FrameType.GET_TICK, 0, 0, Buffer.alloc(0));
+  }
+
+  // Served by read_replica only; query is a packed BetQuery
+  queryBets(query: Buffer): Promise<DaemonResponse> {
+    return this.request(FrameType.QUERY_BETS, 0, 0, query);
+  }
+
+  close(): void {
+    this.socket?.destroy();
+    this.socket = null;
+  }
+
+  private async request(type: FrameType, inputType: number, contractIndex: number, payload: Buffer): Promise<DaemonResponse> {
+    const socket = await this.connect();
+    const requestId = this.nextRequestId;
+    this.nextRequestId = (this.nextRequestId + 1) >>> 0 || 1;
+
+    const frame = Buffer.alloc(FRAME_HEADER_SIZE + payload.length);
+    const header: FrameHeader = {
+      size: frame.length,
+      type,
+      inputType,
+      requestId,
+      contractIndex,
+      status: 0
+    };
+    writeFrameHeader(header, frame);
+    payload.copy(frame, FRAME_HEADER_SIZE);
+
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        this.settle(requestId)?.reject(new Error(`qubic_clientd request timed out after ${this.timeoutMs} ms`));
+      }, this.timeoutMs);
+      this.pending.set(requestId, { resolve, reject, timer });
+
+      // A socket that closed before this request was queued emits no
+      // further close, so a failed write fails the request itself
+      socket.write(frame, (error) => {
+        if (error) {
+          this.settle(requestId)?.reject(error);
+        }
+      });
+    });
+  }
+
+  // Removes a pending request and stops its timer
+  private settle(requestId: number): PendingCall | undefined {
+    const pending = this.pending.get(requestId);
+    if (pending) {
+      clearTimeout(pending.timer);
+      this.pending.delete(requestId);
+    }
+    return pending;
+  }
+
+  private connect(): Promise<net.Socket> {
+    if (this.socket) {
+      return Promise.resolve(this.socket);
+    }
+    if (this.connecting) {
+      return this.connecting;
+    }
+
+    this.connecting = new Promise((resolve, reject) => {
+      const socket = net.createConnection(this.socketPath);
+      socket.setNoDelay(true);
+
+      socket.once('connect', () => {
+        this.socket = socket;
+        this.connecting = null;
+        resolve(socket);
+      });
+
+      socket.on('data', (chunk) => this.onData(chunk));
+
+      socket.on('error', (error) => {
+        if (this.connecting) {
+          this.connecting = null;
+          reject(error);
+        }
+        this.failPending(error);
+      });
+
+      socket.on('close', () => {
+        this.socket = null;
+        this.input = Buffer.alloc(0);
+        this.failPending(new Error('qubic_clientd connection closed'));
+      });
+    });
+
+    return this.connecting;
+  }
+
+  private onData(chunk: Buffer): void {
+    this.input = this.input.length ? Buffer.concat([this.input, chunk]) : chunk;
+
+    let offset = 0;
+    while (this.input.length - offset >= FRAME_HEADER_SIZE) {
+      const header = readFrameHeader(this.input, offset);
+      if (header.size < FRAME_HEADER_SIZE || header.size > MAX_FRAME_SIZE) {
+        this.socket?.destroy(new Error(`Malformed frame from qubic_clientd (size ${header.size})`));
+        return;
+      }
+      if (this.input.length - offset < header.size) {
+        break;
+      }
+
+      const pending = header.type === FrameType.RESPONSE ? this.settle(header.requestId) : undefined;
+      if (pending) {
+        pending.resolve({
+          status: header.status,
+          payload: Buffer.from(this.input.subarray(offset + FRAME_HEADER_SIZE, offset + header.size))
+        });
+      }
+      offset += header.size;
+    }
+
+    this.input = this.input.subarray(offset);
+  }
+
+  private failPending(error: Error): void {
+    for (const pending of this.pending.values()) {
+      clearTimeout(pending.timer);
+      pending.reject(error);
+    }
+    this.pending.clear();
+  }
+}
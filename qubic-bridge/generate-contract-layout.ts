@@ -0,0 +1,194 @@
+// Generates qubic-native/include/contract_layout.h from contract-schema.ts
+// Usage: npm run qubic:layout
+
+import fs from 'fs';
+import path from 'path';
+import { fileURLToPath } from 'url';
+import type { StructLayout } from './contract-schema';
+import { STRUCT_LAYOUTS, CONTRACT_FUNCTIONS, getStructLayout } from './contract-schema';
+
+const OUTPUT_PATH = path.resolve(
+  path.dirname(fileURLToPath(import.meta.url)),
+  '../qubic-native/include/contract_layout.h'
+);
+
+function layoutAssertions(layout: StructLayout): string[] {
+  const lines = [
+    `static_assert(sizeof(${layout.name}) == ${layout.size}, "${layout.name} size differs from contract-schema.ts");`,
+    `static_assert(alignof(${layout.name}) == ${layout.align}, "${layout.name} alignment differs from contract-schema.ts");`
+  ];
+
+  for (const field of layout.fields) {
+    lines.push(
+      `static_assert(offsetof(${layout.name}, ${field.name}) == ${field.offset}, "${layout.name}::${field.name} offset differs from contract-schema.ts");`,
+      `static_assert(sizeof(${layout.name}::${field.name}) == ${field.size}, "${layout.name}::${field.name} size differs from contract-schema.ts");`
+    );
+  }
+
+  return lines;
+}
+
+// PlaceBet -> PLACE_BET, the suffix of its STAT_ counter in HM25.h
+function constantName(functionName: string): string {
+  return functionName.replace(/([a-z0-9])([A-Z])/g, '$1_$2').toUpperCase();
+}
+
+function hashFunction(layout: StructLayout): string[] {
+  const parameter = layout.fields.length === 0 ? '' : ' value';
+  const lines = [`inline uint32 hashFields(const ${layout.name}&${parameter})`, '{', '    FieldHasher hasher;'];
+
+  for (const field of layout.fields) {
+    if (field.type === 'char') {
+      lines.push(`    hasher.mixChars(value.${field.name}, ${field.length});`);
+    } else if (field.length > 1) {
+      lines.push(`    for (uint32 i = 0; i < ${field.length}; i++) {`);
+      lines.push(`        hasher.mix(value.${field.name}[i]);`);
+      lines.push('    }');
+    } else {
+      lines.push(`    hasher.mix(value.${field.name});`);
+    }
+  }
+
+  lines.push('    return hasher.hash;', '}');
+  return lines;
+}
+
+function generate(): string {
+  const out: string[] = [
+    '// Generated by qubic-bridge/generate-contract-layout.ts from contract-schema.ts.',
+    '// Do not edit by hand; run `npm run qubic:layout` after changing the schema.',
+    '',
+    '#pragma once',
+    '',
+    '#include <cstddef>',
+    '',
+    '#include "../../qubic-contracts/HM25.h"',
+    '',
+    '// Compiler layout must match the schema the bridge codec encodes with'
+  ];
+
+  for (const layout of STRUCT_LAYOUTS) {
+    out.push(...layoutAssertions(layout), '');
+  }
+
+  out.push(
+    'namespace contract_abi',
+    '{',
+    '',
+    'struct StructInfo',
+    '{',
+    '    uint16 id;',
+    '    const char* name;',
+    '    uint32 size;',
+    '    uint32 align;',
+    '};',
+    '',
+    'struct FunctionInfo',
+    '{',
+    '    uint16 index;',
+    '    const char* name;',
+    '    uint16 inputStruct;',
+    '    uint16 outputStruct;',
+    '    uint32 inputSize;',
+    '    uint32 outputSize;',
+    '};',
+    '',
+    `constexpr uint16 STRUCT_COUNT = ${STRUCT_LAYOUTS.length};`,
+    `constexpr uint16 FUNCTION_COUNT = ${CONTRACT_FUNCTIONS.length};`,
+    '',
+    'constexpr StructInfo STRUCTS[STRUCT_COUNT] = {'
+  );
+
+  for (const layout of STRUCT_LAYOUTS) {
+    out.push(`    { ${layout.id}, "${layout.name}", sizeof(${layout.name}), alignof(${layout.name}) },`);
+  }
+
+  out.push(
+    '};',
+    '',
+    '// Function indices by name; each equals its STAT_ counter slot in HM25.h'
+  );
+
+  for (const fn of CONTRACT_FUNCTIONS) {
+    out.push(`constexpr uint16 FUNCTION_${constantName(fn.name)} = ${fn.index};`);
+  }
+  out.push('');
+  for (const fn of CONTRACT_FUNCTIONS) {
+    const name = constantName(fn.name);
+    out.push(`static_assert(FUNCTION_${name} == STAT_${name}, "${fn.name} index differs between contract-schema.ts and HM25.h");`);
+  }
+
+  out.push('', 'constexpr FunctionInfo FUNCTIONS[FUNCTION_COUNT] = {');
+
+  for (const fn of CONTRACT_FUNCTIONS) {
+    const input = getStructLayout(fn.input);
+    const output = getStructLayout(fn.output);
+    out.push(
+      `    { ${fn.index}, "${fn.name}", ${input.id}, ${output.id}, sizeof(${input.name}), sizeof(${output.name}) },`
+    );
+  }
+
+  out.push(
+    '};',
+    '',
+    'inline const FunctionInfo* findFunction(uint16 index)',
+    '{',
+    '    for (uint16 i = 0; i < FUNCTION_COUNT; i++) {',
+    '        if (FUNCTIONS[i].index == index) {',
+    '            return &FUNCTIONS[i];',
+    '        }',
+    '    }',
+    '    return nullptr;',
+    '}',
+    '',
+    '// FNV-1a over each field value in declaration order, little-endian.',
+    '// Matches hashFields() in qubic-bridge/contract-codec.ts.',
+    'struct FieldHasher',
+    '{',
+    '    uint32 hash = 2166136261u;',
+    '',
+    '    void mixByte(uint8 byte)',
+    '    {',
+    '        hash = (hash ^ byte) * 16777619u;',
+    '    }',
+    '',
+    '    template <typename T>',
+    '    void mix(T value)',
+    '    {',
+    '        for (uint32 i = 0; i < sizeof(T); i++) {',
+    '            mixByte((uint8)((uint64)value >> (8 * i)));',
+    '        }',
+    '    }',
+    '',
+    '    void mixChars(const char* chars, uint32 length)',
+    '    {',
+    '        for (uint32 i = 0; i < length; i++) {',
+    '            mixByte((uint8)chars[i]);',
+    '        }',
+    '    }',
+    '};',
+    ''
+  );
+
+  for (const layout of STRUCT_LAYOUTS) {
+    out.push(...hashFunction(layout), '');
+  }
+
+  out.push(
+    '// Calls visitor.template visit<T>() for the struct with the given schema id',
+    'template <typename Visitor>',
+    'bool visitStruct(uint16 id, Visitor& visitor)',
+    '{',
+    '    switch (id) {'
+  );
+
+  for (const layout of STRUCT_LAYOUTS) {
+    out.push(`    case ${layout.id}: visitor.template visit<${layout.name}>(); return true;`);
+  }
+
+  out.push('    default: return false;', '    }', '}', '', '} // namespace contract_abi', '');
+  return out.join('\n');
+}
+
+fs.writeFileSync(OUTPUT_PATH, generate());
+console.log(`Wrote ${path.relative(process.cwd(), OUTPUT_PATH)}`);
@@ -0,0 +1,152 @@
+// Bridge load test
+// Fires concurrent GetBalance reads and PlaceBet transactions through
+// QubicBridge and reports per-request latency, once with the per-request
+// qubic-cli transport and once through qubic_clientd. The http mode sends
+// the same mix through the Express routes instead (GET /user, POST /bets).
+//
+// Usage: npm run qubic:load-test -- [requests] [concurrency] [readPercent] [users]
+//
+// Requests spread over user ids 1..users. Before timing, users - 1 accounts
+// are registered through the first bridge mode; on a fresh contract the
+// demo user plus those accounts cover that id range.
+//
+// Each mode runs only when its variable is set: QUBIC_CLI_PATH (cli),
+// QUBIC_DAEMON_SOCKET (daemon), QUBIC_HTTP_URL (http, the base URL the
+// Qubic routes are mounted on, e.g. http://localhost:5000/api).
+//
+// For a local end-to-end run without testnet access:
+//   qubic-native/bin/mock_node --tick-ms 100 &
+//   qubic-native/bin/qubic_clientd --listen /tmp/qubic-clientd.sock --node 127.0.0.1:41841 &
+//   QUBIC_DAEMON_SOCKET=/tmp/qubic-clientd.sock npm run qubic:load-test
+
+import { QubicBridge } from './qubic-bridge';
+
+const REQUESTS = parseInt(process.argv[2] || '2000');
+const CONCURRENCY = parseInt(process.argv[3] || '32');
+const READ_PERCENT = parseInt(process.argv[4] || '80');
+const USERS = parseInt(process.argv[5] || '50');
+
+// Request issued by the load loop: a read when isRead, otherwise a bet
+type LoadRequest = (isRead: boolean, userId: number, sequence: number) => Promise<void>;
+
+interface LoadResult {
+  mode: string;
+  latenciesMs: number[];
+  failures: number;
+  elapsedMs: number;
+}
+
+function percentile(sorted: number[], fraction: number): number {
+  if (sorted.length === 0) {
+    return 0;
+  }
+  return sorted[Math.min(sorted.length - 1, Math.floor(sorted.length * fraction))];
+}
+
+function bridgeRequest(bridge: QubicBridge): LoadRequest {
+  return async (isRead, userId, sequence) => {
+    if (isRead) {
+      await bridge.getUserBalance(userId);
+    } else {
+      await bridge.placeBet(userId, 1, sequence % 2 ? 'YES' : 'NO', 1);
+    }
+  };
+}
+
+function httpRequest(baseUrl: string): LoadRequest {
+  return async (isRead, _userId, sequence) => {
+    const response = isRead
+      ? await fetch(`${baseUrl}/user`)
+      : await fetch(`${baseUrl}/bets`, {
+          method: 'POST',
+          headers: { 'Content-Type': 'application/json' },
+          body: JSON.stringify({ eventId: 1, prediction: sequence % 2 ? 'YES' : 'NO', amount: 1 })
+        });
+    await response.arrayBuffer();
+    if (!response.ok) {
+      throw new Error(`HTTP ${response.status}`);
+    }
+  };
+}
+
+async function runLoad(mode: string, request: LoadRequest): Promise<LoadResult> {
+  const latenciesMs: number[] = [];
+  let failures = 0;
+  let issued = 0;
+
+  const worker = async () => {
+    while (issued < REQUESTS) {
+      const sequence = issued++;
+      const userId = 1 + (Math.imul(sequence, 2654435761) >>> 0) % USERS;
+      const start = process.hrtime.bigint();
+      try {
+        await request(sequence % 100 < READ_PERCENT, userId, sequence);
+      } catch {
+        failures++;
+      }
+      latenciesMs.push(Number(process.hrtime.bigint() - start) / 1e6);
+    }
+  };
+
+  const start = process.hrtime.bigint();
+  await Promise.all(Array.from({ length: CONCURRENCY }, worker));
+  const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+
+  latenciesMs.sort((a, b) => a - b);
+  return { mode, latenciesMs, failures, elapsedMs };
+}
+
+function report(result: LoadResult) {
+  const { latenciesMs } = result;
+  const mean = latenciesMs.reduce((sum, value) => sum + value, 0) / Math.max(1, latenciesMs.length);
+  console.log(
+    `${result.mode.padEnd(8)} ${String(latenciesMs.length).padStart(8)} ${String(result.failures).padStart(8)}` +
+    ` ${(latenciesMs.length / (result.elapsedMs / 1000)).toFixed(0).padStart(10)}` +
+    ` ${mean.toFixed(3).padStart(9)} ${percentile(latenciesMs, 0.5).toFixed(3).padStart(9)}` +
+    ` ${percentile(latenciesMs, 0.99).toFixed(3).padStart(9)} ${percentile(latenciesMs, 0.999).toFixed(3).padStart(9)}`
+  );
+}
+
+const baseConfig = {
+  nodeIp: process.env.QUBIC_NODE_IP || '127.0.0.1',
+  nodePort: parseInt(process.env.QUBIC_NODE_PORT || '31841'),
+  contractAddress: process.env.QUBIC_CONTRACT_ADDRESS || '',
+  cliPath: process.env.QUBIC_CLI_PATH || ''
+};
+
+async function registerUsers(bridge: QubicBridge) {
+  const results = await Promise.allSettled(
+    Array.from({ length: USERS - 1 }, (_, index) => bridge.registerUser(`load${index + 2}`, 'load-test'))
+  );
+  const registered = results.filter(result => result.status === 'fulfilled').length;
+  console.log(`Registered ${registered} of ${USERS - 1} load test users`);
+}
+
+const bridges: QubicBridge[] = [];
+const modes: [string, LoadRequest][] = [];
+if (process.env.QUBIC_CLI_PATH) {
+  bridges.push(new QubicBridge(baseConfig));
+  modes.push(['cli', bridgeRequest(bridges[bridges.length - 1])]);
+}
+if (process.env.QUBIC_DAEMON_SOCKET) {
+  bridges.push(new QubicBridge({ ...baseConfig, daemonSocket: process.env.QUBIC_DAEMON_SOCKET }));
+  modes.push(['daemon', bridgeRequest(bridges[bridges.length - 1])]);
+}
+if (process.env.QUBIC_HTTP_URL) {
+  modes.push(['http', httpRequest(process.env.QUBIC_HTTP_URL.replace(/\/$/, ''))]);
+}
+if (modes.length === 0) {
+  console.error('Set QUBIC_CLI_PATH, QUBIC_DAEMON_SOCKET and/or QUBIC_HTTP_URL to choose what to load test');
+  process.exit(2);
+}
+
+if (bridges.length > 0 && USERS > 1) {
+  await registerUsers(bridges[0]);
+}
+
+console.log(`${REQUESTS} requests, concurrency ${CONCURRENCY}, ${READ_PERCENT}% reads, ${USERS} users\n`);
+console.log('mode     requests failures    req/s   mean ms    p50 ms    p99 ms  p99.9 ms');
+for (const [mode, request] of modes) {
+  report(await runLoad(mode, request));
+}
+process.exit(0);
@@ -4,6 +4,13 @@
 import { spawn } from 'child_process';
 import { promisify } from 'util';
 import fs from 'fs/promises';
+import type { StructInput, StructValue } from './contract-codec';
+import { getCodec } from './contract-codec';
+import { LEADERBOARD_SIZE, MAX_RESOLVE_BATCH, getFunction } from './contract-schema';
+import type { DaemonResponse } from './daemon-client';
+import { DaemonClient } from './daemon-client';
+import { FrameStatus, MAX_QUERY_BETS, ScanKernel, readBetQueryResult, writeBetQuery } from './wire-protocol';
+import { ShardMap } from './shard-map';
 
 export interface QubicConfig {
   nodeIp: string;
@@ -11,6 +18,17 @@ export interface QubicConfig {
   contractAddress: string;
   cliPath: string;
   privateKey?: string;
+  // qubic_clientd socket; when set, calls go through the daemon instead of spawning the CLI
+  daemonSocket?: string;
+  // How long a daemon or replica request may wait for its response (default 10 s)
+  daemonTimeoutMs?: number;
+  // One contract per shard, in ConfigureShard order: CLI contract addresses,
+  // or contract indices on the node when going through the daemon. When set,
+  // calls are routed by shard-map.ts and contractAddress is unused.
+  shardContracts?: string[];
+  // read_replica socket; when set, bet listings are read from the replica's
+  // mirror of the contract state instead of the contract
+  replicaSocket?: string;
 }
 
 export interface QubicTransaction {
@@ -29,6 +47,10 @@ export interface QubicUser {
   totalWins: number;
 }
 
+// YES / NO in a binary market; the outcome index 0..outcomeCount - 1 in a
+// multi-outcome one. Outcomes 0 and 1 read back as NO and YES.
+export type QubicOutcome = 'YES' | 'NO' | number;
+
 export interface QubicEvent {
   id: number;
   title: string;
@@ -38,7 +60,8 @@ export interface QubicEvent {
   endsAt: Date;
   isActive: boolean;
   isResolved: boolean;
-  correctAnswer?: 'YES' | 'NO';
+  correctAnswer?: QubicOutcome;
+  outcomeCount: number;  // 2 for YES / NO markets
   totalBets: number;
   yesBets: number;
   noBets: number;
@@ -48,13 +71,163 @@ export interface QubicBet {
   id: number;
   userId: number;
   eventId: number;
-  prediction: 'YES' | 'NO';
+  prediction: QubicOutcome;
   amount: number;
   createdAt: Date;
   isWon?: boolean;
   isProcessed: boolean;
 }
 
+// Bets matching every field given; a page of at most MAX_QUERY_BETS
+export interface QubicBetFilter {
+  userId?: number;
+  eventId?: number;
+  unsettledOnly?: boolean;
+  minAmount?: number;
+  maxAmount?: number;
+  offset?: number;
+  limit?: number;
+  kernel?: 'scalar' | 'avx2';
+}
+
+export interface QubicBetPage {
+  total: number;        // Matches over all bets, not just this page
+  tick: number;         // Tick of the replica's state
+  scanMicros: number;
+  bets: QubicBet[];
+}
+
+export interface QubicEventResolution {
+  eventId: number;
+  correctAnswer: QubicOutcome;
+  confidence: number;
+}
+
+export interface QubicResolutionResult {
+  eventId: number;
+  resolved: boolean;  // false when the event was missing or already closed
+  winnersCount: number;
+  totalPayout: number;
+}
+
+// Flat bets only: market maker bets are held as positions (see HM25.h User)
+export interface QubicUserSummary {
+  userId: number;
+  balance: number;
+  totalBets: number;
+  totalWins: number;
+  openBets: number;
+  openStake: number;
+  realizedPnl: number;
+}
+
+// Bets per outcome; bets[0] / bets[1] are the NO / YES bets of a binary market
+export interface QubicOutcomeTally {
+  eventId: number;
+  outcomeCount: number;
+  bets: number[];
+  isResolved: boolean;
+  correctAnswer?: QubicOutcome;
+  hasMarketMaker: boolean;
+}
+
+export interface QubicLeaderboardEntry {
+  rank: number;
+  userId: number;
+  totalWins: number;
+  totalBets: number;
+  balance: number;
+}
+
+export type QubicOrderSide = 'BUY' | 'SELL';
+
+export interface QubicOrderResult {
+  orderId: number;
+  filledQuantity: number;
+  restingQuantity: number;
+  fillCost: number;
+  newBalance: number;
+}
+
+export interface QubicBestBidAsk {
+  eventId: number;
+  bestBid: number | null;
+  bestAsk: number | null;
+  bidQuantity: number;
+  askQuantity: number;
+}
+
+export interface QubicBetQuote {
+  eventId: number;
+  prediction: 'YES' | 'NO';
+  shares: number;
+  cost: number;
+  yesPrice: number;  // 0..1, before the bet
+}
+
+export interface QubicContractStats {
+  invocationCount: Record<string, number>;
+  rejectionCount: Record<string, number>;
+  elementsScanned: Record<string, number>;
+  lastElementsScanned: Record<string, number>;
+  settlementBacklog: number;
+  userCount: number;
+  eventCount: number;
+  betCount: number;
+  totalVolume: number;
+}
+
+// Counter slots in GetContractStatsOutput, in contract order (see HM25.h STAT_* / REJECT_*)
+export const CONTRACT_PROCEDURE_NAMES = [
+  'RegisterUser',
+  'CreateEvent',
+  'PlaceBet',
+  'ResolveEvent',
+  'GetBalance',
+  'GetEvents',
+  'GetUserBets',
+  'GetContractStats',
+  'PlaceOrder',
+  'CancelOrder',
+  'GetBestBidAsk',
+  'EnableMarketMaker',
+  'QuoteBet',
+  'ConfigureShard',
+  'ShardTransferOut',
+  'ShardTransferIn',
+  'ResolveEvents',
+  'GetLeaderboard',
+  'GetUserSummary',
+  'GetOutcomeTally',
+  'UnregisterUser',
+  'SetMaxOpenStake'
+];
+
+export const CONTRACT_REJECTION_REASONS = [
+  'contractInactive',
+  'capacityFull',
+  'unauthorized',
+  'userNotFound',
+  'insufficientBalance',
+  'eventNotFound',
+  'eventClosed',
+  'invalidOrder',
+  'orderNotFound',
+  'noMarketMaker',
+  'invalidConfig',
+  'invalidBatch',
+  'exposureLimit',
+  'invalidOutcome'
+];
+
+export function outcomeIndex(outcome: QubicOutcome): number {
+  return outcome === 'YES' ? 1 : outcome === 'NO' ? 0 : outcome;
+}
+
+export function outcomeName(index: number): QubicOutcome {
+  return index === 1 ? 'YES' : index === 0 ? 'NO' : index;
+}
+
 export class QubicError extends Error {
   constructor(
     message: string,
@@ -72,15 +245,52 @@ export enum QubicErrorCodes {
   TRANSACTION_FAILED = 'TRANSACTION_FAILED',
   NETWORK_ERROR = 'NETWORK_ERROR',
   CONTRACT_ERROR = 'CONTRACT_ERROR',
-  UNAUTHORIZED = 'UNAUTHORIZED'
+  UNAUTHORIZED = 'UNAUTHORIZED',
+  TICK_BUDGET_EXCEEDED = 'TICK_BUDGET_EXCEEDED'
+}
+
+// CLI line carrying the packed output struct, e.g. "Output: 0100000064000000..."
+const OUTPUT_HEX_PATTERN = /(?:Output|Result):\s*([0-9a-fA-F]+)\s*$/m;
+
+// Output structs are decoded into one reused object per struct type, which
+// the next response of that type overwrites. A reader runs on it right away
+// and returns what the caller keeps; arrays and Buffers must be copied.
+type OutputReader = (output: any) => unknown;
+
+// The default reader: an output's scalar fields, enough for most callers
+function scalarFields(output: StructValue): StructValue {
+  const fields: StructValue = {};
+  for (const name in output) {
+    if (typeof output[name] === 'number') {
+      fields[name] = output[name];
+    }
+  }
+  return fields;
 }
 
 export class QubicBridge {
   private config: QubicConfig;
   private transactions: Map<string, QubicTransaction> = new Map();
+  // Reused decode targets, by output struct name; see OutputReader
+  private outputs = new Map<string, StructValue>();
+  private daemon: DaemonClient | null = null;
+  private replica: DaemonClient | null = null;
+  private shards: ShardMap;
+  private nextEventShard = 0;
+  // Global ids of events known to have a market maker; one is never removed
+  private marketMakers = new Set<number>();
+  // Registrations run one at a time so user ids stay equal on every shard
+  private registration: Promise<unknown> = Promise.resolve();
 
   constructor(config: QubicConfig) {
     this.config = config;
+    if (config.daemonSocket) {
+      this.daemon = new DaemonClient(config.daemonSocket, config.daemonTimeoutMs);
+    }
+    if (config.replicaSocket) {
+      this.replica = new DaemonClient(config.replicaSocket, config.daemonTimeoutMs);
+    }
+    this.shards = new ShardMap(config.shardContracts?.length || 1);
   }
 
   // Execute Qubic CLI command
@@ -120,21 +330,30 @@ export class QubicBridge {
     });
   }
 
-  // Call contract function (read-only)
-  async callContractFunction(functionIndex: number, inputData: any): Promise<any> {
+  // Call contract function (read-only). Resolves to what `read` keeps of the
+  // output, or null when the CLI printed none.
+  async callContractFunction(functionName: string, inputData: StructInput, shard = 0, read: OutputReader = scalarFields): Promise<any> {
     try {
-      const serializedInput = this.serializeInput(inputData);
+      const fn = getFunction(functionName);
+      if (this.daemon) {
+        const input = Buffer.from(getCodec(fn.input).encode(inputData));
+        const response = await this.daemon.callFunction(fn.index, input, this.shardContractIndex(shard))
+          .catch((error) => this.daemonError(error));
+        return this.readOutput(fn.output, this.checkDaemonResponse(response), read);
+      }
+
+      const serializedInput = this.serializeInput(fn.input, inputData);
       const args = [
         '-nodeip', this.config.nodeIp,
         '-nodeport', this.config.nodePort.toString(),
         '-requestcontractfunction',
-        this.config.contractAddress,
-        functionIndex.toString(),
+        this.shardContract(shard),
+        fn.index.toString(),
         serializedInput
       ];
 
       const result = await this.executeCommand(args);
-      return this.parseOutput(result);
+      return this.parseOutput(fn.output, result, read);
     } catch (error) {
       throw new QubicError(
         `Contract function call failed: ${error.message}`,
@@ -144,8 +363,9 @@ export class QubicBridge {
     }
   }
 
-  // Submit transaction to contract
-  async submitTransaction(functionIndex: number, inputData: any, amount = 0): Promise<QubicTransaction> {
+  // Submit transaction to contract; the transaction's result is what `read`
+  // keeps of the output
+  async submitTransaction(functionName: string, inputData: StructInput, amount = 0, shard = 0, read: OutputReader = scalarFields): Promise<QubicTransaction> {
     const transactionId = this.generateTransactionId();
     
     try {
@@ -156,13 +376,24 @@ export class QubicBridge {
       
       this.transactions.set(transactionId, transaction);
 
-      const serializedInput = this.serializeInput(inputData);
+      const fn = getFunction(functionName);
+      if (this.daemon) {
+        const input = Buffer.from(getCodec(fn.input).encode(inputData));
+        const response = await this.daemon.sendTransaction(fn.index, input, amount, this.shardContractIndex(shard))
+          .catch((error) => this.daemonError(error));
+
+        transaction.status = 'confirmed';
+        transaction.result = this.readOutput(fn.output, this.checkDaemonResponse(response), read);
+        return transaction;
+      }
+
+      const serializedInput = this.serializeInput(fn.input, inputData);
       const args = [
         '-nodeip', this.config.nodeIp,
         '-nodeport', this.config.nodePort.toString(),
         '-sendtransaction',
-        this.config.contractAddress,
-        functionIndex.toString(),
+        this.shardContract(shard),
+        fn.index.toString(),
         amount.toString(),
         serializedInput
       ];
@@ -172,7 +403,7 @@ export class QubicBridge {
       }
 
       const result = await this.executeCommand(args);
-      const parsedResult = this.parseTransactionResult(result);
+      const parsedResult = this.parseTransactionResult(fn.output, result, read);
 
       transaction.status = 'confirmed';
       transaction.hash = parsedResult.hash;
@@ -198,35 +429,79 @@ export class QubicBridge {
 
   async registerUser(username: string, password: string): Promise<QubicUser> {
     const inputData = {
-      username: this.stringToBytes32(username),
-      password: this.stringToBytes32(password) // Should be hashed
+      username,
+      passwordHash: password // Should be hashed
     };
 
-    const transaction = await this.submitTransaction(0, inputData);
-    
-    if (transaction.status === 'confirmed' && transaction.result?.success) {
-      return {
-        id: transaction.result.userId,
-        username,
-        balance: transaction.result.balance,
-        totalBets: 0,
-        totalWins: 0
-      };
+    // Every shard registers the user and hands out its next id, one shard
+    // at a time so a failure can be undone on the shards before it
+    const registered = this.registration.then(() => this.registerOnShards(inputData));
+    this.registration = registered.catch(() => undefined);
+    const transactions = await registered;
+    const userId = transactions[0].result.userId;
+
+    return {
+      id: userId,
+      username,
+      balance: transactions[this.shards.homeShard(userId)].result.balance,
+      totalBets: 0,
+      totalWins: 0
+    };
+  }
+
+  // Registers on shard 0, then on each further shard under the same id. When
+  // a shard fails or hands out another id, the shards that registered the
+  // user withdraw it with UnregisterUser, so no shard is left an id ahead.
+  private async registerOnShards(inputData: StructInput): Promise<QubicTransaction[]> {
+    const transactions: QubicTransaction[] = [];
+    let error: unknown;
+    let complete = true;
+    for (const shard of this.allShards()) {
+      const transaction = await this.submitTransaction('RegisterUser', inputData, 0, shard)
+        .catch((submitError) => {
+          error = submitError;
+          return undefined;
+        });
+      if (!transaction?.result?.success) {
+        complete = false;
+        break;
+      }
+      transactions.push(transaction);
+      if (transaction.result.userId !== transactions[0].result.userId) {
+        complete = false;
+        break;
+      }
+    }
+
+    if (complete) {
+      return transactions;
+    }
+
+    const stranded: number[] = [];
+    for (let shard = transactions.length - 1; shard >= 0; shard--) {
+      const withdrawn = await this.submitTransaction('UnregisterUser', { userId: transactions[shard].result.userId }, 0, shard)
+        .catch(() => undefined);
+      if (!withdrawn?.result?.success) {
+        stranded.push(shard);
+      }
     }
 
     throw new QubicError(
-      'User registration failed',
+      stranded.length ? 'User registration failed and could not be undone' : 'User registration failed',
       QubicErrorCodes.CONTRACT_ERROR,
-      transaction.error
+      { ids: transactions.map((t) => t.result.userId), stranded, error }
     );
   }
 
+  // Sum over shards: funds start on the home shard, winnings stay where they were won
   async getUserBalance(userId: number): Promise<number> {
     const inputData = { userId };
-    const result = await this.callContractFunction(4, inputData);
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetBalance', inputData, shard))
+    );
     
-    if (result?.success) {
-      return result.balance;
+    if (results.every((result) => result?.success)) {
+      return results.reduce((total, result) => total + result.balance, 0);
     }
 
     throw new QubicError(
@@ -235,26 +510,60 @@ export class QubicBridge {
     );
   }
 
+  // Running aggregates kept by the contract, summed over shards like the balance
+  async getUserSummary(userId: number): Promise<QubicUserSummary> {
+    const inputData = { userId };
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetUserSummary', inputData, shard))
+    );
+
+    if (!results.every((result) => result?.success)) {
+      throw new QubicError(
+        'Failed to get user summary',
+        QubicErrorCodes.CONTRACT_ERROR
+      );
+    }
+
+    const summary: QubicUserSummary = {
+      userId, balance: 0, totalBets: 0, totalWins: 0, openBets: 0, openStake: 0, realizedPnl: 0
+    };
+    for (const result of results) {
+      summary.balance += result.balance;
+      summary.totalBets += result.totalBets;
+      summary.totalWins += result.totalWins;
+      summary.openBets += result.openBets;
+      summary.openStake += result.openStake;
+      summary.realizedPnl += result.realizedPnl;
+    }
+    return summary;
+  }
+
   // Event Management Functions
 
   async createEvent(
     title: string,
     description: string,
     category: string,
-    endsAt: Date
+    endsAt: Date,
+    outcomeCount = 2
   ): Promise<QubicEvent> {
     const inputData = {
-      title: this.stringToBytes128(title),
-      description: this.stringToBytes256(description),
-      category: this.stringToBytes32(category),
-      endsAt: Math.floor(endsAt.getTime() / 1000)
+      title,
+      description,
+      category,
+      endsAt: Math.floor(endsAt.getTime() / 1000),
+      outcomeCount
     };
 
-    const transaction = await this.submitTransaction(2, inputData);
+    // Round-robin keeps shards evenly loaded
+    const shard = this.nextEventShard;
+    this.nextEventShard = (shard + 1) % this.shards.shardCount;
+
+    const transaction = await this.submitTransaction('CreateEvent', inputData, 0, shard);
     
     if (transaction.status === 'confirmed' && transaction.result?.success) {
       return {
-        id: transaction.result.eventId,
+        id: this.shards.globalEventId(shard, transaction.result.eventId),
         title,
         description,
         category,
@@ -262,6 +571,7 @@ export class QubicBridge {
         endsAt,
         isActive: true,
         isResolved: false,
+        outcomeCount,
         totalBets: 0,
         yesBets: 0,
         noBets: 0
@@ -277,9 +587,11 @@ export class QubicBridge {
 
   async getActiveEvents(): Promise<QubicEvent[]> {
     const inputData = { startIndex: 0, count: 100 };
-    const result = await this.callContractFunction(5, inputData);
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetEvents', inputData, shard))
+    );
     
-    if (result?.success) {
+    if (results.every((result) => result?.success)) {
       // Note: This is simplified - in real implementation you'd need to
       // iterate through events and parse each one
       return [];
@@ -291,14 +603,14 @@ export class QubicBridge {
     );
   }
 
-  async resolveEvent(eventId: number, correctAnswer: 'YES' | 'NO', confidence: number): Promise<void> {
+  async resolveEvent(eventId: number, correctAnswer: QubicOutcome, confidence: number): Promise<void> {
     const inputData = {
-      eventId,
-      correctAnswer: correctAnswer === 'YES' ? 1 : 0,
+      eventId: this.shards.localEventId(eventId),
+      correctAnswer: outcomeIndex(correctAnswer),
       confidence: Math.min(100, Math.max(0, confidence))
     };
 
-    const transaction = await this.submitTransaction(3, inputData);
+    const transaction = await this.submitTransaction('ResolveEvent', inputData, 0, this.shards.eventShard(eventId));
     
     if (transaction.status !== 'confirmed' || !transaction.result?.success) {
       throw new QubicError(
@@ -309,26 +621,96 @@ export class QubicBridge {
     }
   }
 
+  // Settle many events at once. Each ResolveEvents call scans the bets once
+  // for up to MAX_RESOLVE_BATCH events of one shard; results keep input order.
+  async resolveEvents(resolutions: QubicEventResolution[]): Promise<QubicResolutionResult[]> {
+    const batches: number[][] = [];
+    const openBatches = new Map<number, number[]>();
+    resolutions.forEach((resolution, index) => {
+      const shard = this.shards.eventShard(resolution.eventId);
+      let batch = openBatches.get(shard);
+      if (!batch || batch.length === MAX_RESOLVE_BATCH) {
+        batch = [];
+        openBatches.set(shard, batch);
+        batches.push(batch);
+      }
+      batch.push(index);
+    });
+
+    const results: QubicResolutionResult[] = new Array(resolutions.length);
+    await Promise.all(batches.map(async (batch) => {
+      const entries = batch.map((index) => resolutions[index]);
+      const inputData = {
+        eventIds: entries.map((entry) => this.shards.localEventId(entry.eventId)),
+        correctAnswers: entries.map((entry) => outcomeIndex(entry.correctAnswer)),
+        confidences: entries.map((entry) => Math.min(100, Math.max(0, entry.confidence))),
+        count: entries.length
+      };
+
+      const shard = this.shards.eventShard(entries[0].eventId);
+      const transaction = await this.submitTransaction('ResolveEvents', inputData, 0, shard, (output) => ({
+        resolved: output.resolved.slice(0, entries.length),
+        winnersCount: output.winnersCount.slice(0, entries.length),
+        totalPayout: output.totalPayout.slice(0, entries.length)
+      }));
+      if (transaction.status !== 'confirmed' || !transaction.result) {
+        throw new QubicError(
+          'Batch event resolution failed',
+          QubicErrorCodes.CONTRACT_ERROR,
+          transaction.error
+        );
+      }
+
+      batch.forEach((index, entry) => {
+        results[index] = {
+          eventId: resolutions[index].eventId,
+          resolved: transaction.result.resolved[entry] === 1,
+          winnersCount: transaction.result.winnersCount[entry],
+          totalPayout: transaction.result.totalPayout[entry]
+        };
+      });
+    }));
+
+    return results;
+  }
+
   // Betting Functions
 
   async placeBet(
     userId: number,
     eventId: number,
-    prediction: 'YES' | 'NO',
+    prediction: QubicOutcome,
     amount: number
   ): Promise<QubicBet> {
+    const shard = this.shards.eventShard(eventId);
     const inputData = {
       userId,
-      eventId,
-      prediction: prediction === 'YES' ? 1 : 0,
+      eventId: this.shards.localEventId(eventId),
+      prediction: outcomeIndex(prediction),
       amount
     };
 
-    const transaction = await this.submitTransaction(1, inputData);
+    // On a market maker event the amount is a share count; fund the quoted
+    // cost. Flat events are not quoted, as QuoteBet counts a rejection there.
+    let moved = 0;
+    if (shard !== this.shards.homeShard(userId)) {
+      let needed = amount;
+      if (await this.hasMarketMaker(eventId)) {
+        const quote = await this.callContractFunction('QuoteBet', inputData, shard);
+        needed = quote?.success ? quote.cost : amount;
+      }
+      moved = await this.fundShard(userId, shard, needed);
+    }
+
+    const transaction = await this.submitTransaction('PlaceBet', inputData, 0, shard)
+      .catch(async (error) => {
+        await this.refundShard(userId, shard, moved);
+        throw error;
+      });
     
     if (transaction.status === 'confirmed' && transaction.result?.success) {
       return {
-        id: transaction.result.betId,
+        id: this.shards.globalBetId(shard, transaction.result.betId),
         userId,
         eventId,
         prediction,
@@ -338,6 +720,7 @@ export class QubicBridge {
       };
     }
 
+    await this.refundShard(userId, shard, moved);
     throw new QubicError(
       'Bet placement failed',
       QubicErrorCodes.TRANSACTION_FAILED,
@@ -346,10 +729,17 @@ export class QubicBridge {
   }
 
   async getUserBets(userId: number): Promise<QubicBet[]> {
+    if (this.replica && this.shards.shardCount === 1) {
+      const page = await this.queryBets({ userId, limit: MAX_QUERY_BETS });
+      return page.bets;
+    }
+
     const inputData = { userId };
-    const result = await this.callContractFunction(6, inputData);
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetUserBets', inputData, shard))
+    );
     
-    if (result?.success) {
+    if (results.every((result) => result?.success)) {
       // Note: This is simplified - in real implementation you'd need to
       // parse the bet data from the contract
       return [];
@@ -361,27 +751,472 @@ export class QubicBridge {
     );
   }
 
+  // Filtered bet listing from read_replica. The replica mirrors a single
+  // contract, so sharded deployments are not supported.
+  async queryBets(filter: QubicBetFilter): Promise<QubicBetPage> {
+    if (!this.replica || this.shards.shardCount > 1) {
+      throw new QubicError(
+        'Bet queries need a read replica of an unsharded contract',
+        QubicErrorCodes.NETWORK_ERROR
+      );
+    }
+
+    const query = writeBetQuery({
+      userId: filter.userId ?? 0,
+      eventId: filter.eventId ?? 0,
+      minAmount: filter.minAmount ?? 0,
+      maxAmount: filter.maxAmount ?? 0,
+      offset: filter.offset ?? 0,
+      limit: Math.min(filter.limit ?? 100, MAX_QUERY_BETS),
+      unsettledOnly: filter.unsettledOnly ?? false,
+      kernel: filter.kernel === 'scalar' ? ScanKernel.SCALAR : filter.kernel === 'avx2' ? ScanKernel.AVX2 : ScanKernel.DEFAULT
+    });
+    const response = await this.replica.queryBets(query).catch((error) => this.daemonError(error));
+    const result = readBetQueryResult(this.checkDaemonResponse(response));
+
+    // Ticks count seconds in the contract, so creation times are placed
+    // relative to the replica's tick. Ids go through the shard map like
+    // placeBet's, so both hand out the same bet ids.
+    const now = Date.now();
+    return {
+      total: result.total,
+      tick: result.tick,
+      scanMicros: result.scanMicros,
+      bets: result.records.map((record) => ({
+        id: this.shards.globalBetId(0, record.id),
+        userId: record.userId,
+        eventId: this.shards.globalEventId(0, record.eventId),
+        prediction: outcomeName(record.prediction),
+        amount: record.amount,
+        createdAt: new Date(now - (result.tick - record.createdAt) * 1000),
+        isWon: record.isProcessed ? record.isWon : undefined,
+        isProcessed: record.isProcessed
+      }))
+    };
+  }
+
+  async getOutcomeTally(eventId: number): Promise<QubicOutcomeTally> {
+    const inputData = { eventId: this.shards.localEventId(eventId) };
+    const result = await this.callContractFunction('GetOutcomeTally', inputData, this.shards.eventShard(eventId),
+      (output) => ({ ...scalarFields(output), bets: output.bets.slice(0, output.outcomeCount) }));
+
+    if (!result?.success) {
+      throw new QubicError(
+        'Failed to get outcome tally',
+        QubicErrorCodes.CONTRACT_ERROR
+      );
+    }
+
+    return {
+      eventId,
+      outcomeCount: result.outcomeCount,
+      bets: result.bets,
+      isResolved: result.isResolved === 1,
+      correctAnswer: result.isResolved ? outcomeName(result.correctAnswer) : undefined,
+      hasMarketMaker: result.hasMarketMaker === 1
+    };
+  }
+
+  // Order Book Functions
+
+  // Limit order for YES shares at price 1..99; a share pays 100 if YES wins.
+  // SELL without holding YES shares buys NO shares at 100 - price.
+  async placeOrder(
+    userId: number,
+    eventId: number,
+    side: QubicOrderSide,
+    price: number,
+    quantity: number
+  ): Promise<QubicOrderResult> {
+    const shard = this.shards.eventShard(eventId);
+    const inputData = {
+      userId,
+      eventId: this.shards.localEventId(eventId),
+      quantity,
+      side: side === 'BUY' ? 0 : 1,
+      price
+    };
+
+    // Fund the full collateral; a SELL backed by held YES shares needs less
+    // and the rest stays on the event's shard
+    let moved = 0;
+    if (shard !== this.shards.homeShard(userId)) {
+      moved = await this.fundShard(userId, shard, quantity * (side === 'BUY' ? price : 100 - price));
+    }
+
+    const transaction = await this.submitTransaction('PlaceOrder', inputData, 0, shard)
+      .catch(async (error) => {
+        await this.refundShard(userId, shard, moved);
+        throw error;
+      });
+
+    if (transaction.status === 'confirmed' && transaction.result?.success) {
+      const orderId = transaction.result.orderId;
+      return {
+        orderId: orderId ? this.shards.globalOrderId(shard, orderId) : 0,
+        filledQuantity: transaction.result.filledQuantity,
+        restingQuantity: transaction.result.restingQuantity,
+        fillCost: transaction.result.fillCost,
+        newBalance: transaction.result.newBalance
+      };
+    }
+
+    await this.refundShard(userId, shard, moved);
+    throw new QubicError(
+      'Order placement failed',
+      QubicErrorCodes.TRANSACTION_FAILED,
+      transaction.error
+    );
+  }
+
+  async cancelOrder(userId: number, orderId: number): Promise<number> {
+    const inputData = { userId, orderId: this.shards.localOrderId(orderId) };
+    const transaction = await this.submitTransaction('CancelOrder', inputData, 0, this.shards.orderShard(orderId));
+
+    if (transaction.status === 'confirmed' && transaction.result?.success) {
+      return transaction.result.newBalance;
+    }
+
+    throw new QubicError(
+      'Order cancellation failed',
+      QubicErrorCodes.TRANSACTION_FAILED,
+      transaction.error
+    );
+  }
+
+  async getBestBidAsk(eventId: number): Promise<QubicBestBidAsk> {
+    const inputData = { eventId: this.shards.localEventId(eventId) };
+    const result = await this.callContractFunction('GetBestBidAsk', inputData, this.shards.eventShard(eventId));
+
+    if (result?.success) {
+      return {
+        eventId,
+        bestBid: result.bestBid || null,
+        bestAsk: result.bestAsk || null,
+        bidQuantity: result.bidQuantity,
+        askQuantity: result.askQuantity
+      };
+    }
+
+    throw new QubicError(
+      'Failed to get order book',
+      QubicErrorCodes.INVALID_EVENT
+    );
+  }
+
+  // Market Maker Functions
+
+  // Attach an LMSR market maker with liquidity b (in shares). Afterwards the
+  // amount passed to placeBet for this event is a share count, charged at the
+  // market maker's price.
+  async enableMarketMaker(eventId: number, liquidity: number): Promise<void> {
+    const inputData = { eventId: this.shards.localEventId(eventId), liquidity };
+    const transaction = await this.submitTransaction('EnableMarketMaker', inputData, 0, this.shards.eventShard(eventId));
+
+    if (transaction.status !== 'confirmed' || !transaction.result?.success) {
+      throw new QubicError(
+        'Market maker setup failed',
+        QubicErrorCodes.CONTRACT_ERROR,
+        transaction.error
+      );
+    }
+    this.marketMakers.add(eventId);
+  }
+
+  // Most a user may have riding on unsettled flat bets, 0 for no limit. Each
+  // shard enforces it on the bets placed there.
+  async setMaxOpenStake(limit: number): Promise<void> {
+    const transactions = await Promise.all(
+      this.allShards().map((shard) => this.submitTransaction('SetMaxOpenStake', { maxOpenStake: limit }, 0, shard))
+    );
+
+    if (!transactions.every((t) => t.status === 'confirmed' && t.result?.success)) {
+      throw new QubicError(
+        'Open stake limit update failed',
+        QubicErrorCodes.CONTRACT_ERROR,
+        transactions.find((t) => t.error)?.error
+      );
+    }
+  }
+
+  // Whether bets on the event are priced by its market maker. Only positive
+  // answers are cached; an event read as flat may get a maker later.
+  // GetOutcomeTally is a plain read, unlike QuoteBet it counts no rejection.
+  private async hasMarketMaker(eventId: number): Promise<boolean> {
+    if (this.marketMakers.has(eventId)) {
+      return true;
+    }
+
+    const inputData = { eventId: this.shards.localEventId(eventId) };
+    const result = await this.callContractFunction('GetOutcomeTally', inputData, this.shards.eventShard(eventId));
+    if (result?.success && result.hasMarketMaker === 1) {
+      this.marketMakers.add(eventId);
+      return true;
+    }
+    return false;
+  }
+
+  async quoteBet(eventId: number, prediction: 'YES' | 'NO', shares: number): Promise<QubicBetQuote> {
+    const inputData = {
+      eventId: this.shards.localEventId(eventId),
+      amount: shares,
+      prediction: prediction === 'YES' ? 1 : 0
+    };
+
+    const result = await this.callContractFunction('QuoteBet', inputData, this.shards.eventShard(eventId));
+
+    if (result?.success) {
+      return {
+        eventId,
+        prediction,
+        shares,
+        cost: result.cost,
+        yesPrice: result.yesPriceBps / 10000
+      };
+    }
+
+    throw new QubicError(
+      'Failed to quote bet',
+      QubicErrorCodes.INVALID_EVENT
+    );
+  }
+
+  // Leaderboard Functions
+
+  // Top users by wins. With several shards each shard ranks its own wins and
+  // the lists are merged, so a user who is not in any shard's top list is
+  // missed; with one shard the result is exact.
+  async getLeaderboard(count = 10): Promise<QubicLeaderboardEntry[]> {
+    const inputData = { count: Math.min(count, LEADERBOARD_SIZE) };
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetLeaderboard', inputData, shard, (output) => ({
+        success: output.success,
+        count: output.count,
+        userIds: output.userIds.slice(0, output.count),
+        totalWins: output.totalWins.slice(0, output.count),
+        totalBets: output.totalBets.slice(0, output.count),
+        balances: output.balances.slice(0, output.count)
+      })))
+    );
+
+    if (!results.every((result) => result?.success)) {
+      throw new QubicError(
+        'Failed to get leaderboard',
+        QubicErrorCodes.CONTRACT_ERROR
+      );
+    }
+
+    const entries = new Map<number, QubicLeaderboardEntry>();
+    for (const result of results) {
+      for (let i = 0; i < result.count; i++) {
+        const userId = result.userIds[i];
+        const entry = entries.get(userId) ?? { rank: 0, userId, totalWins: 0, totalBets: 0, balance: 0 };
+        entry.totalWins += result.totalWins[i];
+        entry.totalBets += result.totalBets[i];
+        entry.balance += result.balances[i];
+        entries.set(userId, entry);
+      }
+    }
+
+    return Array.from(entries.values())
+      .sort((a, b) => b.totalWins - a.totalWins)
+      .slice(0, inputData.count)
+      .map((entry, index) => ({ ...entry, rank: index + 1 }));
+  }
+
+  // Monitoring Functions
+
+  // Counters are summed over shards; users are mirrored, so userCount is not
+  async getContractStats(): Promise<QubicContractStats> {
+    const results = await Promise.all(
+      this.allShards().map((shard) => this.callContractFunction('GetContractStats', {}, shard, (output) => ({
+        ...scalarFields(output),
+        invocationCount: output.invocationCount.slice(),
+        rejectionCount: output.rejectionCount.slice(),
+        elementsScanned: output.elementsScanned.slice(),
+        lastElementsScanned: output.lastElementsScanned.slice()
+      })))
+    );
+
+    if (results.every((result) => result?.success)) {
+      const sum = (field: string) => results.reduce((total, result) => total + Number(result[field]), 0);
+      const sumCounters = (field: string) => results[0][field].map(
+        (_: number, index: number) => results.reduce((total, result) => total + Number(result[field][index]), 0)
+      );
+      return {
+        invocationCount: this.labelCounters(sumCounters('invocationCount'), CONTRACT_PROCEDURE_NAMES),
+        rejectionCount: this.labelCounters(sumCounters('rejectionCount'), CONTRACT_REJECTION_REASONS),
+        elementsScanned: this.labelCounters(sumCounters('elementsScanned'), CONTRACT_PROCEDURE_NAMES),
+        lastElementsScanned: this.labelCounters(results[0].lastElementsScanned, CONTRACT_PROCEDURE_NAMES),
+        settlementBacklog: sum('settlementBacklog'),
+        userCount: results[0].userCount,
+        eventCount: sum('eventCount'),
+        betCount: sum('betCount'),
+        totalVolume: sum('totalVolume')
+      };
+    }
+
+    throw new QubicError(
+      'Failed to get contract stats',
+      QubicErrorCodes.CONTRACT_ERROR
+    );
+  }
+
+  // Shard Routing
+
+  private allShards(): number[] {
+    return Array.from({ length: this.shards.shardCount }, (_, shard) => shard);
+  }
+
+  private shardContract(shard: number): string {
+    return this.config.shardContracts ? this.config.shardContracts[shard] : this.config.contractAddress;
+  }
+
+  private shardContractIndex(shard: number): number {
+    return this.config.shardContracts ? parseInt(this.config.shardContracts[shard]) : 0;
+  }
+
+  // Moves what the user lacks on `shard` over from their other shards, home
+  // shard first: winnings stay on the shard they were won on, so the home
+  // shard alone may not cover it. Returns the amount moved, for refundShard
+  // if the call it paid for fails.
+  private async fundShard(userId: number, shard: number, needed: number): Promise<number> {
+    const balances = await Promise.all(
+      this.allShards().map((source) => this.callContractFunction('GetBalance', { userId }, source))
+    );
+    const deficit = needed - (balances[shard]?.balance ?? 0);
+    if (deficit <= 0) {
+      return 0;
+    }
+
+    const home = this.shards.homeShard(userId);
+    const sources = [home, ...this.allShards().filter((source) => source !== home)]
+      .filter((source) => source !== shard && balances[source]?.balance > 0);
+    const available = sources.reduce((total, source) => total + balances[source].balance, 0);
+    if (available < deficit) {
+      throw new QubicError(
+        'Insufficient balance across shards',
+        QubicErrorCodes.INSUFFICIENT_BALANCE,
+        { userId, shard, deficit, available }
+      );
+    }
+
+    let moved = 0;
+    for (const source of sources) {
+      if (moved === deficit) {
+        break;
+      }
+
+      const amount = Math.min(deficit - moved, balances[source].balance);
+      const withdrawn = await this.submitTransaction('ShardTransferOut', { userId, amount }, 0, source);
+      if (!withdrawn.result?.success) {
+        // The balance changed since it was read; give back what arrived
+        await this.refundShard(userId, shard, moved);
+        throw new QubicError(
+          'Insufficient balance across shards',
+          QubicErrorCodes.INSUFFICIENT_BALANCE,
+          { userId, shard, deficit, source }
+        );
+      }
+
+      await this.depositOnShard(userId, shard, amount, source).catch(async (error) => {
+        await this.refundShard(userId, shard, moved);
+        throw error;
+      });
+      moved += amount;
+    }
+    return moved;
+  }
+
+  // Returns funds moved by fundShard, all of it to the home shard
+  private async refundShard(userId: number, shard: number, amount: number): Promise<void> {
+    if (amount <= 0) {
+      return;
+    }
+
+    const withdrawn = await this.submitTransaction('ShardTransferOut', { userId, amount }, 0, shard);
+    if (withdrawn.result?.success) {
+      await this.depositOnShard(userId, this.shards.homeShard(userId), amount, shard);
+    }
+  }
+
+  // Second half of a move: credits `amount`, already withdrawn from `source`,
+  // on `shard`. ShardTransferIn fails if the contract is inactive or the user
+  // is not registered there; the funds then go back to `source`.
+  private async depositOnShard(userId: number, shard: number, amount: number, source: number): Promise<void> {
+    const deposited = await this.submitTransaction('ShardTransferIn', { userId, amount }, 0, shard);
+    if (deposited.result?.success) {
+      return;
+    }
+
+    const restored = await this.submitTransaction('ShardTransferIn', { userId, amount }, 0, source);
+    throw new QubicError(
+      'Cross-shard transfer failed',
+      QubicErrorCodes.TRANSACTION_FAILED,
+      { userId, shard, source, amount, restored: Boolean(restored.result?.success) }
+    );
+  }
+
   // Utility Functions
 
+  private labelCounters(values: number[] = [], names: string[]): Record<string, number> {
+    const labeled: Record<string, number> = {};
+    names.forEach((name, index) => {
+      labeled[name] = Number(values[index] ?? 0);
+    });
+    return labeled;
+  }
+
+  private daemonError(error: Error): never {
+    throw new QubicError(
+      `qubic_clientd request failed: ${error.message}`,
+      QubicErrorCodes.NETWORK_ERROR,
+      error
+    );
+  }
+
+  private checkDaemonResponse(response: DaemonResponse): Buffer {
+    if (response.status === FrameStatus.OK) {
+      return response.payload;
+    }
+
+    const codes: Partial<Record<number, QubicErrorCodes>> = {
+      [FrameStatus.UNAVAILABLE]: QubicErrorCodes.NETWORK_ERROR,
+      [FrameStatus.OVER_BUDGET]: QubicErrorCodes.TICK_BUDGET_EXCEEDED
+    };
+    throw new QubicError(
+      `qubic_clientd returned status ${FrameStatus[response.status] ?? response.status}`,
+      codes[response.status] ?? QubicErrorCodes.CONTRACT_ERROR,
+      { status: response.status }
+    );
+  }
+
   private generateTransactionId(): string {
     return `tx_${Date.now()}_${Math.random().toString(36).substr(2, 9)}`;
   }
 
-  private serializeInput(data: any): string {
-    // Convert input data to hex string format expected by Qubic CLI
-    // This is a simplified version - real implementation would need proper serialization
-    return Buffer.from(JSON.stringify(data)).toString('hex');
+  private serializeInput(structName: string, data: StructInput): string {
+    // Packed input struct, hex encoded as expected by Qubic CLI
+    return getCodec(structName).encode(data).toString('hex');
+  }
+
+  private readOutput(structName: string, source: Buffer, read: OutputReader): any {
+    const codec = getCodec(structName);
+    let output = this.outputs.get(structName);
+    if (!output) {
+      output = codec.create();
+      this.outputs.set(structName, output);
+    }
+    return read(codec.decodeInto(source, 0, output));
   }
 
-  private parseOutput(output: string): any {
+  private parseOutput(structName: string, output: string, read: OutputReader): any {
     try {
-      // Parse Qubic CLI output format
-      // This is simplified - real implementation would parse binary data
-      const lines = output.split('\n');
-      const resultLine = lines.find(line => line.includes('Result:'));
+      // Qubic CLI prints the packed output struct as hex
+      const match = output.match(OUTPUT_HEX_PATTERN);
       
-      if (resultLine) {
-        return JSON.parse(resultLine.replace('Result:', '').trim());
+      if (match) {
+        return this.readOutput(structName, Buffer.from(match[1], 'hex'), read);
       }
       
       return null;
@@ -394,15 +1229,15 @@ export class QubicBridge {
     }
   }
 
-  private parseTransactionResult(output: string): { hash: string; data: any } {
+  private parseTransactionResult(structName: string, output: string, read: OutputReader): { hash: string; data: any } {
     try {
       const lines = output.split('\n');
       const hashLine = lines.find(line => line.includes('Transaction Hash:'));
-      const resultLine = lines.find(line => line.includes('Result:'));
+      const match = output.match(OUTPUT_HEX_PATTERN);
       
       return {
         hash: hashLine ? hashLine.split(':')[1].trim() : '',
-        data: resultLine ? JSON.parse(resultLine.split(':')[1].trim()) : null
+        data: match ? this.readOutput(structName, Buffer.from(match[1], 'hex'), read) : null
       };
     } catch (error) {
       throw new QubicError(
@@ -413,27 +1248,6 @@ export class QubicBridge {
     }
   }
 
-  private stringToBytes32(str: string): number[] {
-    const bytes = Buffer.from(str.substring(0, 32), 'utf8');
-    const result = new Array(32).fill(0);
-    bytes.copy(Buffer.from(result), 0);
-    return result;
-  }
-
-  private stringToBytes128(str: string): number[] {
-    const bytes = Buffer.from(str.substring(0, 128), 'utf8');
-    const result = new Array(128).fill(0);
-    bytes.copy(Buffer.from(result), 0);
-    return result;
-  }
-
-  private stringToBytes256(str: string): number[] {
-    const bytes = Buffer.from(str.substring(0, 256), 'utf8');
-    const result = new Array(256).fill(0);
-    bytes.copy(Buffer.from(result), 0);
-    return result;
-  }
-
   // Status Functions
 
   async getTransactionStatus(transactionId: string): Promise<QubicTransaction | null> {
@@ -441,6 +1255,12 @@ export class QubicBridge {
   }
 
   async getCurrentTick(): Promise<number> {
+    if (this.daemon) {
+      // Payload is TickInfo: uint32 tick, uint16 epoch
+      const response = await this.daemon.getTick().catch((error) => this.daemonError(error));
+      return this.checkDaemonResponse(response).readUInt32LE(0);
+    }
+
     const args = [
       '-nodeip', this.config.nodeIp,
       '-nodeport', this.config.nodePort.toString(),
@@ -3,6 +3,7 @@
 
 import express from 'express';
 import { QubicBridge, QubicConfig, QubicError, QubicErrorCodes } from './qubic-bridge';
+import { MAX_OUTCOMES } from './contract-schema';
 import { resolveEventWithAI } from '../server/services/ai';
 
 const router = express.Router();
@@ -13,7 +14,13 @@ const qubicConfig: QubicConfig = {
   nodePort: parseInt(process.env.QUBIC_NODE_PORT || '31841'),
   contractAddress: process.env.QUBIC_CONTRACT_ADDRESS || '',
   cliPath: process.env.QUBIC_CLI_PATH || './qubic-cli',
-  privateKey: process.env.QUBIC_PRIVATE_KEY
+  privateKey: process.env.QUBIC_PRIVATE_KEY,
+  daemonSocket: process.env.QUBIC_DAEMON_SOCKET,
+  daemonTimeoutMs: process.env.QUBIC_DAEMON_TIMEOUT_MS ? parseInt(process.env.QUBIC_DAEMON_TIMEOUT_MS) : undefined,
+  // Comma-separated contract per shard, e.g. "0,1,2,3" with mock_node --shards 4
+  shardContracts: process.env.QUBIC_SHARD_CONTRACTS?.split(',').map((contract) => contract.trim()),
+  // read_replica socket, e.g. /tmp/predictor-replica.sock
+  replicaSocket: process.env.QUBIC_REPLICA_SOCKET
 };
 
 const qubicBridge = new QubicBridge(qubicConfig);
@@ -32,6 +39,9 @@ const handleQubicError = (error: any, res: express.Response) => {
         return res.status(500).json({ message: 'Transaction failed to execute on blockchain' });
       case QubicErrorCodes.NETWORK_ERROR:
         return res.status(503).json({ message: 'Unable to connect to Qubic network' });
+      case QubicErrorCodes.TICK_BUDGET_EXCEEDED:
+        // The node had no room left this tick; the next tick starts a new budget
+        return res.status(503).set('Retry-After', '1').json({ message: 'Network busy this tick, please retry' });
       case QubicErrorCodes.UNAUTHORIZED:
         return res.status(403).json({ message: 'Unauthorized operation' });
       default:
@@ -62,6 +72,18 @@ router.get('/user', async (req, res) => {
   }
 });
 
+// Get open stake and realized profit and loss of the current user
+router.get('/qubic/user/summary', async (req, res) => {
+  try {
+    // For demo purposes, using a fixed user ID
+    const userId = 1;
+    const summary = await qubicBridge.getUserSummary(userId);
+    res.json(summary);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
 // Register new user
 router.post('/qubic/user/register', async (req, res) => {
   try {
@@ -78,6 +100,11 @@ router.post('/qubic/user/register', async (req, res) => {
   }
 });
 
+// YES / NO, or an outcome index of a multi-outcome market
+function isOutcome(value: unknown): boolean {
+  return value === 'YES' || value === 'NO' || (typeof value === 'number' && Number.isInteger(value) && value >= 0 && value < MAX_OUTCOMES);
+}
+
 // Event Management Routes
 
 // Get all active events
@@ -121,17 +148,22 @@ router.get('/events', async (req, res) => {
 // Create new event (admin only)
 router.post('/qubic/events', async (req, res) => {
   try {
-    const { title, description, category, endsAt } = req.body;
+    const { title, description, category, endsAt, outcomeCount = 2 } = req.body;
     
     if (!title || !description || !category || !endsAt) {
       return res.status(400).json({ message: 'All event fields are required' });
     }
     
+    if (!Number.isInteger(outcomeCount) || outcomeCount < 2 || outcomeCount > MAX_OUTCOMES) {
+      return res.status(400).json({ message: `Outcome count must be 2 to ${MAX_OUTCOMES}` });
+    }
+    
     const event = await qubicBridge.createEvent(
       title,
       description,
       category,
-      new Date(endsAt)
+      new Date(endsAt),
+      outcomeCount
     );
     
     res.json(event);
@@ -148,12 +180,12 @@ router.post('/bets', async (req, res) => {
     const { eventId, prediction, amount } = req.body;
     console.log('Received bet data:', { eventId, prediction, amount });
     
-    if (!eventId || !prediction || !amount) {
+    if (!eventId || prediction === undefined || !amount) {
       return res.status(400).json({ message: 'Event ID, prediction, and amount are required' });
     }
     
-    if (prediction !== 'YES' && prediction !== 'NO') {
-      return res.status(400).json({ message: 'Prediction must be YES or NO' });
+    if (!isOutcome(prediction)) {
+      return res.status(400).json({ message: 'Prediction must be YES, NO or an outcome index' });
     }
     
     if (amount < 1) {
@@ -196,6 +228,59 @@ router.post('/bets', async (req, res) => {
   }
 });
 
+// Order Book Routes
+
+// Place a limit order for YES shares
+router.post('/qubic/events/:eventId/orders', async (req, res) => {
+  try {
+    const eventId = parseInt(req.params.eventId);
+    const { side, price, quantity } = req.body;
+
+    if (side !== 'BUY' && side !== 'SELL') {
+      return res.status(400).json({ message: 'Side must be BUY or SELL' });
+    }
+
+    if (!Number.isInteger(price) || price < 1 || price > 99) {
+      return res.status(400).json({ message: 'Price must be an integer from 1 to 99' });
+    }
+
+    if (!Number.isInteger(quantity) || quantity < 1) {
+      return res.status(400).json({ message: 'Quantity must be at least 1' });
+    }
+
+    // For demo purposes, using a fixed user ID
+    const userId = 1;
+
+    const order = await qubicBridge.placeOrder(userId, eventId, side, price, quantity);
+    res.json({ success: true, order });
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Cancel a resting order
+router.delete('/qubic/orders/:orderId', async (req, res) => {
+  try {
+    // For demo purposes, using a fixed user ID
+    const userId = 1;
+
+    const balance = await qubicBridge.cancelOrder(userId, parseInt(req.params.orderId));
+    res.json({ success: true, balance });
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Get best bid and ask for an event
+router.get('/qubic/events/:eventId/book', async (req, res) => {
+  try {
+    const book = await qubicBridge.getBestBidAsk(parseInt(req.params.eventId));
+    res.json(book);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
 // Get betting history
 router.get('/bets/history', async (req, res) => {
   try {
@@ -224,6 +309,38 @@ router.get('/bets/history', async (req, res) => {
   }
 });
 
+// Filter bets through the read replica, e.g.
+// ?userId=1&unsettled=1&minAmount=10&maxAmount=50&limit=100&offset=0
+router.get('/qubic/bets', async (req, res) => {
+  try {
+    const numbers: Record<string, number | undefined> = {};
+    for (const name of ['userId', 'eventId', 'minAmount', 'maxAmount', 'limit', 'offset']) {
+      if (req.query[name] === undefined) {
+        continue;
+      }
+      const value = Number(req.query[name]);
+      if (!Number.isInteger(value) || value < 0 || value > 0xffffffff) {
+        return res.status(400).json({ message: `${name} must be a non-negative integer` });
+      }
+      numbers[name] = value;
+    }
+
+    const kernel = req.query.kernel;
+    if (kernel !== undefined && kernel !== 'scalar' && kernel !== 'avx2') {
+      return res.status(400).json({ message: 'kernel must be scalar or avx2' });
+    }
+
+    const page = await qubicBridge.queryBets({
+      ...numbers,
+      unsettledOnly: req.query.unsettled === '1' || req.query.unsettled === 'true',
+      kernel
+    });
+    res.json(page);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
 // Qubic Status Routes
 
 // Get current blockchain status
@@ -240,7 +357,8 @@ router.get('/qubic/status', async (req, res) => {
       contractBalance,
       nodeIp: qubicConfig.nodeIp,
       nodePort: qubicConfig.nodePort,
-      contractAddress: qubicConfig.contractAddress
+      contractAddress: qubicConfig.contractAddress,
+      shardContracts: qubicConfig.shardContracts
     });
   } catch (error) {
     res.json({
@@ -252,6 +370,32 @@ router.get('/qubic/status', async (req, res) => {
   }
 });
 
+// Get top users by wins, e.g. ?limit=10
+router.get('/qubic/leaderboard', async (req, res) => {
+  try {
+    const limit = parseInt(String(req.query.limit || '10'));
+
+    if (!Number.isInteger(limit) || limit < 1) {
+      return res.status(400).json({ message: 'Limit must be a positive integer' });
+    }
+
+    const leaderboard = await qubicBridge.getLeaderboard(limit);
+    res.json(leaderboard);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Get contract performance counters
+router.get('/qubic/stats', async (req, res) => {
+  try {
+    const stats = await qubicBridge.getContractStats();
+    res.json(stats);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
 // Get transaction status
 router.get('/qubic/transaction/:transactionId', async (req, res) => {
   try {
@@ -276,8 +420,8 @@ router.post('/qubic/events/:eventId/resolve', async (req, res) => {
     const { eventId } = req.params;
     const { correctAnswer, confidence } = req.body;
     
-    if (!correctAnswer || correctAnswer === undefined) {
-      return res.status(400).json({ message: 'Correct answer is required' });
+    if (!isOutcome(correctAnswer)) {
+      return res.status(400).json({ message: 'Correct answer must be YES, NO or an outcome index' });
     }
     
     await qubicBridge.resolveEvent(
@@ -292,6 +436,96 @@ router.post('/qubic/events/:eventId/resolve', async (req, res) => {
   }
 });
 
+// Resolve many events at once (admin only),
+// e.g. { "resolutions": [{ "eventId": 1, "correctAnswer": "YES", "confidence": 90 }] }
+router.post('/qubic/events/resolve', async (req, res) => {
+  try {
+    const { resolutions } = req.body;
+
+    if (!Array.isArray(resolutions) || resolutions.length === 0) {
+      return res.status(400).json({ message: 'At least one resolution is required' });
+    }
+
+    for (const resolution of resolutions) {
+      if (!Number.isInteger(resolution?.eventId) || !isOutcome(resolution.correctAnswer)) {
+        return res.status(400).json({ message: 'Each resolution needs an eventId and a YES, NO or outcome index correctAnswer' });
+      }
+    }
+
+    const results = await qubicBridge.resolveEvents(resolutions.map((resolution) => ({
+      eventId: resolution.eventId,
+      correctAnswer: resolution.correctAnswer,
+      confidence: resolution.confidence || 100
+    })));
+    res.json({ success: true, results });
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Attach an LMSR market maker to an event (admin only)
+router.post('/qubic/events/:eventId/market-maker', async (req, res) => {
+  try {
+    const { liquidity } = req.body;
+
+    if (!Number.isInteger(liquidity) || liquidity < 1) {
+      return res.status(400).json({ message: 'Liquidity must be a positive integer' });
+    }
+
+    await qubicBridge.enableMarketMaker(parseInt(req.params.eventId), liquidity);
+    res.json({ success: true, message: 'Market maker enabled' });
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Per-user limit on stake in unsettled bets, 0 for none (admin only)
+router.post('/qubic/limits/open-stake', async (req, res) => {
+  try {
+    const { maxOpenStake } = req.body;
+
+    if (!Number.isInteger(maxOpenStake) || maxOpenStake < 0 || maxOpenStake > 0xffffffff) {
+      return res.status(400).json({ message: 'maxOpenStake must be a non-negative integer' });
+    }
+
+    await qubicBridge.setMaxOpenStake(maxOpenStake);
+    res.json({ success: true, message: 'Open stake limit set' });
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Bets per outcome of an event
+router.get('/qubic/events/:eventId/outcomes', async (req, res) => {
+  try {
+    const tally = await qubicBridge.getOutcomeTally(parseInt(req.params.eventId));
+    res.json(tally);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
+// Quote a market maker bet, e.g. ?prediction=YES&shares=10
+router.get('/qubic/events/:eventId/quote', async (req, res) => {
+  try {
+    const prediction = req.query.prediction;
+    const shares = parseInt(String(req.query.shares || '1'));
+
+    if (prediction !== 'YES' && prediction !== 'NO') {
+      return res.status(400).json({ message: 'Prediction must be YES or NO' });
+    }
+
+    if (!Number.isInteger(shares) || shares < 1) {
+      return res.status(400).json({ message: 'Shares must be at least 1' });
+    }
+
+    const quote = await qubicBridge.quoteBet(parseInt(req.params.eventId), prediction, shares);
+    res.json(quote);
+  } catch (error) {
+    handleQubicError(error, res);
+  }
+});
+
 // Health check
 router.get('/qubic/health', async (req, res) => {
   try {
@@ -0,0 +1,61 @@
+// Id routing for a sharded deployment: N instances of HM25.h, instance k
+// configured with ConfigureShard(k, N). Mirrors qubic-native/include/shard_map.h.
+//
+// - Events interleave: global event g lives on shard (g - 1) % N under local
+//   id floor((g - 1) / N) + 1.
+// - Users are registered on every shard under the same id; their balance
+//   starts on the home shard (userId - 1) % N.
+// - Bet ids interleave like event ids: shard-local bet b on shard k is global
+//   bet (b - 1) * N + k + 1.
+// - Order ids are local to a shard; globally they are local * N + shard.
+
+export class ShardMap {
+  readonly shardCount: number;
+
+  constructor(shardCount: number) {
+    if (!Number.isInteger(shardCount) || shardCount < 1) {
+      throw new Error(`Invalid shard count ${shardCount}`);
+    }
+    this.shardCount = shardCount;
+  }
+
+  eventShard(globalEventId: number): number {
+    return (globalEventId - 1) % this.shardCount;
+  }
+
+  localEventId(globalEventId: number): number {
+    return Math.floor((globalEventId - 1) / this.shardCount) + 1;
+  }
+
+  globalEventId(shard: number, localEventId: number): number {
+    return (localEventId - 1) * this.shardCount + shard + 1;
+  }
+
+  homeShard(userId: number): number {
+    return (userId - 1) % this.shardCount;
+  }
+
+  betShard(globalBetId: number): number {
+    return (globalBetId - 1) % this.shardCount;
+  }
+
+  localBetId(globalBetId: number): number {
+    return Math.floor((globalBetId - 1) / this.shardCount) + 1;
+  }
+
+  globalBetId(shard: number, localBetId: number): number {
+    return (localBetId - 1) * this.shardCount + shard + 1;
+  }
+
+  orderShard(globalOrderId: number): number {
+    return globalOrderId % this.shardCount;
+  }
+
+  localOrderId(globalOrderId: number): number {
+    return Math.floor(globalOrderId / this.shardCount);
+  }
+
+  globalOrderId(shard: number, localOrderId: number): number {
+    return localOrderId * this.shardCount + shard;
+  }
+}
@@ -0,0 +1,131 @@
+// Local framing spoken with qubic_clientd
+// Mirrors qubic-native/include/wire_protocol.h; keep both in sync.
+
+export const FRAME_HEADER_SIZE = 16;
+export const TRANSACTION_PREFIX_SIZE = 8;
+export const MAX_FRAME_SIZE = 1 << 20;
+export const BET_QUERY_SIZE = 24;
+export const BET_QUERY_RESULT_SIZE = 16;
+export const BET_RECORD_SIZE = 24;
+export const MAX_QUERY_BETS = 1000;
+
+export enum FrameType {
+  CALL_FUNCTION = 1,
+  SEND_TRANSACTION = 2,
+  RESPONSE = 3,
+  TRANSACTION_BATCH = 4,
+  GET_TICK = 5,
+  QUERY_BETS = 6
+}
+
+export enum FrameStatus {
+  OK = 0,
+  UNKNOWN_FUNCTION = 1,
+  BAD_INPUT = 2,
+  UNAVAILABLE = 3,
+  // Transaction rejected: the tick's cost budget was used up (mock_node --tick-budget)
+  OVER_BUDGET = 4
+}
+
+// Scan kernel read_replica uses for a query (bet_scan.h)
+export enum ScanKernel {
+  DEFAULT = 0,
+  SCALAR = 1,
+  AVX2 = 2
+}
+
+export interface FrameHeader {
+  size: number;
+  type: FrameType;
+  inputType: number;
+  requestId: number;
+  contractIndex: number;
+  status: number;
+}
+
+export function writeFrameHeader(header: FrameHeader, target: Buffer, offset = 0): void {
+  target.writeUInt32LE(header.size, offset);
+  target.writeUInt16LE(header.type, offset + 4);
+  target.writeUInt16LE(header.inputType, offset + 6);
+  target.writeUInt32LE(header.requestId, offset + 8);
+  target.writeUInt16LE(header.contractIndex, offset + 12);
+  target.writeUInt16LE(header.status, offset + 14);
+}
+
+export function readFrameHeader(source: Buffer, offset = 0): FrameHeader {
+  return {
+    size: source.readUInt32LE(offset),
+    type: source.readUInt16LE(offset + 4),
+    inputType: source.readUInt16LE(offset + 6),
+    requestId: source.readUInt32LE(offset + 8),
+    contractIndex: source.readUInt16LE(offset + 12),
+    status: source.readUInt16LE(offset + 14)
+  };
+}
+
+// Zero userId / eventId match any bet; maxAmount 0 means no upper bound
+export interface BetQuery {
+  userId: number;
+  eventId: number;
+  minAmount: number;
+  maxAmount: number;
+  offset: number;
+  limit: number;
+  unsettledOnly: boolean;
+  kernel: ScanKernel;
+}
+
+export interface BetRecord {
+  id: number;
+  userId: number;
+  eventId: number;
+  amount: number;
+  createdAt: number;  // Tick
+  prediction: number;
+  isWon: boolean;
+  isProcessed: boolean;
+}
+
+export interface BetQueryResult {
+  total: number;
+  tick: number;
+  scanMicros: number;
+  records: BetRecord[];
+}
+
+export function writeBetQuery(query: BetQuery): Buffer {
+  const payload = Buffer.alloc(BET_QUERY_SIZE);
+  payload.writeUInt32LE(query.userId, 0);
+  payload.writeUInt32LE(query.eventId, 4);
+  payload.writeUInt32LE(query.minAmount, 8);
+  payload.writeUInt32LE(query.maxAmount, 12);
+  payload.writeUInt32LE(query.offset, 16);
+  payload.writeUInt16LE(query.limit, 20);
+  payload.writeUInt8(query.unsettledOnly ? 1 : 0, 22);
+  payload.writeUInt8(query.kernel, 23);
+  return payload;
+}
+
+export function readBetQueryResult(source: Buffer): BetQueryResult {
+  const count = source.readUInt32LE(4);
+  const records: BetRecord[] = [];
+  for (let i = 0; i < count; i++) {
+    const offset = BET_QUERY_RESULT_SIZE + i * BET_RECORD_SIZE;
+    records.push({
+      id: source.readUInt32LE(offset),
+      userId: source.readUInt32LE(offset + 4),
+      eventId: source.readUInt32LE(offset + 8),
+      amount: source.readUInt32LE(offset + 12),
+      createdAt: source.readUInt32LE(offset + 16),
+      prediction: source.readUInt8(offset + 20),
+      isWon: source.readUInt8(offset + 21) !== 0,
+      isProcessed: source.readUInt8(offset + 22) !== 0
+    });
+  }
+  return {
+    total: source.readUInt32LE(0),
+    tick: source.readUInt32LE(8),
+    scanMicros: source.readUInt32LE(12),
+    records
+  };
+}
@@ -12,6 +12,151 @@
 #define MAX_USERS 10000
 #define MAX_EVENTS 1000
 #define MAX_BETS 100000
+#define MAX_RESOLVE_BATCH 64  // Events settled by one ResolveEvents call
+#define LEADERBOARD_SIZE 50   // Users ranked by totalWins, kept sorted as wins are paid
+#define MAX_OPEN_STAKE 0      // Initial maxOpenStake: most a user may have riding on unsettled bets, 0 = no limit
+#define MAX_OUTCOMES 16       // Outcomes of one market; binary YES/NO markets have 2
+
+// Order book constants
+// A YES share pays ORDER_SHARE_PAYOUT when the event resolves YES; a NO share
+// pays it when the event resolves NO. Orders are limit prices for YES shares.
+#define ORDER_PRICE_LEVELS 99      // Prices 1..99
+#define ORDER_SHARE_PAYOUT 100
+#define ORDER_SIDE_BUY 0           // Bid for YES shares
+#define ORDER_SIDE_SELL 1          // Ask for YES shares, i.e. bid for NO at payout - price
+#define MAX_ORDERS 16384           // Resting order pool, reused through a free list
+#define ORDER_SLOT_BITS 14         // Order id = generation << ORDER_SLOT_BITS | slot
+#define MAX_POSITIONS 32768        // Open addressing table, power of two
+#define MAX_POSITION_LOAD 24576    // Three quarters of MAX_POSITIONS
+
+// LMSR market maker constants
+// An event with a market maker sells YES/NO shares (paying ORDER_SHARE_PAYOUT)
+// at the logarithmic market scoring rule price. All math is Q28 fixed point.
+#define LMSR_FRACTION_BITS 28
+#define LMSR_ONE ((sint64)1 << LMSR_FRACTION_BITS)
+#define LMSR_EXP_STEP_BITS 6       // e^-x tabulated every 1/64 ...
+#define LMSR_EXP_FINE_BITS 8       // ... and within a step every 1/16384
+#define LMSR_EXP_RANGE 20          // e^-x taken as 0 from x = 20, below Q28 resolution
+#define LMSR_EXP_ENTRIES ((LMSR_EXP_RANGE << LMSR_EXP_STEP_BITS) + 1)
+#define LMSR_LOG_STEP_BITS 8       // ln(1 + y) tabulated every 1/256 over [0, 1]
+#define LMSR_LOG_ENTRIES ((1 << LMSR_LOG_STEP_BITS) + 1)
+#define LMSR_TABLE_GUARD_BITS 6    // Extra precision while building the tables
+#define LMSR_QUOTE_MARGIN 16       // Q28 units added to every quote; above the softplus error
+#define LMSR_MAX_LIQUIDITY 1000000 // Largest b, in shares
+#define LMSR_MAX_TRADE 1000000     // Most shares bought by one PlaceBet
+#define PRICE_BASIS_POINTS 10000
+
+// Sharding constants
+// A sharded deployment runs MAX_SHARDS or fewer instances of this contract.
+// Every instance registers every user, so user ids agree everywhere; a
+// user's balance starts on its home shard, (userId - 1) % shardCount, and
+// the operator moves funds between shards with ShardTransferOut/In.
+#define MAX_SHARDS 64
+
+// Performance counter slots, one per public function index
+#define STAT_REGISTER_USER 0
+#define STAT_CREATE_EVENT 1
+#define STAT_PLACE_BET 2
+#define STAT_RESOLVE_EVENT 3
+#define STAT_GET_BALANCE 4
+#define STAT_GET_EVENTS 5
+#define STAT_GET_USER_BETS 6
+#define STAT_GET_CONTRACT_STATS 7
+#define STAT_PLACE_ORDER 8
+#define STAT_CANCEL_ORDER 9
+#define STAT_GET_BEST_BID_ASK 10
+#define STAT_ENABLE_MARKET_MAKER 11
+#define STAT_QUOTE_BET 12
+#define STAT_CONFIGURE_SHARD 13
+#define STAT_SHARD_TRANSFER_OUT 14
+#define STAT_SHARD_TRANSFER_IN 15
+#define STAT_RESOLVE_EVENTS 16
+#define STAT_GET_LEADERBOARD 17
+#define STAT_GET_USER_SUMMARY 18
+#define STAT_GET_OUTCOME_TALLY 19
+#define STAT_UNREGISTER_USER 20
+#define STAT_SET_MAX_OPEN_STAKE 21
+#define STAT_PROCEDURE_COUNT 22
+
+// Rejection reasons tracked by the performance counters
+#define REJECT_CONTRACT_INACTIVE 0
+#define REJECT_CAPACITY_FULL 1
+#define REJECT_UNAUTHORIZED 2
+#define REJECT_USER_NOT_FOUND 3
+#define REJECT_INSUFFICIENT_BALANCE 4
+#define REJECT_EVENT_NOT_FOUND 5
+#define REJECT_EVENT_CLOSED 6
+#define REJECT_INVALID_ORDER 7
+#define REJECT_ORDER_NOT_FOUND 8
+#define REJECT_NO_MARKET_MAKER 9
+#define REJECT_INVALID_CONFIG 10
+#define REJECT_INVALID_BATCH 11
+#define REJECT_EXPOSURE_LIMIT 12
+#define REJECT_INVALID_OUTCOME 13
+#define REJECT_REASON_COUNT 14
+
+// LMSR lookup tables, built at compile time with integer arithmetic only.
+// e^-x = expNeg[x in 1/64 steps] * expNegFine[rest in 1/16384 steps] * (1 - rest),
+// and ln(1 + y) = log1p[node] + ln(1 + t) with a three term series for t < 1/256.
+struct LmsrTables {
+    uint32 expNeg[LMSR_EXP_ENTRIES];                 // e^-(i / 64), Q28
+    uint32 expNegFine[1 << LMSR_EXP_FINE_BITS];      // e^-(i / 16384), Q28
+    uint32 log1p[LMSR_LOG_ENTRIES];                  // ln(1 + i / 256), Q28
+};
+
+// e^-f for Q28 f in [0, 1] by its Taylor series, in Q28 + LMSR_TABLE_GUARD_BITS
+constexpr sint64 lmsrExpNegSeries(sint64 f)
+{
+    sint64 term = LMSR_ONE << LMSR_TABLE_GUARD_BITS;
+    sint64 sum = term;
+    for (sint64 k = 1; term; k++) {
+        term = term * f / LMSR_ONE / k;
+        sum += k % 2 ? -term : term;
+    }
+    return sum;
+}
+
+// e^-x for Q28 x >= 0 as e^-floor(x) * e^-frac(x)
+constexpr sint64 lmsrExpNeg(sint64 x)
+{
+    sint64 result = lmsrExpNegSeries(x & (LMSR_ONE - 1));
+    sint64 inverseE = lmsrExpNegSeries(LMSR_ONE) >> LMSR_TABLE_GUARD_BITS;
+    for (sint64 n = x >> LMSR_FRACTION_BITS; n > 0; n--) {
+        result = result * inverseE / LMSR_ONE;
+    }
+    return (result + ((sint64)1 << (LMSR_TABLE_GUARD_BITS - 1))) >> LMSR_TABLE_GUARD_BITS;
+}
+
+// ln(1 + y) for Q28 y in [0, 1]: 2 atanh(y / (2 + y)), whose series converges by 1/9 per term
+constexpr sint64 lmsrLog1p(sint64 y)
+{
+    sint64 z = (y << LMSR_TABLE_GUARD_BITS) * LMSR_ONE / (2 * LMSR_ONE + y);
+    sint64 zSquared = z * (z >> LMSR_TABLE_GUARD_BITS) / LMSR_ONE;
+    sint64 power = z;
+    sint64 sum = 0;
+    for (sint64 k = 1; power; k += 2) {
+        sum += power / k;
+        power = power * (zSquared >> LMSR_TABLE_GUARD_BITS) / LMSR_ONE;
+    }
+    return (2 * sum + ((sint64)1 << (LMSR_TABLE_GUARD_BITS - 1))) >> LMSR_TABLE_GUARD_BITS;
+}
+
+constexpr LmsrTables buildLmsrTables()
+{
+    LmsrTables tables = {};
+    for (uint32 i = 0; i < LMSR_EXP_ENTRIES; i++) {
+        tables.expNeg[i] = (uint32)lmsrExpNeg((sint64)i << (LMSR_FRACTION_BITS - LMSR_EXP_STEP_BITS));
+    }
+    for (uint32 i = 0; i < (1 << LMSR_EXP_FINE_BITS); i++) {
+        tables.expNegFine[i] = (uint32)lmsrExpNeg((sint64)i << (LMSR_FRACTION_BITS - LMSR_EXP_STEP_BITS - LMSR_EXP_FINE_BITS));
+    }
+    for (uint32 i = 0; i < LMSR_LOG_ENTRIES; i++) {
+        tables.log1p[i] = (uint32)lmsrLog1p((sint64)i << (LMSR_FRACTION_BITS - LMSR_LOG_STEP_BITS));
+    }
+    return tables;
+}
+
+constexpr LmsrTables LMSR_TABLES = buildLmsrTables();
 
 // Input/Output structures for contract functions
 
@@ -26,11 +171,22 @@ struct RegisterUserOutput {
     uint8 success;
 };
 
+// Withdraws the latest registration, for a registration that failed on
+// another shard
+struct UnregisterUserInput {
+    uint32 userId;
+};
+
+struct UnregisterUserOutput {
+    uint8 success;
+};
+
 struct CreateEventInput {
     char title[128];
     char description[256];
     char category[32];
     uint32 endsAt;
+    uint8 outcomeCount;  // 2..MAX_OUTCOMES; 0 means a binary YES/NO market
 };
 
 struct CreateEventOutput {
@@ -41,7 +197,7 @@ struct CreateEventOutput {
 struct PlaceBetInput {
     uint32 userId;
     uint32 eventId;
-    uint8 prediction;  // 0 = NO, 1 = YES
+    uint8 prediction;  // 0 = NO, 1 = YES; the outcome index in a multi-outcome market
     uint32 amount;
 };
 
@@ -53,7 +209,7 @@ struct PlaceBetOutput {
 
 struct ResolveEventInput {
     uint32 eventId;
-    uint8 correctAnswer;  // 0 = NO, 1 = YES
+    uint8 correctAnswer;  // 0 = NO, 1 = YES; the outcome index in a multi-outcome market
     uint8 confidence;
 };
 
@@ -83,6 +239,169 @@ struct GetEventsOutput {
     uint8 success;
 };
 
+struct GetContractStatsInput {
+};
+
+struct GetContractStatsOutput {
+    uint32 invocationCount[STAT_PROCEDURE_COUNT];    // Calls per function index
+    uint32 rejectionCount[REJECT_REASON_COUNT];      // Failed calls per REJECT_* reason
+    uint64 elementsScanned[STAT_PROCEDURE_COUNT];    // Array elements visited, all calls
+    uint32 lastElementsScanned[STAT_PROCEDURE_COUNT]; // Array elements visited, latest call
+    uint32 settlementBacklog;  // Bets placed but not yet processed by ResolveEvent
+    uint32 userCount;
+    uint32 eventCount;
+    uint32 betCount;
+    uint32 totalVolume;
+    uint8 success;
+};
+
+struct PlaceOrderInput {
+    uint32 userId;
+    uint32 eventId;
+    uint32 quantity;  // Shares
+    uint8 side;       // ORDER_SIDE_BUY or ORDER_SIDE_SELL
+    uint8 price;      // 1..ORDER_PRICE_LEVELS
+};
+
+struct PlaceOrderOutput {
+    uint32 orderId;          // Resting order, 0 when fully filled
+    uint32 filledQuantity;
+    uint32 restingQuantity;
+    uint32 fillCost;         // Paid for the filled shares, at maker prices
+    uint32 newBalance;
+    uint8 success;
+};
+
+struct CancelOrderInput {
+    uint32 userId;
+    uint32 orderId;
+};
+
+struct CancelOrderOutput {
+    uint32 refund;
+    uint32 newBalance;
+    uint8 success;
+};
+
+struct GetBestBidAskInput {
+    uint32 eventId;
+};
+
+struct GetBestBidAskOutput {
+    uint32 bidQuantity;  // Shares resting at bestBid
+    uint32 askQuantity;  // Shares resting at bestAsk
+    uint8 bestBid;       // 0 when there are no bids
+    uint8 bestAsk;       // 0 when there are no asks
+    uint8 success;
+};
+
+struct EnableMarketMakerInput {
+    uint32 eventId;
+    uint32 liquidity;  // LMSR b in shares; the maker can lose at most b ln 2 payouts
+};
+
+struct EnableMarketMakerOutput {
+    uint8 success;
+};
+
+struct QuoteBetInput {
+    uint32 eventId;
+    uint32 amount;     // Shares, as passed to PlaceBet
+    uint8 prediction;  // 0 = NO, 1 = YES
+};
+
+struct QuoteBetOutput {
+    uint32 cost;         // Balance PlaceBet would charge
+    uint32 yesPriceBps;  // Current YES price in basis points of ORDER_SHARE_PAYOUT
+    uint8 success;
+};
+
+struct ConfigureShardInput {
+    uint32 shardIndex;
+    uint32 shardCount;
+};
+
+struct ConfigureShardOutput {
+    uint8 success;
+};
+
+struct SetMaxOpenStakeInput {
+    uint32 maxOpenStake;  // 0 = no limit
+};
+
+struct SetMaxOpenStakeOutput {
+    uint8 success;
+};
+
+struct ShardTransferInput {
+    uint32 userId;
+    uint32 amount;
+};
+
+struct ShardTransferOutput {
+    uint32 newBalance;
+    uint8 success;
+};
+
+// Entry i resolves eventIds[i] with correctAnswers[i]; the first count entries are used
+struct ResolveEventsInput {
+    uint32 eventIds[MAX_RESOLVE_BATCH];
+    uint8 correctAnswers[MAX_RESOLVE_BATCH];  // 0 = NO, 1 = YES, or the outcome index
+    uint8 confidences[MAX_RESOLVE_BATCH];
+    uint8 count;
+};
+
+struct ResolveEventsOutput {
+    uint32 winnersCount[MAX_RESOLVE_BATCH];
+    uint32 totalPayout[MAX_RESOLVE_BATCH];
+    uint8 resolved[MAX_RESOLVE_BATCH];  // 0 when the entry's event was missing or closed
+    uint8 resolvedCount;
+    uint8 success;
+};
+
+struct GetLeaderboardInput {
+    uint32 count;  // Entries wanted, at most LEADERBOARD_SIZE
+};
+
+// Entry i is rank i + 1; the first count entries are filled
+struct GetLeaderboardOutput {
+    uint32 userIds[LEADERBOARD_SIZE];
+    uint32 totalWins[LEADERBOARD_SIZE];
+    uint32 totalBets[LEADERBOARD_SIZE];
+    uint32 balances[LEADERBOARD_SIZE];
+    uint32 count;
+    uint8 success;
+};
+
+struct GetUserSummaryInput {
+    uint32 userId;
+};
+
+// The running aggregates kept in User, read without walking bets
+struct GetUserSummaryOutput {
+    uint64 openStake;
+    sint64 realizedPnl;
+    uint32 balance;
+    uint32 totalBets;
+    uint32 totalWins;
+    uint32 openBets;
+    uint8 success;
+};
+
+struct GetOutcomeTallyInput {
+    uint32 eventId;
+};
+
+// Bets per outcome; a binary market reports noBets / yesBets as outcomes 0 / 1
+struct GetOutcomeTallyOutput {
+    uint32 bets[MAX_OUTCOMES];
+    uint8 outcomeCount;
+    uint8 isResolved;
+    uint8 correctAnswer;
+    uint8 hasMarketMaker;  // Bets on this event are priced by QuoteBet
+    uint8 success;
+};
+
 // Data structures
 struct User {
     char username[32];
@@ -92,6 +411,13 @@ struct User {
     uint32 totalWins;
     uint8 isActive;
     uint32 id;
+    
+    // Running aggregates over the user's flat bets, kept by PlaceBet and
+    // settlement. Market maker bets are positions from the start and are
+    // paid with the order book's, so they are not counted here.
+    uint32 openBets;     // Placed and not yet settled
+    uint64 openStake;    // Sum of their amounts
+    sint64 realizedPnl;  // Payouts minus stakes of settled bets
 };
 
 struct Event {
@@ -103,8 +429,9 @@ struct Event {
     uint8 isActive;
     uint8 isResolved;
     uint8 correctAnswer;
+    uint8 outcomeCount;  // 2 for YES/NO; bets predict, and answers name, outcome 0..outcomeCount - 1
     uint32 totalBets;
-    uint32 yesBets;
+    uint32 yesBets;      // Binary markets only
     uint32 noBets;
     uint32 id;
 };
@@ -120,6 +447,57 @@ struct Bet {
     uint32 id;
 };
 
+// Resting limit order. prev/next link the orders of one price level in time
+// order as slot + 1 (0 = none); next also links free slots.
+struct Order {
+    uint32 userId;
+    uint32 eventId;
+    uint32 quantity;
+    uint32 prev;
+    uint32 next;
+    uint32 generation;  // Bumped on every reuse so stale order ids are rejected
+    uint8 price;
+    uint8 side;
+    uint8 isActive;
+};
+
+// Shares a user holds in one event. Slots with userId 0 are empty.
+struct Position {
+    uint32 userId;
+    uint32 eventId;
+    uint32 yesShares;
+    uint32 noShares;
+    uint32 nextInEvent;  // Next position of the same event, slot + 1
+};
+
+// Per-event book, indexed by event slot; price level i holds price i + 1
+struct OrderBook {
+    uint32 bidHead[ORDER_PRICE_LEVELS];
+    uint32 bidTail[ORDER_PRICE_LEVELS];
+    uint32 askHead[ORDER_PRICE_LEVELS];
+    uint32 askTail[ORDER_PRICE_LEVELS];
+    uint32 bidQuantity[ORDER_PRICE_LEVELS];
+    uint32 askQuantity[ORDER_PRICE_LEVELS];
+    uint32 positionHead;  // First position of this event, slot + 1
+    uint8 bestBid;        // Highest bid price, 0 = none
+    uint8 bestAsk;        // Lowest ask price, 0 = none
+};
+
+// Bets per outcome of a market with more than two outcomes, indexed by
+// event slot. Binary markets keep their yesBets / noBets in Event instead.
+struct OutcomeTally {
+    uint32 bets[MAX_OUTCOMES];
+};
+
+// LMSR market maker of one event, indexed by event slot
+struct MarketMaker {
+    uint64 collected;   // Paid in by PlaceBet
+    uint32 liquidity;   // b, in shares
+    uint32 yesShares;   // Shares sold, q_yes
+    uint32 noShares;    // Shares sold, q_no
+    uint8 isEnabled;
+};
+
 struct CONTRACT_STATE
 {
     // Storage arrays
@@ -136,6 +514,7 @@ struct CONTRACT_STATE
     uint32 defaultBalance;
     uint32 betCost;
     uint32 winReward;
+    uint32 maxOpenStake;  // 0 = no limit
     
     // Stats
     uint32 totalUsers;
@@ -143,6 +522,41 @@ struct CONTRACT_STATE
     uint32 totalBets;
     uint32 totalVolume;
     
+    // Performance counters
+    uint32 invocationCount[STAT_PROCEDURE_COUNT];
+    uint32 rejectionCount[REJECT_REASON_COUNT];
+    uint64 elementsScanned[STAT_PROCEDURE_COUNT];
+    uint32 lastElementsScanned[STAT_PROCEDURE_COUNT];
+    uint32 settlementBacklog;
+    
+    // Order book
+    Order orders[MAX_ORDERS];
+    Position positions[MAX_POSITIONS];
+    OrderBook books[MAX_EVENTS];
+    uint32 orderFreeHead;    // First free order slot + 1
+    uint32 orderHighWater;   // Order slots ever handed out
+    uint32 positionCount;
+    
+    // Market makers
+    MarketMaker makers[MAX_EVENTS];
+    
+    // Multi-outcome markets
+    OutcomeTally tallies[MAX_EVENTS];
+    
+    // Sharding
+    uint32 shardIndex;
+    uint32 shardCount;
+    uint64 transferredOut;  // Sum of ShardTransferOut amounts
+    uint64 transferredIn;   // Sum of ShardTransferIn amounts
+    
+    // Batch resolution: entry index + 1 per event slot during ResolveEvents, else 0
+    uint8 resolveBatchEntry[MAX_EVENTS];
+    
+    // Leaderboard: user slots by descending totalWins, and each user's rank (0 = unranked)
+    uint32 leaderboard[LEADERBOARD_SIZE];
+    uint32 leaderboardCount;
+    uint8 leaderboardRank[MAX_USERS];
+    
     // Admin
     m256i adminId;
     uint8 contractActive;
@@ -156,9 +570,44 @@ struct CONTRACT_STATE
     uint8 tempResult;
     uint32 tempCount;
     uint32 tempIndex;
+    uint32 tempBatchIndex;
+    uint32 tempScanned;
     User tempUser;
     Event tempEvent;
     Bet tempBet;
+    
+    // Order book scratch
+    uint32 tempOrderSlot;
+    uint32 tempMakerSlot;
+    uint32 tempLevel;
+    uint32 tempFill;
+    uint32 tempRemaining;
+    uint64 tempCost;
+    uint64 tempRefund;
+    uint32 tempPositionUserId;
+    uint32 tempPositionEventId;
+    uint32 tempPositionSlot;
+    uint32 tempTakerPositionSlot;
+    uint32 tempYesShares;
+    uint32 tempNoShares;
+    uint32 tempPairs;
+    
+    // Market maker scratch (Q28 fixed point)
+    sint64 tempLmsrX;
+    sint64 tempLmsrY;
+    sint64 tempLmsrAbs;
+    sint64 tempLmsrExp;
+    sint64 tempLmsrFrac;
+    sint64 tempLmsrBase;
+    sint64 tempLmsrPrice;
+    uint32 tempLmsrIndex;
+    uint32 tempLmsrShares;
+    uint8 tempLmsrPrediction;
+    
+    // Leaderboard scratch
+    uint32 tempLeaderSlot;
+    uint32 tempLeaderRank;
+    uint32 tempLeaderSwap;
 };
 
 BEGIN_CONTRACT(PredictoR)
@@ -171,6 +620,21 @@ BEGIN_CONTRACT(PredictoR)
     public_function(GetBalance, 4);
     public_function(GetEvents, 5);
     public_function(GetUserBets, 6);
+    public_function(GetContractStats, 7);
+    public_function(PlaceOrder, 8);
+    public_function(CancelOrder, 9);
+    public_function(GetBestBidAsk, 10);
+    public_function(EnableMarketMaker, 11);
+    public_function(QuoteBet, 12);
+    public_function(ConfigureShard, 13);
+    public_function(ShardTransferOut, 14);
+    public_function(ShardTransferIn, 15);
+    public_function(ResolveEvents, 16);
+    public_function(GetLeaderboard, 17);
+    public_function(GetUserSummary, 18);
+    public_function(GetOutcomeTally, 19);
+    public_function(UnregisterUser, 20);
+    public_function(SetMaxOpenStake, 21);
     
     // Procedure declarations
     public_procedure(Initialize, 0);
@@ -183,6 +647,21 @@ BEGIN_CONTRACT(PredictoR)
         REGISTER_USER_FUNCTION(GetBalance, 4);
         REGISTER_USER_FUNCTION(GetEvents, 5);
         REGISTER_USER_FUNCTION(GetUserBets, 6);
+        REGISTER_USER_FUNCTION(GetContractStats, 7);
+        REGISTER_USER_FUNCTION(PlaceOrder, 8);
+        REGISTER_USER_FUNCTION(CancelOrder, 9);
+        REGISTER_USER_FUNCTION(GetBestBidAsk, 10);
+        REGISTER_USER_FUNCTION(EnableMarketMaker, 11);
+        REGISTER_USER_FUNCTION(QuoteBet, 12);
+        REGISTER_USER_FUNCTION(ConfigureShard, 13);
+        REGISTER_USER_FUNCTION(ShardTransferOut, 14);
+        REGISTER_USER_FUNCTION(ShardTransferIn, 15);
+        REGISTER_USER_FUNCTION(ResolveEvents, 16);
+        REGISTER_USER_FUNCTION(GetLeaderboard, 17);
+        REGISTER_USER_FUNCTION(GetUserSummary, 18);
+        REGISTER_USER_FUNCTION(GetOutcomeTally, 19);
+        REGISTER_USER_FUNCTION(UnregisterUser, 20);
+        REGISTER_USER_FUNCTION(SetMaxOpenStake, 21);
         REGISTER_USER_PROCEDURE(Initialize, 0);
     END_REGISTER_USER_FUNCTIONS_AND_PROCEDURES
 
@@ -193,6 +672,7 @@ BEGIN_CONTRACT(PredictoR)
         state.defaultBalance = DEFAULT_BALANCE;
         state.betCost = BET_COST;
         state.winReward = WIN_REWARD;
+        state.maxOpenStake = MAX_OPEN_STAKE;
         state.contractActive = 1;
         
         // Initialize counters
@@ -206,6 +686,23 @@ BEGIN_CONTRACT(PredictoR)
         state.totalBets = 0;
         state.totalVolume = 0;
         
+        // Reset performance counters
+        for (state.tempIndex = 0; state.tempIndex < STAT_PROCEDURE_COUNT; state.tempIndex++) {
+            state.invocationCount[state.tempIndex] = 0;
+            state.elementsScanned[state.tempIndex] = 0;
+            state.lastElementsScanned[state.tempIndex] = 0;
+        }
+        for (state.tempIndex = 0; state.tempIndex < REJECT_REASON_COUNT; state.tempIndex++) {
+            state.rejectionCount[state.tempIndex] = 0;
+        }
+        state.settlementBacklog = 0;
+        
+        // Unsharded until ConfigureShard
+        state.shardIndex = 0;
+        state.shardCount = 1;
+        state.transferredOut = 0;
+        state.transferredIn = 0;
+        
         // Set admin
         state.adminId = invocator();
         
@@ -213,13 +710,14 @@ BEGIN_CONTRACT(PredictoR)
         if (state.eventCount == 0) {
             // Event 1
             state.tempEvent.id = 1;
-            copyMem(state.tempEvent.title, "Will Tesla stock reach $300 by end of 2025?", 45);
-            copyMem(state.tempEvent.description, "Predict whether Tesla's stock price will hit $300 per share by December 31, 2025.", 84);
+            copyMem(state.tempEvent.title, "Will Tesla stock reach $300 by end of 2025?", 44);
+            copyMem(state.tempEvent.description, "Predict whether Tesla's stock price will hit $300 per share by December 31, 2025.", 82);
             copyMem(state.tempEvent.category, "Technology", 11);
             state.tempEvent.createdAt = system.tick;
             state.tempEvent.endsAt = system.tick + 604800; // 7 days
             state.tempEvent.isActive = 1;
             state.tempEvent.isResolved = 0;
+            state.tempEvent.outcomeCount = 2;
             state.tempEvent.totalBets = 0;
             state.tempEvent.yesBets = 0;
             state.tempEvent.noBets = 0;
@@ -235,6 +733,7 @@ BEGIN_CONTRACT(PredictoR)
             state.tempEvent.endsAt = system.tick + 1209600; // 14 days
             state.tempEvent.isActive = 1;
             state.tempEvent.isResolved = 0;
+            state.tempEvent.outcomeCount = 2;
             state.tempEvent.totalBets = 0;
             state.tempEvent.yesBets = 0;
             state.tempEvent.noBets = 0;
@@ -250,6 +749,7 @@ BEGIN_CONTRACT(PredictoR)
             state.tempEvent.endsAt = system.tick + 864000; // 10 days
             state.tempEvent.isActive = 1;
             state.tempEvent.isResolved = 0;
+            state.tempEvent.outcomeCount = 2;
             state.tempEvent.totalBets = 0;
             state.tempEvent.yesBets = 0;
             state.tempEvent.noBets = 0;
@@ -265,6 +765,7 @@ BEGIN_CONTRACT(PredictoR)
             state.tempEvent.endsAt = system.tick + 1814400; // 21 days
             state.tempEvent.isActive = 1;
             state.tempEvent.isResolved = 0;
+            state.tempEvent.outcomeCount = 2;
             state.tempEvent.totalBets = 0;
             state.tempEvent.yesBets = 0;
             state.tempEvent.noBets = 0;
@@ -283,6 +784,9 @@ BEGIN_CONTRACT(PredictoR)
             state.tempUser.totalBets = 0;
             state.tempUser.totalWins = 0;
             state.tempUser.isActive = 1;
+            state.tempUser.openBets = 0;
+            state.tempUser.openStake = 0;
+            state.tempUser.realizedPnl = 0;
             state.users[state.userCount] = state.tempUser;
             state.userCount++;
             state.totalUsers = 1;
@@ -300,31 +804,39 @@ BEGIN_CONTRACT(PredictoR)
         output->userId = 0;
         output->balance = 0;
         
+        state.invocationCount[STAT_REGISTER_USER]++;
+        state.lastElementsScanned[STAT_REGISTER_USER] = 0;
+        
         // Check if contract is active
         if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
             return;
         }
         
         // Check if we have space for new user
         if (state.userCount >= MAX_USERS) {
+            state.rejectionCount[REJECT_CAPACITY_FULL]++;
             return;
         }
         
-        // Create new user
+        // Create new user; only the home shard grants the starting balance
         state.tempUser.id = state.userCount + 1;
         copyMem(state.tempUser.username, input->username, 32);
         copyMem(state.tempUser.passwordHash, input->passwordHash, 32);
-        state.tempUser.balance = state.defaultBalance;
+        state.tempUser.balance = state.userCount % state.shardCount == state.shardIndex ? state.defaultBalance : 0;
         state.tempUser.totalBets = 0;
         state.tempUser.totalWins = 0;
         state.tempUser.isActive = 1;
+        state.tempUser.openBets = 0;
+        state.tempUser.openStake = 0;
+        state.tempUser.realizedPnl = 0;
         
         // Add user to array
         state.users[state.userCount] = state.tempUser;
         
         // Set output
         output->userId = state.tempUser.id;
-        output->balance = state.defaultBalance;
+        output->balance = state.tempUser.balance;
         output->success = 1;
         
         // Update counters
@@ -332,6 +844,48 @@ BEGIN_CONTRACT(PredictoR)
         state.totalUsers++;
     }
 
+    // Remove the latest user again. Only a user nobody has acted for yet can
+    // go: no bets and the starting balance untouched, so no orders or
+    // positions either.
+    PUBLIC(UnregisterUser)
+    {
+        UnregisterUserInput* input = (UnregisterUserInput*)inputBuffer;
+        UnregisterUserOutput* output = (UnregisterUserOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        
+        state.invocationCount[STAT_UNREGISTER_USER]++;
+        state.lastElementsScanned[STAT_UNREGISTER_USER] = 0;
+        
+        // Only admin withdraws registrations
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        if (input->userId == 0 || input->userId != state.userCount || state.users[input->userId - 1].id != input->userId) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        state.tempUserId = input->userId - 1;
+        state.tempAmount = state.tempUserId % state.shardCount == state.shardIndex ? state.defaultBalance : 0;
+        if (state.users[state.tempUserId].totalBets || state.users[state.tempUserId].openBets
+            || state.users[state.tempUserId].realizedPnl || state.users[state.tempUserId].balance != state.tempAmount) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        state.users[state.tempUserId].id = 0;
+        state.users[state.tempUserId].isActive = 0;
+        state.users[state.tempUserId].balance = 0;
+        state.userCount--;
+        state.totalUsers--;
+        
+        output->success = 1;
+    }
+
     // Create new event
     PUBLIC(CreateEvent)
     {
@@ -342,18 +896,30 @@ BEGIN_CONTRACT(PredictoR)
         output->success = 0;
         output->eventId = 0;
         
+        state.invocationCount[STAT_CREATE_EVENT]++;
+        state.lastElementsScanned[STAT_CREATE_EVENT] = 0;
+        
         // Check if contract is active
         if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
             return;
         }
         
         // Check if we have space for new event
         if (state.eventCount >= MAX_EVENTS) {
+            state.rejectionCount[REJECT_CAPACITY_FULL]++;
             return;
         }
         
         // Only admin can create events for now
         if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        // A market needs at least two outcomes
+        if (input->outcomeCount == 1 || input->outcomeCount > MAX_OUTCOMES) {
+            state.rejectionCount[REJECT_INVALID_OUTCOME]++;
             return;
         }
         
@@ -367,12 +933,18 @@ BEGIN_CONTRACT(PredictoR)
         state.tempEvent.isActive = 1;
         state.tempEvent.isResolved = 0;
         state.tempEvent.correctAnswer = 0;
+        state.tempEvent.outcomeCount = input->outcomeCount ? input->outcomeCount : 2;
         state.tempEvent.totalBets = 0;
         state.tempEvent.yesBets = 0;
         state.tempEvent.noBets = 0;
         
         // Add event to array
         state.events[state.eventCount] = state.tempEvent;
+        if (state.tempEvent.outcomeCount > 2) {
+            for (state.tempIndex = 0; state.tempIndex < MAX_OUTCOMES; state.tempIndex++) {
+                state.tallies[state.eventCount].bets[state.tempIndex] = 0;
+            }
+        }
         
         // Set output
         output->eventId = state.tempEvent.id;
@@ -394,52 +966,85 @@ BEGIN_CONTRACT(PredictoR)
         output->betId = 0;
         output->newBalance = 0;
         
+        state.invocationCount[STAT_PLACE_BET]++;
+        state.lastElementsScanned[STAT_PLACE_BET] = 0;
+        
         // Check if contract is active
         if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
             return;
         }
         
         // Check if we have space for new bet
         if (state.betCount >= MAX_BETS) {
+            state.rejectionCount[REJECT_CAPACITY_FULL]++;
             return;
         }
         
-        // Find user
-        state.tempUserId = 0;
-        for (state.tempIndex = 0; state.tempIndex < state.userCount; state.tempIndex++) {
-            if (state.users[state.tempIndex].id == input->userId) {
-                state.tempUserId = state.tempIndex;
-                state.tempUser = state.users[state.tempIndex];
-                break;
-            }
+        // Find user (user ids are slot + 1)
+        if (input->userId == 0 || input->userId > state.userCount || state.users[input->userId - 1].id != input->userId) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
         }
+        state.tempUserId = input->userId - 1;
+        state.tempUser = state.users[state.tempUserId];
         
-        if (state.tempUserId == 0 && state.users[0].id != input->userId) {
-            return; // User not found
+        // Find event (event ids are slot + 1)
+        if (input->eventId == 0 || input->eventId > state.eventCount || state.events[input->eventId - 1].id != input->eventId) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
         }
+        state.tempEventId = input->eventId - 1;
+        state.tempEvent = state.events[state.tempEventId];
         
-        // Check user balance
-        if (state.tempUser.balance < input->amount) {
-            return; // Insufficient balance
+        // Check if event is active
+        if (!state.tempEvent.isActive || state.tempEvent.isResolved) {
+            state.rejectionCount[REJECT_EVENT_CLOSED]++;
+            return; // Event not available for betting
         }
         
-        // Find event
-        state.tempEventId = 0;
-        for (state.tempIndex = 0; state.tempIndex < state.eventCount; state.tempIndex++) {
-            if (state.events[state.tempIndex].id == input->eventId) {
-                state.tempEventId = state.tempIndex;
-                state.tempEvent = state.events[state.tempIndex];
-                break;
+        // Binary bets predict 0 (NO) or 1 (YES); other markets name an outcome
+        if (input->prediction >= state.tempEvent.outcomeCount) {
+            state.rejectionCount[REJECT_INVALID_OUTCOME]++;
+            return;
+        }
+        
+        // Price the bet: the flat amount, or with a market maker the LMSR
+        // cost of `amount` shares, quoted in constant time
+        if (state.makers[state.tempEventId].isEnabled) {
+            if (input->amount == 0 || input->amount > LMSR_MAX_TRADE) {
+                state.rejectionCount[REJECT_INVALID_ORDER]++;
+                return;
             }
+            state.tempLmsrShares = input->amount;
+            state.tempLmsrPrediction = input->prediction;
+            CALL(LmsrQuote);
+        } else {
+            state.tempCost = input->amount;
         }
         
-        if (state.tempEventId == 0 && state.events[0].id != input->eventId) {
-            return; // Event not found
+        // Check user balance
+        if (state.tempUser.balance < state.tempCost) {
+            state.rejectionCount[REJECT_INSUFFICIENT_BALANCE]++;
+            return; // Insufficient balance
         }
         
-        // Check if event is active
-        if (!state.tempEvent.isActive || state.tempEvent.isResolved) {
-            return; // Event not available for betting
+        // Risk limit on the stake the user has riding on unsettled flat bets
+        if (!state.makers[state.tempEventId].isEnabled && state.maxOpenStake
+            && state.tempUser.openStake + state.tempCost > state.maxOpenStake) {
+            state.rejectionCount[REJECT_EXPOSURE_LIMIT]++;
+            return;
+        }
+        
+        // Market maker shares are held as a position and paid by ResolveEvent
+        if (state.makers[state.tempEventId].isEnabled) {
+            state.tempPositionUserId = input->userId;
+            state.tempPositionEventId = input->eventId;
+            CALL(FindPosition);
+            if (state.tempPositionSlot == MAX_POSITIONS) {
+                state.rejectionCount[REJECT_CAPACITY_FULL]++;
+                return;
+            }
         }
         
         // Create bet
@@ -447,22 +1052,43 @@ BEGIN_CONTRACT(PredictoR)
         state.tempBet.userId = input->userId;
         state.tempBet.eventId = input->eventId;
         state.tempBet.prediction = input->prediction;
-        state.tempBet.amount = input->amount;
+        state.tempBet.amount = (uint32)state.tempCost;
         state.tempBet.createdAt = system.tick;
         state.tempBet.isWon = 0;
-        state.tempBet.isProcessed = 0;
+        state.tempBet.isProcessed = state.makers[state.tempEventId].isEnabled;
         
         // Add bet to array
         state.bets[state.betCount] = state.tempBet;
         
         // Update user balance
-        state.tempUser.balance = state.tempUser.balance - input->amount;
+        state.tempUser.balance = state.tempUser.balance - (uint32)state.tempCost;
         state.tempUser.totalBets++;
+        if (!state.makers[state.tempEventId].isEnabled) {
+            state.tempUser.openBets++;
+            state.tempUser.openStake += state.tempCost;
+        }
         state.users[state.tempUserId] = state.tempUser;
         
+        // Sell the shares; SettlePosition may redeem YES/NO pairs into the balance
+        if (state.makers[state.tempEventId].isEnabled) {
+            state.makers[state.tempEventId].collected += state.tempCost;
+            state.tempYesShares = 0;
+            state.tempNoShares = 0;
+            if (input->prediction == 1) {
+                state.makers[state.tempEventId].yesShares += input->amount;
+                state.tempYesShares = input->amount;
+            } else {
+                state.makers[state.tempEventId].noShares += input->amount;
+                state.tempNoShares = input->amount;
+            }
+            CALL(SettlePosition);
+        }
+        
         // Update event stats
         state.tempEvent.totalBets++;
-        if (input->prediction == 1) {
+        if (state.tempEvent.outcomeCount > 2) {
+            state.tallies[state.tempEventId].bets[input->prediction]++;
+        } else if (input->prediction == 1) {
             state.tempEvent.yesBets++;
         } else {
             state.tempEvent.noBets++;
@@ -471,13 +1097,16 @@ BEGIN_CONTRACT(PredictoR)
         
         // Set output
         output->betId = state.tempBet.id;
-        output->newBalance = state.tempUser.balance;
+        output->newBalance = state.users[state.tempUserId].balance;
         output->success = 1;
         
         // Update counters
         state.betCount++;
         state.totalBets++;
-        state.totalVolume = state.totalVolume + input->amount;
+        state.totalVolume = state.totalVolume + (uint32)state.tempCost;
+        if (!state.makers[state.tempEventId].isEnabled) {
+            state.settlementBacklog++;
+        }
     }
 
     // Resolve event and process bets
@@ -491,19 +1120,25 @@ BEGIN_CONTRACT(PredictoR)
         output->winnersCount = 0;
         output->totalPayout = 0;
         
+        state.invocationCount[STAT_RESOLVE_EVENT]++;
+        state.lastElementsScanned[STAT_RESOLVE_EVENT] = 0;
+        
         // Check if contract is active
         if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
             return;
         }
         
         // Only admin can resolve events (for now)
         if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
             return;
         }
         
         // Find event
         state.tempEventId = 0;
         for (state.tempIndex = 0; state.tempIndex < state.eventCount; state.tempIndex++) {
+            state.lastElementsScanned[STAT_RESOLVE_EVENT]++;
             if (state.events[state.tempIndex].id == input->eventId) {
                 state.tempEventId = state.tempIndex;
                 state.tempEvent = state.events[state.tempIndex];
@@ -512,14 +1147,24 @@ BEGIN_CONTRACT(PredictoR)
         }
         
         if (state.tempEventId == 0 && state.events[0].id != input->eventId) {
+            state.elementsScanned[STAT_RESOLVE_EVENT] += state.lastElementsScanned[STAT_RESOLVE_EVENT];
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
             return; // Event not found
         }
         
         // Check if event can be resolved
         if (!state.tempEvent.isActive || state.tempEvent.isResolved) {
+            state.elementsScanned[STAT_RESOLVE_EVENT] += state.lastElementsScanned[STAT_RESOLVE_EVENT];
+            state.rejectionCount[REJECT_EVENT_CLOSED]++;
             return; // Event already resolved
         }
         
+        if (input->correctAnswer >= state.tempEvent.outcomeCount) {
+            state.elementsScanned[STAT_RESOLVE_EVENT] += state.lastElementsScanned[STAT_RESOLVE_EVENT];
+            state.rejectionCount[REJECT_INVALID_OUTCOME]++;
+            return;
+        }
+        
         // Mark event as resolved
         state.tempEvent.isResolved = 1;
         state.tempEvent.isActive = 0;
@@ -531,6 +1176,7 @@ BEGIN_CONTRACT(PredictoR)
         state.tempAmount = 0;
         
         for (state.tempIndex = 0; state.tempIndex < state.betCount; state.tempIndex++) {
+            state.lastElementsScanned[STAT_RESOLVE_EVENT]++;
             state.tempBet = state.bets[state.tempIndex];
             
             if (state.tempBet.eventId == input->eventId && !state.tempBet.isProcessed) {
@@ -542,9 +1188,12 @@ BEGIN_CONTRACT(PredictoR)
                     
                     // Find user and update balance
                     for (state.tempUserId = 0; state.tempUserId < state.userCount; state.tempUserId++) {
+                        state.lastElementsScanned[STAT_RESOLVE_EVENT]++;
                         if (state.users[state.tempUserId].id == state.tempBet.userId) {
                             state.users[state.tempUserId].balance = state.users[state.tempUserId].balance + state.winReward;
                             state.users[state.tempUserId].totalWins++;
+                            state.tempLeaderSlot = state.tempUserId;
+                            CALL(UpdateLeaderboard);
                             break;
                         }
                     }
@@ -552,55 +1201,314 @@ BEGIN_CONTRACT(PredictoR)
                     state.tempBet.isWon = 0;
                 }
                 
+                // Move the stake from open to realized; user ids are slot + 1
+                state.users[state.tempBet.userId - 1].openBets--;
+                state.users[state.tempBet.userId - 1].openStake -= state.tempBet.amount;
+                state.users[state.tempBet.userId - 1].realizedPnl += (sint64)(state.tempBet.isWon ? state.winReward : 0) - state.tempBet.amount;
+                
                 state.tempBet.isProcessed = 1;
                 state.bets[state.tempIndex] = state.tempBet;
+                state.settlementBacklog--;
             }
         }
         
+        // Close the order book and pay out its positions
+        state.tempResult = input->correctAnswer;
+        state.tempScanned = 0;
+        CALL(CloseEventBook);
+        state.lastElementsScanned[STAT_RESOLVE_EVENT] += state.tempScanned;
+        state.elementsScanned[STAT_RESOLVE_EVENT] += state.lastElementsScanned[STAT_RESOLVE_EVENT];
+        
         // Set output
         output->winnersCount = state.tempCount;
         output->totalPayout = state.tempAmount;
         output->success = 1;
     }
 
-    // Get user balance
-    PUBLIC(GetBalance)
+    // Resolve up to MAX_RESOLVE_BATCH events with one pass over the bets.
+    // resolveBatchEntry maps each event being resolved to its entry, so a
+    // bet finds its outcome and counters without searching the batch.
+    PUBLIC(ResolveEvents)
     {
-        GetBalanceInput* input = (GetBalanceInput*)inputBuffer;
-        GetBalanceOutput* output = (GetBalanceOutput*)outputBuffer;
+        ResolveEventsInput* input = (ResolveEventsInput*)inputBuffer;
+        ResolveEventsOutput* output = (ResolveEventsOutput*)outputBuffer;
         
         // Initialize output
+        for (state.tempBatchIndex = 0; state.tempBatchIndex < MAX_RESOLVE_BATCH; state.tempBatchIndex++) {
+            output->winnersCount[state.tempBatchIndex] = 0;
+            output->totalPayout[state.tempBatchIndex] = 0;
+            output->resolved[state.tempBatchIndex] = 0;
+        }
+        output->resolvedCount = 0;
         output->success = 0;
-        output->balance = 0;
         
-        // Find user
-        for (state.tempIndex = 0; state.tempIndex < state.userCount; state.tempIndex++) {
-            if (state.users[state.tempIndex].id == input->userId) {
-                output->balance = state.users[state.tempIndex].balance;
-                output->success = 1;
-                return;
-            }
+        state.invocationCount[STAT_RESOLVE_EVENTS]++;
+        state.lastElementsScanned[STAT_RESOLVE_EVENTS] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
         }
-    }
-
-    // Get events list
-    PUBLIC(GetEvents)
-    {
-        GetEventsInput* input = (GetEventsInput*)inputBuffer;
-        GetEventsOutput* output = (GetEventsOutput*)outputBuffer;
         
-        // Initialize output
-        output->success = 0;
-        output->eventCount = 0;
+        // Only admin can resolve events (for now)
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
         
-        // Count active events
-        state.tempCount = 0;
+        if (input->count == 0 || input->count > MAX_RESOLVE_BATCH) {
+            state.rejectionCount[REJECT_INVALID_BATCH]++;
+            return;
+        }
+        
+        // Mark events resolved and close their order books. A repeated event
+        // is already resolved when its second entry is reached.
+        for (state.tempBatchIndex = 0; state.tempBatchIndex < input->count; state.tempBatchIndex++) {
+            state.tempEventId = input->eventIds[state.tempBatchIndex];
+            if (state.tempEventId == 0 || state.tempEventId > state.eventCount || state.events[state.tempEventId - 1].id != state.tempEventId) {
+                state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+                continue;
+            }
+            
+            state.tempEventId--;
+            if (!state.events[state.tempEventId].isActive || state.events[state.tempEventId].isResolved) {
+                state.rejectionCount[REJECT_EVENT_CLOSED]++;
+                continue;
+            }
+            if (input->correctAnswers[state.tempBatchIndex] >= state.events[state.tempEventId].outcomeCount) {
+                state.rejectionCount[REJECT_INVALID_OUTCOME]++;
+                continue;
+            }
+            
+            state.events[state.tempEventId].isResolved = 1;
+            state.events[state.tempEventId].isActive = 0;
+            state.events[state.tempEventId].correctAnswer = input->correctAnswers[state.tempBatchIndex];
+            state.resolveBatchEntry[state.tempEventId] = (uint8)(state.tempBatchIndex + 1);
+            
+            state.tempResult = input->correctAnswers[state.tempBatchIndex];
+            state.tempCount = 0;
+            state.tempAmount = 0;
+            state.tempScanned = 0;
+            CALL(CloseEventBook);
+            state.lastElementsScanned[STAT_RESOLVE_EVENTS] += state.tempScanned;
+            
+            output->winnersCount[state.tempBatchIndex] = state.tempCount;
+            output->totalPayout[state.tempBatchIndex] = state.tempAmount;
+            output->resolved[state.tempBatchIndex] = 1;
+            output->resolvedCount++;
+        }
+        
+        // Settle flat bets of every resolved event in one pass
+        if (output->resolvedCount) {
+            for (state.tempIndex = 0; state.tempIndex < state.betCount; state.tempIndex++) {
+                state.lastElementsScanned[STAT_RESOLVE_EVENTS]++;
+                if (state.bets[state.tempIndex].isProcessed) {
+                    continue;
+                }
+                
+                state.tempBatchIndex = state.resolveBatchEntry[state.bets[state.tempIndex].eventId - 1];
+                if (!state.tempBatchIndex) {
+                    continue;
+                }
+                state.tempBatchIndex--;
+                
+                if (state.bets[state.tempIndex].prediction == input->correctAnswers[state.tempBatchIndex]) {
+                    state.bets[state.tempIndex].isWon = 1;
+                    state.users[state.bets[state.tempIndex].userId - 1].balance += state.winReward;
+                    state.users[state.bets[state.tempIndex].userId - 1].totalWins++;
+                    state.tempLeaderSlot = state.bets[state.tempIndex].userId - 1;
+                    CALL(UpdateLeaderboard);
+                    output->winnersCount[state.tempBatchIndex]++;
+                    output->totalPayout[state.tempBatchIndex] += state.winReward;
+                } else {
+                    state.bets[state.tempIndex].isWon = 0;
+                }
+                
+                state.users[state.bets[state.tempIndex].userId - 1].openBets--;
+                state.users[state.bets[state.tempIndex].userId - 1].openStake -= state.bets[state.tempIndex].amount;
+                state.users[state.bets[state.tempIndex].userId - 1].realizedPnl +=
+                    (sint64)(state.bets[state.tempIndex].isWon ? state.winReward : 0) - state.bets[state.tempIndex].amount;
+                
+                state.bets[state.tempIndex].isProcessed = 1;
+                state.settlementBacklog--;
+            }
+        }
+        
+        // Clear the lookup table for the next batch
+        for (state.tempBatchIndex = 0; state.tempBatchIndex < input->count; state.tempBatchIndex++) {
+            state.tempEventId = input->eventIds[state.tempBatchIndex];
+            if (state.tempEventId != 0 && state.tempEventId <= state.eventCount) {
+                state.resolveBatchEntry[state.tempEventId - 1] = 0;
+            }
+        }
+        
+        state.elementsScanned[STAT_RESOLVE_EVENTS] += state.lastElementsScanned[STAT_RESOLVE_EVENTS];
+        output->success = output->resolvedCount > 0;
+    }
+
+    // Top users by totalWins, read straight from the maintained leaderboard
+    PUBLIC(GetLeaderboard)
+    {
+        GetLeaderboardInput* input = (GetLeaderboardInput*)inputBuffer;
+        GetLeaderboardOutput* output = (GetLeaderboardOutput*)outputBuffer;
+        
+        // Initialize output
+        for (state.tempIndex = 0; state.tempIndex < LEADERBOARD_SIZE; state.tempIndex++) {
+            output->userIds[state.tempIndex] = 0;
+            output->totalWins[state.tempIndex] = 0;
+            output->totalBets[state.tempIndex] = 0;
+            output->balances[state.tempIndex] = 0;
+        }
+        output->count = 0;
+        output->success = 0;
+        
+        state.invocationCount[STAT_GET_LEADERBOARD]++;
+        state.lastElementsScanned[STAT_GET_LEADERBOARD] = 0;
+        
+        output->count = input->count < state.leaderboardCount ? input->count : state.leaderboardCount;
+        for (state.tempIndex = 0; state.tempIndex < output->count; state.tempIndex++) {
+            state.tempLeaderSlot = state.leaderboard[state.tempIndex];
+            output->userIds[state.tempIndex] = state.users[state.tempLeaderSlot].id;
+            output->totalWins[state.tempIndex] = state.users[state.tempLeaderSlot].totalWins;
+            output->totalBets[state.tempIndex] = state.users[state.tempLeaderSlot].totalBets;
+            output->balances[state.tempIndex] = state.users[state.tempLeaderSlot].balance;
+        }
+        
+        state.lastElementsScanned[STAT_GET_LEADERBOARD] = output->count;
+        state.elementsScanned[STAT_GET_LEADERBOARD] += output->count;
+        output->success = 1;
+    }
+
+    // Open stake, realized P&L and counters of one user, in constant time
+    PUBLIC(GetUserSummary)
+    {
+        GetUserSummaryInput* input = (GetUserSummaryInput*)inputBuffer;
+        GetUserSummaryOutput* output = (GetUserSummaryOutput*)outputBuffer;
+        
+        // Initialize output
+        output->openStake = 0;
+        output->realizedPnl = 0;
+        output->balance = 0;
+        output->totalBets = 0;
+        output->totalWins = 0;
+        output->openBets = 0;
+        output->success = 0;
+        
+        state.invocationCount[STAT_GET_USER_SUMMARY]++;
+        state.lastElementsScanned[STAT_GET_USER_SUMMARY] = 0;
+        
+        // User ids are slot + 1
+        if (input->userId == 0 || input->userId > state.userCount) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        state.tempUserId = input->userId - 1;
+        output->openStake = state.users[state.tempUserId].openStake;
+        output->realizedPnl = state.users[state.tempUserId].realizedPnl;
+        output->balance = state.users[state.tempUserId].balance;
+        output->totalBets = state.users[state.tempUserId].totalBets;
+        output->totalWins = state.users[state.tempUserId].totalWins;
+        output->openBets = state.users[state.tempUserId].openBets;
+        output->success = 1;
+    }
+
+    // Bets per outcome of one event, in constant time
+    PUBLIC(GetOutcomeTally)
+    {
+        GetOutcomeTallyInput* input = (GetOutcomeTallyInput*)inputBuffer;
+        GetOutcomeTallyOutput* output = (GetOutcomeTallyOutput*)outputBuffer;
+        
+        // Initialize output
+        for (state.tempIndex = 0; state.tempIndex < MAX_OUTCOMES; state.tempIndex++) {
+            output->bets[state.tempIndex] = 0;
+        }
+        output->outcomeCount = 0;
+        output->isResolved = 0;
+        output->correctAnswer = 0;
+        output->hasMarketMaker = 0;
+        output->success = 0;
+        
+        state.invocationCount[STAT_GET_OUTCOME_TALLY]++;
+        state.lastElementsScanned[STAT_GET_OUTCOME_TALLY] = 0;
+        
+        // Event ids are slot + 1
+        if (input->eventId == 0 || input->eventId > state.eventCount) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
+        }
+        
+        state.tempEventId = input->eventId - 1;
+        state.tempEvent = state.events[state.tempEventId];
+        if (state.tempEvent.outcomeCount > 2) {
+            for (state.tempIndex = 0; state.tempIndex < state.tempEvent.outcomeCount; state.tempIndex++) {
+                output->bets[state.tempIndex] = state.tallies[state.tempEventId].bets[state.tempIndex];
+            }
+        } else {
+            output->bets[0] = state.tempEvent.noBets;
+            output->bets[1] = state.tempEvent.yesBets;
+        }
+        output->outcomeCount = state.tempEvent.outcomeCount;
+        output->isResolved = state.tempEvent.isResolved;
+        output->correctAnswer = state.tempEvent.correctAnswer;
+        output->hasMarketMaker = state.makers[state.tempEventId].isEnabled;
+        output->success = 1;
+    }
+
+    // Get user balance
+    PUBLIC(GetBalance)
+    {
+        GetBalanceInput* input = (GetBalanceInput*)inputBuffer;
+        GetBalanceOutput* output = (GetBalanceOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->balance = 0;
+        
+        state.invocationCount[STAT_GET_BALANCE]++;
+        state.lastElementsScanned[STAT_GET_BALANCE] = 0;
+        
+        // Find user
+        for (state.tempIndex = 0; state.tempIndex < state.userCount; state.tempIndex++) {
+            state.lastElementsScanned[STAT_GET_BALANCE]++;
+            if (state.users[state.tempIndex].id == input->userId) {
+                output->balance = state.users[state.tempIndex].balance;
+                output->success = 1;
+                break;
+            }
+        }
+        
+        state.elementsScanned[STAT_GET_BALANCE] += state.lastElementsScanned[STAT_GET_BALANCE];
+        
+        if (!output->success) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+        }
+    }
+
+    // Get events list
+    PUBLIC(GetEvents)
+    {
+        GetEventsInput* input = (GetEventsInput*)inputBuffer;
+        GetEventsOutput* output = (GetEventsOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->eventCount = 0;
+        
+        state.invocationCount[STAT_GET_EVENTS]++;
+        
+        // Count active events
+        state.tempCount = 0;
         for (state.tempIndex = 0; state.tempIndex < state.eventCount; state.tempIndex++) {
             if (state.events[state.tempIndex].isActive) {
                 state.tempCount++;
             }
         }
         
+        state.lastElementsScanned[STAT_GET_EVENTS] = state.eventCount;
+        state.elementsScanned[STAT_GET_EVENTS] += state.eventCount;
+        
         output->eventCount = state.tempCount;
         output->success = 1;
         
@@ -618,6 +1526,8 @@ BEGIN_CONTRACT(PredictoR)
         output->success = 0;
         output->balance = 0;  // Using as bet count
         
+        state.invocationCount[STAT_GET_USER_BETS]++;
+        
         // Count user's bets
         state.tempCount = 0;
         for (state.tempIndex = 0; state.tempIndex < state.betCount; state.tempIndex++) {
@@ -626,10 +1536,913 @@ BEGIN_CONTRACT(PredictoR)
             }
         }
         
+        state.lastElementsScanned[STAT_GET_USER_BETS] = state.betCount;
+        state.elementsScanned[STAT_GET_USER_BETS] += state.betCount;
+        
         output->balance = state.tempCount;  // Using balance field for bet count
         output->success = 1;
     }
 
+    // Get performance counters
+    PUBLIC(GetContractStats)
+    {
+        GetContractStatsOutput* output = (GetContractStatsOutput*)outputBuffer;
+        
+        state.invocationCount[STAT_GET_CONTRACT_STATS]++;
+        state.lastElementsScanned[STAT_GET_CONTRACT_STATS] = 0;
+        
+        for (state.tempIndex = 0; state.tempIndex < STAT_PROCEDURE_COUNT; state.tempIndex++) {
+            output->invocationCount[state.tempIndex] = state.invocationCount[state.tempIndex];
+            output->elementsScanned[state.tempIndex] = state.elementsScanned[state.tempIndex];
+            output->lastElementsScanned[state.tempIndex] = state.lastElementsScanned[state.tempIndex];
+        }
+        for (state.tempIndex = 0; state.tempIndex < REJECT_REASON_COUNT; state.tempIndex++) {
+            output->rejectionCount[state.tempIndex] = state.rejectionCount[state.tempIndex];
+        }
+        
+        output->settlementBacklog = state.settlementBacklog;
+        output->userCount = state.userCount;
+        output->eventCount = state.eventCount;
+        output->betCount = state.betCount;
+        output->totalVolume = state.totalVolume;
+        output->success = 1;
+    }
+
+    // Place a limit order for YES shares; matches first, then rests the remainder
+    PUBLIC(PlaceOrder)
+    {
+        PlaceOrderInput* input = (PlaceOrderInput*)inputBuffer;
+        PlaceOrderOutput* output = (PlaceOrderOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->orderId = 0;
+        output->filledQuantity = 0;
+        output->restingQuantity = 0;
+        output->fillCost = 0;
+        output->newBalance = 0;
+        
+        state.invocationCount[STAT_PLACE_ORDER]++;
+        state.lastElementsScanned[STAT_PLACE_ORDER] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
+        }
+        
+        // Check order parameters
+        if (input->quantity == 0 || input->price == 0 || input->price > ORDER_PRICE_LEVELS || input->side > ORDER_SIDE_SELL) {
+            state.rejectionCount[REJECT_INVALID_ORDER]++;
+            return;
+        }
+        
+        // Find user (user ids are slot + 1)
+        if (input->userId == 0 || input->userId > state.userCount || state.users[input->userId - 1].id != input->userId) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        // Find event (event ids are slot + 1)
+        if (input->eventId == 0 || input->eventId > state.eventCount || state.events[input->eventId - 1].id != input->eventId) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
+        }
+        
+        if (!state.events[input->eventId - 1].isActive || state.events[input->eventId - 1].isResolved) {
+            state.rejectionCount[REJECT_EVENT_CLOSED]++;
+            return;
+        }
+        
+        // YES / NO shares only price binary markets
+        if (state.events[input->eventId - 1].outcomeCount != 2) {
+            state.rejectionCount[REJECT_INVALID_OUTCOME]++;
+            return;
+        }
+        
+        // Lock the most the order can cost: price per YES share bought,
+        // payout - price per NO share bought by an ask
+        if (input->side == ORDER_SIDE_BUY) {
+            state.tempCost = (uint64)input->price * input->quantity;
+        } else {
+            state.tempCost = (uint64)(ORDER_SHARE_PAYOUT - input->price) * input->quantity;
+        }
+        
+        if (state.users[input->userId - 1].balance < state.tempCost) {
+            state.rejectionCount[REJECT_INSUFFICIENT_BALANCE]++;
+            return;
+        }
+        
+        // Keep a slot available in case part of the order rests
+        if (state.orderFreeHead == 0 && state.orderHighWater >= MAX_ORDERS) {
+            state.rejectionCount[REJECT_CAPACITY_FULL]++;
+            return;
+        }
+        
+        // Create the taker position up front so fills cannot fail halfway
+        state.tempPositionUserId = input->userId;
+        state.tempPositionEventId = input->eventId;
+        CALL(FindPosition);
+        if (state.tempPositionSlot == MAX_POSITIONS) {
+            state.rejectionCount[REJECT_CAPACITY_FULL]++;
+            return;
+        }
+        state.tempTakerPositionSlot = state.tempPositionSlot;
+        
+        state.users[input->userId - 1].balance -= (uint32)state.tempCost;
+        state.tempRemaining = input->quantity;
+        
+        // Match against the best opposite price, oldest order first. Each
+        // iteration fills one maker order, so the cost follows the fills;
+        // ReleaseOrder adds the levels it walks to tempScanned.
+        state.tempScanned = 0;
+        if (input->side == ORDER_SIDE_BUY) {
+            while (state.tempRemaining > 0 && state.books[input->eventId - 1].bestAsk != 0
+                && state.books[input->eventId - 1].bestAsk <= input->price) {
+                state.lastElementsScanned[STAT_PLACE_ORDER]++;
+                state.tempLevel = state.books[input->eventId - 1].bestAsk;
+                state.tempMakerSlot = state.books[input->eventId - 1].askHead[state.tempLevel - 1] - 1;
+                state.tempFill = state.tempRemaining < state.orders[state.tempMakerSlot].quantity ? state.tempRemaining : state.orders[state.tempMakerSlot].quantity;
+                
+                // Trade at the maker's price and refund the difference
+                state.users[input->userId - 1].balance += (input->price - state.tempLevel) * state.tempFill;
+                output->fillCost += state.tempLevel * state.tempFill;
+                
+                // Taker receives YES shares, maker receives NO shares
+                state.tempPositionSlot = state.tempTakerPositionSlot;
+                state.tempYesShares = state.tempFill;
+                state.tempNoShares = 0;
+                CALL(SettlePosition);
+                
+                state.tempPositionUserId = state.orders[state.tempMakerSlot].userId;
+                CALL(FindPosition);
+                state.tempYesShares = 0;
+                state.tempNoShares = state.tempFill;
+                CALL(SettlePosition);
+                
+                state.orders[state.tempMakerSlot].quantity -= state.tempFill;
+                state.books[input->eventId - 1].askQuantity[state.tempLevel - 1] -= state.tempFill;
+                state.tempRemaining -= state.tempFill;
+                state.totalVolume = state.totalVolume + state.tempFill * ORDER_SHARE_PAYOUT;
+                
+                if (state.orders[state.tempMakerSlot].quantity == 0) {
+                    state.tempOrderSlot = state.tempMakerSlot;
+                    CALL(ReleaseOrder);
+                }
+            }
+        } else {
+            while (state.tempRemaining > 0 && state.books[input->eventId - 1].bestBid != 0
+                && state.books[input->eventId - 1].bestBid >= input->price) {
+                state.lastElementsScanned[STAT_PLACE_ORDER]++;
+                state.tempLevel = state.books[input->eventId - 1].bestBid;
+                state.tempMakerSlot = state.books[input->eventId - 1].bidHead[state.tempLevel - 1] - 1;
+                state.tempFill = state.tempRemaining < state.orders[state.tempMakerSlot].quantity ? state.tempRemaining : state.orders[state.tempMakerSlot].quantity;
+                
+                // Trade at the maker's price and refund the difference
+                state.users[input->userId - 1].balance += (state.tempLevel - input->price) * state.tempFill;
+                output->fillCost += (ORDER_SHARE_PAYOUT - state.tempLevel) * state.tempFill;
+                
+                // Taker receives NO shares, maker receives YES shares
+                state.tempPositionSlot = state.tempTakerPositionSlot;
+                state.tempYesShares = 0;
+                state.tempNoShares = state.tempFill;
+                CALL(SettlePosition);
+                
+                state.tempPositionUserId = state.orders[state.tempMakerSlot].userId;
+                CALL(FindPosition);
+                state.tempYesShares = state.tempFill;
+                state.tempNoShares = 0;
+                CALL(SettlePosition);
+                
+                state.orders[state.tempMakerSlot].quantity -= state.tempFill;
+                state.books[input->eventId - 1].bidQuantity[state.tempLevel - 1] -= state.tempFill;
+                state.tempRemaining -= state.tempFill;
+                state.totalVolume = state.totalVolume + state.tempFill * ORDER_SHARE_PAYOUT;
+                
+                if (state.orders[state.tempMakerSlot].quantity == 0) {
+                    state.tempOrderSlot = state.tempMakerSlot;
+                    CALL(ReleaseOrder);
+                }
+            }
+        }
+        state.lastElementsScanned[STAT_PLACE_ORDER] += state.tempScanned;
+        
+        output->filledQuantity = input->quantity - state.tempRemaining;
+        
+        // Rest the remainder at the back of its price level
+        if (state.tempRemaining > 0) {
+            if (state.orderFreeHead) {
+                state.tempOrderSlot = state.orderFreeHead - 1;
+                state.orderFreeHead = state.orders[state.tempOrderSlot].next;
+            } else {
+                state.tempOrderSlot = state.orderHighWater;
+                state.orderHighWater++;
+            }
+            
+            state.orders[state.tempOrderSlot].generation++;
+            if (state.orders[state.tempOrderSlot].generation >= (1u << (32 - ORDER_SLOT_BITS))) {
+                state.orders[state.tempOrderSlot].generation = 1;
+            }
+            state.orders[state.tempOrderSlot].userId = input->userId;
+            state.orders[state.tempOrderSlot].eventId = input->eventId;
+            state.orders[state.tempOrderSlot].quantity = state.tempRemaining;
+            state.orders[state.tempOrderSlot].price = input->price;
+            state.orders[state.tempOrderSlot].side = input->side;
+            state.orders[state.tempOrderSlot].isActive = 1;
+            state.orders[state.tempOrderSlot].next = 0;
+            
+            if (input->side == ORDER_SIDE_BUY) {
+                state.orders[state.tempOrderSlot].prev = state.books[input->eventId - 1].bidTail[input->price - 1];
+                if (state.orders[state.tempOrderSlot].prev) {
+                    state.orders[state.orders[state.tempOrderSlot].prev - 1].next = state.tempOrderSlot + 1;
+                } else {
+                    state.books[input->eventId - 1].bidHead[input->price - 1] = state.tempOrderSlot + 1;
+                }
+                state.books[input->eventId - 1].bidTail[input->price - 1] = state.tempOrderSlot + 1;
+                state.books[input->eventId - 1].bidQuantity[input->price - 1] += state.tempRemaining;
+                if (input->price > state.books[input->eventId - 1].bestBid) {
+                    state.books[input->eventId - 1].bestBid = input->price;
+                }
+            } else {
+                state.orders[state.tempOrderSlot].prev = state.books[input->eventId - 1].askTail[input->price - 1];
+                if (state.orders[state.tempOrderSlot].prev) {
+                    state.orders[state.orders[state.tempOrderSlot].prev - 1].next = state.tempOrderSlot + 1;
+                } else {
+                    state.books[input->eventId - 1].askHead[input->price - 1] = state.tempOrderSlot + 1;
+                }
+                state.books[input->eventId - 1].askTail[input->price - 1] = state.tempOrderSlot + 1;
+                state.books[input->eventId - 1].askQuantity[input->price - 1] += state.tempRemaining;
+                if (state.books[input->eventId - 1].bestAsk == 0 || input->price < state.books[input->eventId - 1].bestAsk) {
+                    state.books[input->eventId - 1].bestAsk = input->price;
+                }
+            }
+            
+            output->orderId = (state.orders[state.tempOrderSlot].generation << ORDER_SLOT_BITS) | state.tempOrderSlot;
+            output->restingQuantity = state.tempRemaining;
+        }
+        
+        state.elementsScanned[STAT_PLACE_ORDER] += state.lastElementsScanned[STAT_PLACE_ORDER];
+        
+        // Set output
+        output->newBalance = state.users[input->userId - 1].balance;
+        output->success = 1;
+    }
+
+    // Cancel a resting order and refund what it still has locked
+    PUBLIC(CancelOrder)
+    {
+        CancelOrderInput* input = (CancelOrderInput*)inputBuffer;
+        CancelOrderOutput* output = (CancelOrderOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->refund = 0;
+        output->newBalance = 0;
+        
+        state.invocationCount[STAT_CANCEL_ORDER]++;
+        state.lastElementsScanned[STAT_CANCEL_ORDER] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
+        }
+        
+        // Find order; the generation must match so a reused slot is not cancelled
+        state.tempOrderSlot = input->orderId & ((1u << ORDER_SLOT_BITS) - 1);
+        if (state.tempOrderSlot >= state.orderHighWater
+            || !state.orders[state.tempOrderSlot].isActive
+            || state.orders[state.tempOrderSlot].generation != (input->orderId >> ORDER_SLOT_BITS)
+            || state.orders[state.tempOrderSlot].userId != input->userId) {
+            state.rejectionCount[REJECT_ORDER_NOT_FOUND]++;
+            return;
+        }
+        
+        // Refund the remaining locked amount
+        if (state.orders[state.tempOrderSlot].side == ORDER_SIDE_BUY) {
+            state.tempRefund = (uint64)state.orders[state.tempOrderSlot].quantity * state.orders[state.tempOrderSlot].price;
+            state.books[state.orders[state.tempOrderSlot].eventId - 1].bidQuantity[state.orders[state.tempOrderSlot].price - 1] -= state.orders[state.tempOrderSlot].quantity;
+        } else {
+            state.tempRefund = (uint64)state.orders[state.tempOrderSlot].quantity * (ORDER_SHARE_PAYOUT - state.orders[state.tempOrderSlot].price);
+            state.books[state.orders[state.tempOrderSlot].eventId - 1].askQuantity[state.orders[state.tempOrderSlot].price - 1] -= state.orders[state.tempOrderSlot].quantity;
+        }
+        state.users[input->userId - 1].balance += (uint32)state.tempRefund;
+        
+        state.tempScanned = 0;
+        CALL(ReleaseOrder);
+        state.lastElementsScanned[STAT_CANCEL_ORDER] += state.tempScanned;
+        state.elementsScanned[STAT_CANCEL_ORDER] += state.lastElementsScanned[STAT_CANCEL_ORDER];
+        
+        // Set output
+        output->refund = (uint32)state.tempRefund;
+        output->newBalance = state.users[input->userId - 1].balance;
+        output->success = 1;
+    }
+
+    // Get the best bid and ask of an event's order book
+    PUBLIC(GetBestBidAsk)
+    {
+        GetBestBidAskInput* input = (GetBestBidAskInput*)inputBuffer;
+        GetBestBidAskOutput* output = (GetBestBidAskOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->bidQuantity = 0;
+        output->askQuantity = 0;
+        output->bestBid = 0;
+        output->bestAsk = 0;
+        
+        state.invocationCount[STAT_GET_BEST_BID_ASK]++;
+        state.lastElementsScanned[STAT_GET_BEST_BID_ASK] = 0;
+        
+        // Find event (event ids are slot + 1)
+        if (input->eventId == 0 || input->eventId > state.eventCount || state.events[input->eventId - 1].id != input->eventId) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
+        }
+        
+        output->bestBid = state.books[input->eventId - 1].bestBid;
+        output->bestAsk = state.books[input->eventId - 1].bestAsk;
+        if (output->bestBid) {
+            output->bidQuantity = state.books[input->eventId - 1].bidQuantity[output->bestBid - 1];
+        }
+        if (output->bestAsk) {
+            output->askQuantity = state.books[input->eventId - 1].askQuantity[output->bestAsk - 1];
+        }
+        output->success = 1;
+    }
+
+    // Attach an LMSR market maker to an event; PlaceBet then buys shares from it
+    PUBLIC(EnableMarketMaker)
+    {
+        EnableMarketMakerInput* input = (EnableMarketMakerInput*)inputBuffer;
+        EnableMarketMakerOutput* output = (EnableMarketMakerOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        
+        state.invocationCount[STAT_ENABLE_MARKET_MAKER]++;
+        state.lastElementsScanned[STAT_ENABLE_MARKET_MAKER] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
+        }
+        
+        // Only admin can fund market makers
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        // Find event (event ids are slot + 1)
+        if (input->eventId == 0 || input->eventId > state.eventCount || state.events[input->eventId - 1].id != input->eventId) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
+        }
+        
+        if (!state.events[input->eventId - 1].isActive || state.events[input->eventId - 1].isResolved) {
+            state.rejectionCount[REJECT_EVENT_CLOSED]++;
+            return;
+        }
+        
+        // YES / NO shares only price binary markets
+        if (state.events[input->eventId - 1].outcomeCount != 2) {
+            state.rejectionCount[REJECT_INVALID_OUTCOME]++;
+            return;
+        }
+        
+        // Prices depend on the shares sold, so b is fixed once trading starts
+        if (input->liquidity == 0 || input->liquidity > LMSR_MAX_LIQUIDITY || state.makers[input->eventId - 1].isEnabled) {
+            state.rejectionCount[REJECT_INVALID_ORDER]++;
+            return;
+        }
+        
+        state.makers[input->eventId - 1].collected = 0;
+        state.makers[input->eventId - 1].liquidity = input->liquidity;
+        state.makers[input->eventId - 1].yesShares = 0;
+        state.makers[input->eventId - 1].noShares = 0;
+        state.makers[input->eventId - 1].isEnabled = 1;
+        
+        output->success = 1;
+    }
+
+    // Quote a market maker bet without placing it
+    PUBLIC(QuoteBet)
+    {
+        QuoteBetInput* input = (QuoteBetInput*)inputBuffer;
+        QuoteBetOutput* output = (QuoteBetOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->cost = 0;
+        output->yesPriceBps = 0;
+        
+        state.invocationCount[STAT_QUOTE_BET]++;
+        state.lastElementsScanned[STAT_QUOTE_BET] = 0;
+        
+        // Find event (event ids are slot + 1)
+        if (input->eventId == 0 || input->eventId > state.eventCount || state.events[input->eventId - 1].id != input->eventId) {
+            state.rejectionCount[REJECT_EVENT_NOT_FOUND]++;
+            return;
+        }
+        
+        if (!state.makers[input->eventId - 1].isEnabled) {
+            state.rejectionCount[REJECT_NO_MARKET_MAKER]++;
+            return;
+        }
+        
+        if (input->amount == 0 || input->amount > LMSR_MAX_TRADE) {
+            state.rejectionCount[REJECT_INVALID_ORDER]++;
+            return;
+        }
+        
+        state.tempEventId = input->eventId - 1;
+        state.tempLmsrShares = input->amount;
+        state.tempLmsrPrediction = input->prediction;
+        CALL(LmsrQuote);
+        
+        // Set output
+        output->cost = (uint32)state.tempCost;
+        output->yesPriceBps = (uint32)((state.tempLmsrPrice * PRICE_BASIS_POINTS + LMSR_ONE / 2) >> LMSR_FRACTION_BITS);
+        output->success = 1;
+    }
+
+    // Make this instance shard shardIndex of shardCount. Only allowed before
+    // any user registers or bets, since home shards follow from user ids.
+    PUBLIC(ConfigureShard)
+    {
+        ConfigureShardInput* input = (ConfigureShardInput*)inputBuffer;
+        ConfigureShardOutput* output = (ConfigureShardOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        
+        state.invocationCount[STAT_CONFIGURE_SHARD]++;
+        state.lastElementsScanned[STAT_CONFIGURE_SHARD] = 0;
+        
+        // Only admin can configure shards
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        if (input->shardCount == 0 || input->shardCount > MAX_SHARDS || input->shardIndex >= input->shardCount
+            || state.userCount > 1 || state.betCount > 0) {
+            state.rejectionCount[REJECT_INVALID_CONFIG]++;
+            return;
+        }
+        
+        state.shardIndex = input->shardIndex;
+        state.shardCount = input->shardCount;
+        
+        // The demo user created by Initialize lives on shard 0
+        if (state.userCount == 1) {
+            state.users[0].balance = state.shardIndex == 0 ? state.defaultBalance : 0;
+        }
+        
+        output->success = 1;
+    }
+
+    // Set the most a user may have riding on unsettled flat bets. Bets already
+    // placed stay; the limit applies from the next PlaceBet on.
+    PUBLIC(SetMaxOpenStake)
+    {
+        SetMaxOpenStakeInput* input = (SetMaxOpenStakeInput*)inputBuffer;
+        SetMaxOpenStakeOutput* output = (SetMaxOpenStakeOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        
+        state.invocationCount[STAT_SET_MAX_OPEN_STAKE]++;
+        state.lastElementsScanned[STAT_SET_MAX_OPEN_STAKE] = 0;
+        
+        // Only admin sets the limit
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        state.maxOpenStake = input->maxOpenStake;
+        output->success = 1;
+    }
+
+    // Move funds out of this shard; the operator credits them on another
+    // shard with ShardTransferIn
+    PUBLIC(ShardTransferOut)
+    {
+        ShardTransferInput* input = (ShardTransferInput*)inputBuffer;
+        ShardTransferOutput* output = (ShardTransferOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->newBalance = 0;
+        
+        state.invocationCount[STAT_SHARD_TRANSFER_OUT]++;
+        state.lastElementsScanned[STAT_SHARD_TRANSFER_OUT] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
+        }
+        
+        // Only admin moves funds between shards
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        // Find user (user ids are slot + 1)
+        if (input->userId == 0 || input->userId > state.userCount || state.users[input->userId - 1].id != input->userId) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        if (state.users[input->userId - 1].balance < input->amount) {
+            state.rejectionCount[REJECT_INSUFFICIENT_BALANCE]++;
+            return;
+        }
+        
+        state.users[input->userId - 1].balance -= input->amount;
+        state.transferredOut += input->amount;
+        
+        output->newBalance = state.users[input->userId - 1].balance;
+        output->success = 1;
+    }
+
+    // Credit funds moved out of another shard by ShardTransferOut
+    PUBLIC(ShardTransferIn)
+    {
+        ShardTransferInput* input = (ShardTransferInput*)inputBuffer;
+        ShardTransferOutput* output = (ShardTransferOutput*)outputBuffer;
+        
+        // Initialize output
+        output->success = 0;
+        output->newBalance = 0;
+        
+        state.invocationCount[STAT_SHARD_TRANSFER_IN]++;
+        state.lastElementsScanned[STAT_SHARD_TRANSFER_IN] = 0;
+        
+        // Check if contract is active
+        if (!state.contractActive) {
+            state.rejectionCount[REJECT_CONTRACT_INACTIVE]++;
+            return;
+        }
+        
+        // Only admin moves funds between shards
+        if (!isEqual(invocator(), state.adminId)) {
+            state.rejectionCount[REJECT_UNAUTHORIZED]++;
+            return;
+        }
+        
+        // Find user (user ids are slot + 1)
+        if (input->userId == 0 || input->userId > state.userCount || state.users[input->userId - 1].id != input->userId) {
+            state.rejectionCount[REJECT_USER_NOT_FOUND]++;
+            return;
+        }
+        
+        state.users[input->userId - 1].balance += input->amount;
+        state.transferredIn += input->amount;
+        
+        output->newBalance = state.users[input->userId - 1].balance;
+        output->success = 1;
+    }
+
+    // Refund the resting orders of event slot tempEventId and pay out its
+    // positions for answer tempResult. Winners and payout are added to
+    // tempCount/tempAmount, visited orders and positions to tempScanned.
+    PRIVATE(CloseEventBook)
+    {
+        // Refund resting orders and return their slots to the free list
+        for (state.tempLevel = 0; state.tempLevel < ORDER_PRICE_LEVELS; state.tempLevel++) {
+            state.tempOrderSlot = state.books[state.tempEventId].bidHead[state.tempLevel];
+            while (state.tempOrderSlot) {
+                state.tempScanned++;
+                state.tempMakerSlot = state.tempOrderSlot - 1;
+                state.users[state.orders[state.tempMakerSlot].userId - 1].balance += state.orders[state.tempMakerSlot].quantity * state.orders[state.tempMakerSlot].price;
+                state.tempOrderSlot = state.orders[state.tempMakerSlot].next;
+                state.orders[state.tempMakerSlot].isActive = 0;
+                state.orders[state.tempMakerSlot].next = state.orderFreeHead;
+                state.orderFreeHead = state.tempMakerSlot + 1;
+            }
+            
+            state.tempOrderSlot = state.books[state.tempEventId].askHead[state.tempLevel];
+            while (state.tempOrderSlot) {
+                state.tempScanned++;
+                state.tempMakerSlot = state.tempOrderSlot - 1;
+                state.users[state.orders[state.tempMakerSlot].userId - 1].balance += state.orders[state.tempMakerSlot].quantity * (ORDER_SHARE_PAYOUT - state.orders[state.tempMakerSlot].price);
+                state.tempOrderSlot = state.orders[state.tempMakerSlot].next;
+                state.orders[state.tempMakerSlot].isActive = 0;
+                state.orders[state.tempMakerSlot].next = state.orderFreeHead;
+                state.orderFreeHead = state.tempMakerSlot + 1;
+            }
+            
+            state.books[state.tempEventId].bidHead[state.tempLevel] = 0;
+            state.books[state.tempEventId].bidTail[state.tempLevel] = 0;
+            state.books[state.tempEventId].bidQuantity[state.tempLevel] = 0;
+            state.books[state.tempEventId].askHead[state.tempLevel] = 0;
+            state.books[state.tempEventId].askTail[state.tempLevel] = 0;
+            state.books[state.tempEventId].askQuantity[state.tempLevel] = 0;
+        }
+        state.books[state.tempEventId].bestBid = 0;
+        state.books[state.tempEventId].bestAsk = 0;
+        
+        // Pay out order book positions; each winning share pays ORDER_SHARE_PAYOUT
+        state.tempPositionSlot = state.books[state.tempEventId].positionHead;
+        while (state.tempPositionSlot) {
+            state.tempScanned++;
+            state.tempIndex = state.tempPositionSlot - 1;
+            state.tempFill = state.tempResult == 1 ? state.positions[state.tempIndex].yesShares : state.positions[state.tempIndex].noShares;
+            if (state.tempFill) {
+                state.users[state.positions[state.tempIndex].userId - 1].balance += state.tempFill * ORDER_SHARE_PAYOUT;
+                state.users[state.positions[state.tempIndex].userId - 1].totalWins++;
+                state.tempLeaderSlot = state.positions[state.tempIndex].userId - 1;
+                CALL(UpdateLeaderboard);
+                state.tempCount++;
+                state.tempAmount = state.tempAmount + state.tempFill * ORDER_SHARE_PAYOUT;
+            }
+            state.positions[state.tempIndex].yesShares = 0;
+            state.positions[state.tempIndex].noShares = 0;
+            state.tempPositionSlot = state.positions[state.tempIndex].nextInEvent;
+        }
+    }
+
+    // User slot tempLeaderSlot just gained a win: enter it into the leaderboard
+    // if it now beats the last entry, then move it up past entries with fewer
+    // wins. Wins grow by one at a time, so this is usually one comparison.
+    // Every unranked user has at most the wins of the last ranked one.
+    PRIVATE(UpdateLeaderboard)
+    {
+        state.tempLeaderRank = state.leaderboardRank[state.tempLeaderSlot];
+        if (state.tempLeaderRank == 0) {
+            if (state.leaderboardCount < LEADERBOARD_SIZE) {
+                state.leaderboardCount++;
+            } else if (state.users[state.leaderboard[LEADERBOARD_SIZE - 1]].totalWins < state.users[state.tempLeaderSlot].totalWins) {
+                state.leaderboardRank[state.leaderboard[LEADERBOARD_SIZE - 1]] = 0;
+            } else {
+                return;
+            }
+            state.tempLeaderRank = state.leaderboardCount;
+            state.leaderboard[state.tempLeaderRank - 1] = state.tempLeaderSlot;
+            state.leaderboardRank[state.tempLeaderSlot] = (uint8)state.tempLeaderRank;
+        }
+        
+        while (state.tempLeaderRank > 1
+            && state.users[state.leaderboard[state.tempLeaderRank - 2]].totalWins < state.users[state.tempLeaderSlot].totalWins) {
+            state.tempLeaderSwap = state.leaderboard[state.tempLeaderRank - 2];
+            state.leaderboard[state.tempLeaderRank - 1] = state.tempLeaderSwap;
+            state.leaderboardRank[state.tempLeaderSwap] = (uint8)state.tempLeaderRank;
+            state.tempLeaderRank--;
+        }
+        state.leaderboard[state.tempLeaderRank - 1] = state.tempLeaderSlot;
+        state.leaderboardRank[state.tempLeaderSlot] = (uint8)state.tempLeaderRank;
+    }
+
+    // Home slot of tempPositionUserId in tempPositionEventId, into tempPositionSlot
+    PRIVATE(HashPosition)
+    {
+        state.tempPositionSlot = (state.tempPositionUserId * 2654435761u ^ state.tempPositionEventId * 40503u) & (MAX_POSITIONS - 1);
+    }
+
+    // Find or create the position of tempPositionUserId in tempPositionEventId.
+    // Sets tempPositionSlot, or MAX_POSITIONS when the table is full.
+    PRIVATE(FindPosition)
+    {
+        CALL(HashPosition);
+        while (state.positions[state.tempPositionSlot].userId != 0) {
+            if (state.positions[state.tempPositionSlot].userId == state.tempPositionUserId
+                && state.positions[state.tempPositionSlot].eventId == state.tempPositionEventId) {
+                return;
+            }
+            state.tempPositionSlot = (state.tempPositionSlot + 1) & (MAX_POSITIONS - 1);
+        }
+        
+        // Positions only go in CompactPositions, so the load limit bounds
+        // every probe
+        if (state.positionCount >= MAX_POSITION_LOAD) {
+            state.tempPositionSlot = MAX_POSITIONS;
+            return;
+        }
+        
+        state.positions[state.tempPositionSlot].userId = state.tempPositionUserId;
+        state.positions[state.tempPositionSlot].eventId = state.tempPositionEventId;
+        state.positions[state.tempPositionSlot].yesShares = 0;
+        state.positions[state.tempPositionSlot].noShares = 0;
+        state.positions[state.tempPositionSlot].nextInEvent = state.books[state.tempPositionEventId - 1].positionHead;
+        state.books[state.tempPositionEventId - 1].positionHead = state.tempPositionSlot + 1;
+        state.positionCount++;
+    }
+
+    // Drop the positions of resolved events, which CloseEventBook has paid out
+    // and zeroed, and give their slots back to the table. Removing entries
+    // from a linear probing table leaves holes that cut the probe sequences
+    // of entries behind them, so every remaining position is moved to the
+    // first free slot from its home, in one round starting at a free slot;
+    // that never moves an entry past a free slot or behind its home. Slots
+    // change, so the per-event position lists are relinked afterwards.
+    PRIVATE(CompactPositions)
+    {
+        for (state.tempIndex = 0; state.tempIndex < MAX_POSITIONS; state.tempIndex++) {
+            if (state.positions[state.tempIndex].userId && state.events[state.positions[state.tempIndex].eventId - 1].isResolved) {
+                state.positions[state.tempIndex].userId = 0;
+                state.positions[state.tempIndex].eventId = 0;
+                state.positionCount--;
+            }
+        }
+        
+        // The load limit keeps a free slot to start from
+        state.tempOrderSlot = 0;
+        while (state.positions[state.tempOrderSlot].userId != 0) {
+            state.tempOrderSlot++;
+        }
+        for (state.tempCount = 1; state.tempCount < MAX_POSITIONS; state.tempCount++) {
+            state.tempIndex = (state.tempOrderSlot + state.tempCount) & (MAX_POSITIONS - 1);
+            if (state.positions[state.tempIndex].userId == 0) {
+                continue;
+            }
+            state.tempPositionUserId = state.positions[state.tempIndex].userId;
+            state.tempPositionEventId = state.positions[state.tempIndex].eventId;
+            state.tempYesShares = state.positions[state.tempIndex].yesShares;
+            state.tempNoShares = state.positions[state.tempIndex].noShares;
+            state.positions[state.tempIndex].userId = 0;
+            CALL(HashPosition);
+            while (state.positions[state.tempPositionSlot].userId != 0) {
+                state.tempPositionSlot = (state.tempPositionSlot + 1) & (MAX_POSITIONS - 1);
+            }
+            state.positions[state.tempPositionSlot].userId = state.tempPositionUserId;
+            state.positions[state.tempPositionSlot].eventId = state.tempPositionEventId;
+            state.positions[state.tempPositionSlot].yesShares = state.tempYesShares;
+            state.positions[state.tempPositionSlot].noShares = state.tempNoShares;
+        }
+        
+        for (state.tempIndex = 0; state.tempIndex < state.eventCount; state.tempIndex++) {
+            state.books[state.tempIndex].positionHead = 0;
+        }
+        for (state.tempIndex = 0; state.tempIndex < MAX_POSITIONS; state.tempIndex++) {
+            if (state.positions[state.tempIndex].userId) {
+                state.positions[state.tempIndex].nextInEvent = state.books[state.positions[state.tempIndex].eventId - 1].positionHead;
+                state.books[state.positions[state.tempIndex].eventId - 1].positionHead = state.tempIndex + 1;
+            }
+        }
+    }
+
+    // Add tempYesShares/tempNoShares to position tempPositionSlot. A YES and a
+    // NO share together always pay out, so pairs are redeemed immediately;
+    // that is how a holder exits before resolution.
+    PRIVATE(SettlePosition)
+    {
+        state.positions[state.tempPositionSlot].yesShares += state.tempYesShares;
+        state.positions[state.tempPositionSlot].noShares += state.tempNoShares;
+        
+        state.tempPairs = state.positions[state.tempPositionSlot].yesShares < state.positions[state.tempPositionSlot].noShares
+            ? state.positions[state.tempPositionSlot].yesShares : state.positions[state.tempPositionSlot].noShares;
+        if (state.tempPairs) {
+            state.positions[state.tempPositionSlot].yesShares -= state.tempPairs;
+            state.positions[state.tempPositionSlot].noShares -= state.tempPairs;
+            state.users[state.positions[state.tempPositionSlot].userId - 1].balance += state.tempPairs * ORDER_SHARE_PAYOUT;
+        }
+    }
+
+    // Unlink order tempOrderSlot from its price level and free the slot. When
+    // the level empties and held the best price, the next best level is found
+    // by walking the at most ORDER_PRICE_LEVELS levels, never the orders.
+    // The order and every level walked are added to tempScanned.
+    PRIVATE(ReleaseOrder)
+    {
+        state.tempScanned++;
+        state.tempEventId = state.orders[state.tempOrderSlot].eventId - 1;
+        state.tempLevel = state.orders[state.tempOrderSlot].price - 1;
+        
+        if (state.orders[state.tempOrderSlot].side == ORDER_SIDE_BUY) {
+            if (state.orders[state.tempOrderSlot].prev) {
+                state.orders[state.orders[state.tempOrderSlot].prev - 1].next = state.orders[state.tempOrderSlot].next;
+            } else {
+                state.books[state.tempEventId].bidHead[state.tempLevel] = state.orders[state.tempOrderSlot].next;
+            }
+            if (state.orders[state.tempOrderSlot].next) {
+                state.orders[state.orders[state.tempOrderSlot].next - 1].prev = state.orders[state.tempOrderSlot].prev;
+            } else {
+                state.books[state.tempEventId].bidTail[state.tempLevel] = state.orders[state.tempOrderSlot].prev;
+            }
+            
+            if (state.books[state.tempEventId].bidHead[state.tempLevel] == 0
+                && state.books[state.tempEventId].bestBid == state.tempLevel + 1) {
+                state.books[state.tempEventId].bestBid = 0;
+                while (state.tempLevel > 0) {
+                    state.tempLevel--;
+                    state.tempScanned++;
+                    if (state.books[state.tempEventId].bidHead[state.tempLevel]) {
+                        state.books[state.tempEventId].bestBid = state.tempLevel + 1;
+                        break;
+                    }
+                }
+            }
+        } else {
+            if (state.orders[state.tempOrderSlot].prev) {
+                state.orders[state.orders[state.tempOrderSlot].prev - 1].next = state.orders[state.tempOrderSlot].next;
+            } else {
+                state.books[state.tempEventId].askHead[state.tempLevel] = state.orders[state.tempOrderSlot].next;
+            }
+            if (state.orders[state.tempOrderSlot].next) {
+                state.orders[state.orders[state.tempOrderSlot].next - 1].prev = state.orders[state.tempOrderSlot].prev;
+            } else {
+                state.books[state.tempEventId].askTail[state.tempLevel] = state.orders[state.tempOrderSlot].prev;
+            }
+            
+            if (state.books[state.tempEventId].askHead[state.tempLevel] == 0
+                && state.books[state.tempEventId].bestAsk == state.tempLevel + 1) {
+                state.books[state.tempEventId].bestAsk = 0;
+                while (state.tempLevel + 1 < ORDER_PRICE_LEVELS) {
+                    state.tempLevel++;
+                    state.tempScanned++;
+                    if (state.books[state.tempEventId].askHead[state.tempLevel]) {
+                        state.books[state.tempEventId].bestAsk = state.tempLevel + 1;
+                        break;
+                    }
+                }
+            }
+        }
+        
+        state.orders[state.tempOrderSlot].isActive = 0;
+        state.orders[state.tempOrderSlot].next = state.orderFreeHead;
+        state.orderFreeHead = state.tempOrderSlot + 1;
+    }
+
+    // tempLmsrExp = e^-tempLmsrAbs for tempLmsrAbs >= 0, from the two exp tables
+    PRIVATE(LmsrExpNeg)
+    {
+        if (state.tempLmsrAbs >= LMSR_EXP_RANGE * LMSR_ONE) {
+            state.tempLmsrExp = 0;
+            return;
+        }
+        state.tempLmsrIndex = (uint32)(state.tempLmsrAbs >> (LMSR_FRACTION_BITS - LMSR_EXP_STEP_BITS));
+        state.tempLmsrExp = LMSR_TABLES.expNeg[state.tempLmsrIndex];
+        
+        state.tempLmsrIndex = (uint32)(state.tempLmsrAbs >> (LMSR_FRACTION_BITS - LMSR_EXP_STEP_BITS - LMSR_EXP_FINE_BITS)) & ((1 << LMSR_EXP_FINE_BITS) - 1);
+        state.tempLmsrExp = (state.tempLmsrExp * LMSR_TABLES.expNegFine[state.tempLmsrIndex]) >> LMSR_FRACTION_BITS;
+        
+        // e^-r ~ 1 - r for the last r < 1/16384, off by under 2e-9
+        state.tempLmsrFrac = state.tempLmsrAbs & (((sint64)1 << (LMSR_FRACTION_BITS - LMSR_EXP_STEP_BITS - LMSR_EXP_FINE_BITS)) - 1);
+        state.tempLmsrExp = (state.tempLmsrExp * (LMSR_ONE - state.tempLmsrFrac)) >> LMSR_FRACTION_BITS;
+    }
+    
+    // tempLmsrY = ln(1 + e^tempLmsrX) = max(x, 0) + ln(1 + e^-|x|), in constant time
+    PRIVATE(LmsrSoftplus)
+    {
+        state.tempLmsrAbs = state.tempLmsrX < 0 ? -state.tempLmsrX : state.tempLmsrX;
+        CALL(LmsrExpNeg);
+        
+        // ln(1 + y) = ln(1 + node) + ln(1 + t) with t = (y - node) / (1 + node) < 1/256
+        state.tempLmsrIndex = (uint32)(state.tempLmsrExp >> (LMSR_FRACTION_BITS - LMSR_LOG_STEP_BITS));
+        state.tempLmsrY = LMSR_TABLES.log1p[state.tempLmsrIndex];
+        state.tempLmsrFrac = ((state.tempLmsrExp - ((sint64)state.tempLmsrIndex << (LMSR_FRACTION_BITS - LMSR_LOG_STEP_BITS))) << LMSR_FRACTION_BITS)
+            / (LMSR_ONE + ((sint64)state.tempLmsrIndex << (LMSR_FRACTION_BITS - LMSR_LOG_STEP_BITS)));
+        state.tempLmsrAbs = (state.tempLmsrFrac * state.tempLmsrFrac) >> LMSR_FRACTION_BITS;
+        state.tempLmsrY += state.tempLmsrFrac - state.tempLmsrAbs / 2 + ((state.tempLmsrAbs * state.tempLmsrFrac) >> LMSR_FRACTION_BITS) / 3;
+        
+        if (state.tempLmsrX > 0) {
+            state.tempLmsrY += state.tempLmsrX;
+        }
+    }
+    
+    // Price tempLmsrShares shares of side tempLmsrPrediction from the market
+    // maker of event slot tempEventId. The LMSR cost is
+    //   C(q) = b ln(e^(q_yes / b) + e^(q_no / b)) = q_no + b softplus((q_yes - q_no) / b),
+    // so a trade costs b (softplus(d + shares / b) - softplus(d)) payouts with d
+    // taken from the buyer's side. Sets tempCost (rounded up, so at least 1) and
+    // tempLmsrPrice, the YES price before the trade.
+    PRIVATE(LmsrQuote)
+    {
+        state.tempLmsrBase = ((sint64)state.makers[state.tempEventId].yesShares - (sint64)state.makers[state.tempEventId].noShares)
+            * LMSR_ONE / state.makers[state.tempEventId].liquidity;
+        
+        // YES price = 1 / (1 + e^-d)
+        state.tempLmsrAbs = state.tempLmsrBase < 0 ? -state.tempLmsrBase : state.tempLmsrBase;
+        CALL(LmsrExpNeg);
+        if (state.tempLmsrBase >= 0) {
+            state.tempLmsrPrice = LMSR_ONE * LMSR_ONE / (LMSR_ONE + state.tempLmsrExp);
+        } else {
+            state.tempLmsrPrice = state.tempLmsrExp * LMSR_ONE / (LMSR_ONE + state.tempLmsrExp);
+        }
+        
+        if (state.tempLmsrPrediction == 0) {
+            state.tempLmsrBase = -state.tempLmsrBase;
+        }
+        
+        state.tempLmsrX = state.tempLmsrBase;
+        CALL(LmsrSoftplus);
+        state.tempLmsrBase = state.tempLmsrY;
+        
+        state.tempLmsrX = state.tempLmsrX + ((sint64)state.tempLmsrShares * LMSR_ONE + state.makers[state.tempEventId].liquidity - 1)
+            / state.makers[state.tempEventId].liquidity;
+        CALL(LmsrSoftplus);
+        
+        state.tempCost = ((uint64)(state.tempLmsrY - state.tempLmsrBase + LMSR_QUOTE_MARGIN) * state.makers[state.tempEventId].liquidity * ORDER_SHARE_PAYOUT
+            + LMSR_ONE - 1) >> LMSR_FRACTION_BITS;
+    }
+
     // System procedures
     BEGIN_EPOCH()
     {
@@ -638,7 +2451,8 @@ BEGIN_CONTRACT(PredictoR)
 
     END_EPOCH()
     {
-        // Clean up expired events, process pending operations
+        // Reclaim the position slots of events resolved this epoch
+        CALL(CompactPositions);
     }
 
 END_CONTRACT
\ No newline at end of file
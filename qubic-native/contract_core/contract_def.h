@@ -0,0 +1,102 @@
+// Host build of the contract API used by qubic-contracts/HM25.h
+//
+// Inside qubic-core the contract includes contract_core/contract_def.h from the
+// core tree. The native tools in qubic-native/ compile with -Iqubic-native/include,
+// so the same "../contract_core/contract_def.h" include resolves to this file and
+// the unmodified contract can be linked into benchmarks, the mock node and
+// offline verifiers.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+typedef int8_t sint8;
+typedef uint8_t uint8;
+typedef int16_t sint16;
+typedef uint16_t uint16;
+typedef int32_t sint32;
+typedef uint32_t uint32;
+typedef int64_t sint64;
+typedef uint64_t uint64;
+
+struct alignas(32) m256i
+{
+    uint64 m256i_u64[4];
+};
+
+inline bool isEqual(const m256i& a, const m256i& b)
+{
+    return memcmp(&a, &b, sizeof(m256i)) == 0;
+}
+
+inline void copyMem(void* destination, const void* source, uint64 size)
+{
+    memcpy(destination, source, size);
+}
+
+inline void setMem(void* destination, uint64 size, uint8 value)
+{
+    memset(destination, value, size);
+}
+
+// Tick and epoch as seen by the contract; advanced by the host
+struct ContractSystem
+{
+    uint32 tick;
+    uint16 epoch;
+};
+
+// Entry point table filled in by REGISTER_USER_FUNCTIONS_AND_PROCEDURES
+template <typename Contract>
+struct ContractEntryPoints
+{
+    typedef void (Contract::*EntryPoint)(const void* inputBuffer, void* outputBuffer);
+
+    static constexpr uint32 MAX_ENTRY_POINTS = 256;
+
+    EntryPoint functions[MAX_ENTRY_POINTS] = {};
+    EntryPoint procedures[MAX_ENTRY_POINTS] = {};
+    const char* functionNames[MAX_ENTRY_POINTS] = {};
+    const char* procedureNames[MAX_ENTRY_POINTS] = {};
+};
+
+#define BEGIN_CONTRACT(contractName) \
+    struct contractName \
+    { \
+        typedef contractName Self; \
+        CONTRACT_STATE state; \
+        ContractSystem system; \
+        m256i currentInvocator; \
+        const m256i& invocator() const { return currentInvocator; }
+
+#define END_CONTRACT };
+
+#define public_function(functionName, index)
+#define public_procedure(procedureName, index)
+
+#define REGISTER_USER_FUNCTIONS_AND_PROCEDURES \
+        static void registerEntryPoints(ContractEntryPoints<Self>& entryPoints) {
+
+#define REGISTER_USER_FUNCTION(functionName, index) \
+            entryPoints.functions[index] = &Self::functionName; \
+            entryPoints.functionNames[index] = #functionName
+
+#define REGISTER_USER_PROCEDURE(procedureName, index) \
+            entryPoints.procedures[index] = &Self::procedureName; \
+            entryPoints.procedureNames[index] = #procedureName
+
+#define END_REGISTER_USER_FUNCTIONS_AND_PROCEDURES }
+
+#define PUBLIC(entryName) \
+        void entryName([[maybe_unused]] const void* inputBuffer, [[maybe_unused]] void* outputBuffer)
+
+// Contract-internal helpers. Like the entry points they keep their working
+// values in state temporaries, so they take no arguments.
+#define PRIVATE(helperName) \
+        void helperName()
+
+#define CALL(helperName) helperName()
+
+#define BEGIN_EPOCH() void beginEpoch()
+#define END_EPOCH() void endEpoch()
@@ -0,0 +1,168 @@
+// Bet table in structure-of-arrays form with filter scan kernels, for
+// read_replica.
+//
+// A filter is any combination of user, event, stake range and unsettled.
+// The scalar kernel tests one bet at a time; the AVX2 kernel tests eight per
+// step on the columns a filter uses and turns the lane mask into matching
+// slots. Both return the same slots in the same order, so the kernel can be
+// picked per query and benchmarked against the other (bench_bet_scan).
+
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <immintrin.h>
+#include <vector>
+
+#include "contract_layout.h"
+
+enum ScanKernel : uint8
+{
+    SCAN_DEFAULT = 0,
+    SCAN_SCALAR = 1,
+    SCAN_AVX2 = 2,
+};
+
+constexpr uint8 BET_WON = 1;
+constexpr uint8 BET_PROCESSED = 2;
+
+struct BetFilter
+{
+    uint32 userId = 0;     // 0 = any
+    uint32 eventId = 0;    // 0 = any
+    uint32 minAmount = 0;
+    uint32 maxAmount = 0;  // 0 = no upper bound
+    bool unsettledOnly = false;
+};
+
+struct BetColumns
+{
+    uint32 count = 0;
+    std::vector<uint32> id;
+    std::vector<uint32> userId;
+    std::vector<uint32> eventId;
+    std::vector<uint32> amount;
+    std::vector<uint32> createdAt;
+    std::vector<uint8> prediction;  // Outcome index; 1 = YES in a binary market
+    std::vector<uint8> flags;       // BET_* bits
+
+    void load(const CONTRACT_STATE& state)
+    {
+        count = state.betCount;
+        id.resize(count);
+        userId.resize(count);
+        eventId.resize(count);
+        amount.resize(count);
+        createdAt.resize(count);
+        prediction.resize(count);
+        flags.resize(count);
+        for (uint32 i = 0; i < count; i++) {
+            const Bet& bet = state.bets[i];
+            id[i] = bet.id;
+            userId[i] = bet.userId;
+            eventId[i] = bet.eventId;
+            amount[i] = bet.amount;
+            createdAt[i] = bet.createdAt;
+            prediction[i] = bet.prediction;
+            flags[i] = (bet.isWon ? BET_WON : 0) | (bet.isProcessed ? BET_PROCESSED : 0);
+        }
+    }
+};
+
+inline bool avx2Supported()
+{
+    return __builtin_cpu_supports("avx2");
+}
+
+inline bool matchesBet(const BetColumns& bets, const BetFilter& filter, uint32 slot)
+{
+    const uint32 maxAmount = filter.maxAmount ? filter.maxAmount : UINT32_MAX;
+    return (!filter.userId || bets.userId[slot] == filter.userId)
+        && (!filter.eventId || bets.eventId[slot] == filter.eventId)
+        && bets.amount[slot] >= filter.minAmount && bets.amount[slot] <= maxAmount
+        && (!filter.unsettledOnly || !(bets.flags[slot] & BET_PROCESSED));
+}
+
+// Matches in slot order: returns how many there are in [first, end) and
+// appends matches number skip .. skip + limit - 1 of them to slots
+inline uint32 scanBetsScalar(const BetColumns& bets, const BetFilter& filter, uint32 first, uint32 end, uint32 skip,
+    uint32 limit, std::vector<uint32>& slots)
+{
+    uint32 total = 0;
+    for (uint32 slot = first; slot < end; slot++) {
+        if (matchesBet(bets, filter, slot)) {
+            if (total >= skip && total - skip < limit) {
+                slots.push_back(slot);
+            }
+            total++;
+        }
+    }
+    return total;
+}
+
+__attribute__((target("avx2,popcnt,bmi")))
+inline uint32 scanBetsAvx2(const BetColumns& bets, const BetFilter& filter, uint32 skip, uint32 limit, std::vector<uint32>& slots)
+{
+    const __m256i user = _mm256_set1_epi32((int)filter.userId);
+    const __m256i event = _mm256_set1_epi32((int)filter.eventId);
+    const __m256i minAmount = _mm256_set1_epi32((int)filter.minAmount);
+    const __m256i maxAmount = _mm256_set1_epi32((int)(filter.maxAmount ? filter.maxAmount : UINT32_MAX));
+    const __m256i processed = _mm256_set1_epi32(BET_PROCESSED);
+    const __m256i zero = _mm256_setzero_si256();
+    const bool rangeFilter = filter.minAmount || filter.maxAmount;
+    const size_t firstSlot = slots.size();
+
+    uint32 total = 0;
+    const uint32 vectorEnd = bets.count & ~7u;
+    for (uint32 base = 0; base < vectorEnd; base += 8) {
+        // All lanes start as matches; each filter in use clears lanes
+        __m256i mask = _mm256_set1_epi32(-1);
+        if (filter.userId) {
+            const __m256i values = _mm256_loadu_si256((const __m256i*)(bets.userId.data() + base));
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(values, user));
+        }
+        if (filter.eventId) {
+            const __m256i values = _mm256_loadu_si256((const __m256i*)(bets.eventId.data() + base));
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(values, event));
+        }
+        if (rangeFilter) {
+            // Unsigned range test: x >= lo iff max(x, lo) == x, x <= hi iff min(x, hi) == x
+            const __m256i values = _mm256_loadu_si256((const __m256i*)(bets.amount.data() + base));
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(_mm256_max_epu32(values, minAmount), values));
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(_mm256_min_epu32(values, maxAmount), values));
+        }
+        if (filter.unsettledOnly) {
+            uint64 packed;
+            memcpy(&packed, bets.flags.data() + base, sizeof(packed));
+            const __m256i values = _mm256_cvtepu8_epi32(_mm_cvtsi64_si128((long long)packed));
+            mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(_mm256_and_si256(values, processed), zero));
+        }
+
+        uint32 bits = (uint32)_mm256_movemask_ps(_mm256_castsi256_ps(mask));
+        const uint32 matches = (uint32)_mm_popcnt_u32(bits);
+        if (total + matches > skip && total - std::min(total, skip) < limit) {
+            for (uint32 seen = total; bits; seen++, bits &= bits - 1) {
+                if (seen >= skip && seen - skip < limit) {
+                    slots.push_back(base + (uint32)__builtin_ctz(bits));
+                }
+            }
+        }
+        total += matches;
+    }
+
+    // Tail shorter than a vector
+    const uint32 tailSkip = skip > total ? skip - total : 0;
+    const uint32 taken = (uint32)(slots.size() - firstSlot);
+    total += scanBetsScalar(bets, filter, vectorEnd, bets.count, tailSkip, limit > taken ? limit - taken : 0, slots);
+    return total;
+}
+
+// Runs the filter with the given kernel, falling back to scalar without AVX2
+inline uint32 scanBets(const BetColumns& bets, const BetFilter& filter, ScanKernel kernel, uint32 skip, uint32 limit,
+    std::vector<uint32>& slots)
+{
+    if (kernel == SCAN_AVX2 && avx2Supported()) {
+        return scanBetsAvx2(bets, filter, skip, limit, slots);
+    }
+    return scanBetsScalar(bets, filter, 0, bets.count, skip, limit, slots);
+}
@@ -0,0 +1,103 @@
+// Aggregate queries over a column_store.h export.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "column_store.h"
+
+namespace columnar
+{
+
+struct VolumeRow
+{
+    std::string category;
+    uint32 day;
+    uint64 bets;
+    uint64 volume;
+};
+
+struct ScanStats
+{
+    uint32 blocksScanned = 0;
+    uint32 blocksSkipped = 0;
+};
+
+// Bet count and volume per event category per day, for bets created in
+// days [fromDay, toDay]. Reads only bets.eventId, bets.amount and
+// bets.createdAt; blocks whose createdAt range misses the days are skipped.
+// Returns false when the file lacks one of the columns.
+inline bool volumeByCategoryDay(const ColumnFile& file, uint32 ticksPerDay, uint32 fromDay, uint32 toDay,
+    std::vector<VolumeRow>& rows, ScanStats& scan)
+{
+    const ColumnEntry* eventIds = file.find("events", "id");
+    const ColumnEntry* categories = file.find("events", "category");
+    const ColumnEntry* betEvents = file.find("bets", "eventId");
+    const ColumnEntry* amounts = file.find("bets", "amount");
+    const ColumnEntry* createdAt = file.find("bets", "createdAt");
+    if (!eventIds || !categories || categories->type != COLUMN_DICT || !betEvents || !amounts || !createdAt
+        || betEvents->rows != amounts->rows || betEvents->rows != createdAt->rows || !ticksPerDay || fromDay > toDay) {
+        return false;
+    }
+
+    // Event id -> category code; ids are slot + 1
+    std::vector<uint32> categoryOfEvent(eventIds->rows + 1, 0);
+    const uint32* ids = file.values<uint32>(*eventIds);
+    const uint32* codes = file.values<uint32>(*categories);
+    for (uint32 row = 0; row < eventIds->rows; row++) {
+        if (ids[row] && ids[row] <= eventIds->rows) {
+            categoryOfEvent[ids[row]] = codes[row];
+        }
+    }
+
+    // Clamp the day range to the data, then accumulate into a dense grid
+    const uint32 betRows = createdAt->rows;
+    const BlockStats* blocks = file.stats(*createdAt);
+    uint32 firstDay = toDay;
+    uint32 lastDay = fromDay;
+    for (uint32 block = 0; block < blockCount(betRows); block++) {
+        firstDay = std::min(firstDay, std::max(fromDay, blocks[block].min / ticksPerDay));
+        lastDay = std::max(lastDay, std::min(toDay, blocks[block].max / ticksPerDay));
+    }
+    rows.clear();
+    if (firstDay > lastDay) {
+        return true;
+    }
+
+    const uint32 dayCount = lastDay - firstDay + 1;
+    std::vector<uint64> bets((size_t)categories->dictCount * dayCount, 0);
+    std::vector<uint64> volume((size_t)categories->dictCount * dayCount, 0);
+    const uint32* betEvent = file.values<uint32>(*betEvents);
+    const uint32* amount = file.values<uint32>(*amounts);
+    const uint32* created = file.values<uint32>(*createdAt);
+    for (uint32 block = 0; block < blockCount(betRows); block++) {
+        if (blocks[block].max / ticksPerDay < firstDay || blocks[block].min / ticksPerDay > lastDay) {
+            scan.blocksSkipped++;
+            continue;
+        }
+        scan.blocksScanned++;
+        const uint32 end = std::min(betRows, (block + 1) * BLOCK_ROWS);
+        for (uint32 row = block * BLOCK_ROWS; row < end; row++) {
+            const uint32 day = created[row] / ticksPerDay;
+            if (day < firstDay || day > lastDay || betEvent[row] == 0 || betEvent[row] > eventIds->rows) {
+                continue;
+            }
+            const size_t cell = (size_t)categoryOfEvent[betEvent[row]] * dayCount + (day - firstDay);
+            bets[cell]++;
+            volume[cell] += amount[row];
+        }
+    }
+
+    for (uint32 category = 0; category < categories->dictCount; category++) {
+        for (uint32 day = 0; day < dayCount; day++) {
+            const size_t cell = (size_t)category * dayCount + day;
+            if (bets[cell]) {
+                rows.push_back({ std::string(file.dictionaryValue(*categories, category)), firstDay + day, bets[cell], volume[cell] });
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace columnar
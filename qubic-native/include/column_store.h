@@ -0,0 +1,304 @@
+// Columnar export format for contract state analytics.
+//
+// One file holds the columns of several tables (users, events, bets), each
+// column a typed array aligned to COLUMN_ALIGN so a read-only mmap of the
+// file can be used in place:
+//
+//   FileHeader
+//   ColumnEntry[columnCount]
+//   per column: values, BlockStats[blocks], and for COLUMN_DICT columns a
+//   dictionary of uint32 offsets[dictCount + 1] followed by the strings
+//
+// COLUMN_DICT columns store uint32 codes into the column's dictionary, in
+// first-seen order. BlockStats hold min and max (widened to uint32) of every
+// BLOCK_ROWS rows, so range filters can skip whole blocks.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <string>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+
+#include "contract_layout.h"
+
+namespace columnar
+{
+
+constexpr uint32 FILE_MAGIC = 0x43445250;  // "PRDC"
+constexpr uint32 FILE_VERSION = 1;
+constexpr uint32 BLOCK_ROWS = 4096;
+constexpr uint32 COLUMN_ALIGN = 64;
+
+enum ColumnType : uint16
+{
+    COLUMN_U8 = 1,
+    COLUMN_U32 = 2,
+    COLUMN_DICT = 3,
+};
+
+struct FileHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint32 columnCount;
+    uint32 blockRows;
+    uint32 tick;
+    uint16 epoch;
+    uint16 reserved;
+    uint64 fileSize;
+};
+
+struct ColumnEntry
+{
+    char table[16];
+    char name[24];
+    uint16 type;
+    uint16 reserved;
+    uint32 rows;
+    uint64 dataOffset;
+    uint64 statsOffset;
+    uint64 dictOffset;
+    uint32 dictCount;
+    uint32 dictBytes;
+};
+
+struct BlockStats
+{
+    uint32 min;
+    uint32 max;
+};
+
+inline uint32 blockCount(uint32 rows)
+{
+    return (rows + BLOCK_ROWS - 1) / BLOCK_ROWS;
+}
+
+// Builds the columns in memory and writes them out in one go
+class ColumnWriter
+{
+public:
+    void addU8(const char* table, const char* name, const std::vector<uint8>& values)
+    {
+        Column& column = add(table, name, COLUMN_U8, (uint32)values.size());
+        column.bytes.assign(values.begin(), values.end());
+        computeStats(column, values.data());
+    }
+
+    void addU32(const char* table, const char* name, const std::vector<uint32>& values)
+    {
+        Column& column = add(table, name, COLUMN_U32, (uint32)values.size());
+        appendBytes(column.bytes, values.data(), values.size() * sizeof(uint32));
+        computeStats(column, values.data());
+    }
+
+    void addDict(const char* table, const char* name, const std::vector<std::string>& values)
+    {
+        Column& column = add(table, name, COLUMN_DICT, (uint32)values.size());
+        std::unordered_map<std::string, uint32> codes;
+        std::vector<uint32> encoded(values.size());
+        std::vector<uint32> offsets(1, 0);
+        std::string strings;
+        for (size_t row = 0; row < values.size(); row++) {
+            const auto inserted = codes.emplace(values[row], (uint32)codes.size());
+            if (inserted.second) {
+                strings += values[row];
+                offsets.push_back((uint32)strings.size());
+            }
+            encoded[row] = inserted.first->second;
+        }
+        appendBytes(column.bytes, encoded.data(), encoded.size() * sizeof(uint32));
+        computeStats(column, encoded.data());
+
+        column.entry.dictCount = (uint32)codes.size();
+        column.entry.dictBytes = (uint32)strings.size();
+        appendBytes(column.dictionary, offsets.data(), offsets.size() * sizeof(uint32));
+        column.dictionary += strings;
+    }
+
+    bool write(const char* path, uint32 tick, uint16 epoch)
+    {
+        // Lay out every section on a COLUMN_ALIGN boundary
+        uint64 offset = align(sizeof(FileHeader) + columns.size() * sizeof(ColumnEntry));
+        for (Column& column : columns) {
+            column.entry.dataOffset = offset;
+            offset = align(offset + column.bytes.size());
+            column.entry.statsOffset = offset;
+            offset = align(offset + column.stats.size() * sizeof(BlockStats));
+            column.entry.dictOffset = column.dictionary.empty() ? 0 : offset;
+            offset = align(offset + column.dictionary.size());
+        }
+
+        const FileHeader header = { FILE_MAGIC, FILE_VERSION, (uint32)columns.size(), BLOCK_ROWS, tick, epoch, 0, offset };
+        std::string file(offset, '\0');
+        memcpy(&file[0], &header, sizeof(header));
+        for (size_t i = 0; i < columns.size(); i++) {
+            const Column& column = columns[i];
+            memcpy(&file[sizeof(header) + i * sizeof(ColumnEntry)], &column.entry, sizeof(ColumnEntry));
+            memcpy(&file[column.entry.dataOffset], column.bytes.data(), column.bytes.size());
+            memcpy(&file[column.entry.statsOffset], column.stats.data(), column.stats.size() * sizeof(BlockStats));
+            memcpy(&file[column.entry.dictOffset], column.dictionary.data(), column.dictionary.size());
+        }
+
+        FILE* out = fopen(path, "wb");
+        if (!out) {
+            return false;
+        }
+        const bool written = fwrite(file.data(), file.size(), 1, out) == 1;
+        return fclose(out) == 0 && written;
+    }
+
+private:
+    struct Column
+    {
+        ColumnEntry entry;
+        std::string bytes;
+        std::vector<BlockStats> stats;
+        std::string dictionary;
+    };
+
+    std::vector<Column> columns;
+
+    static uint64 align(uint64 offset)
+    {
+        return (offset + COLUMN_ALIGN - 1) / COLUMN_ALIGN * COLUMN_ALIGN;
+    }
+
+    static void appendBytes(std::string& bytes, const void* data, size_t size)
+    {
+        bytes.append((const char*)data, size);
+    }
+
+    Column& add(const char* table, const char* name, ColumnType type, uint32 rows)
+    {
+        columns.emplace_back();
+        Column& column = columns.back();
+        memset(&column.entry, 0, sizeof(column.entry));
+        strncpy(column.entry.table, table, sizeof(column.entry.table) - 1);
+        strncpy(column.entry.name, name, sizeof(column.entry.name) - 1);
+        column.entry.type = type;
+        column.entry.rows = rows;
+        return column;
+    }
+
+    template <typename T>
+    static void computeStats(Column& column, const T* values)
+    {
+        const uint32 rows = column.entry.rows;
+        for (uint32 first = 0; first < rows; first += BLOCK_ROWS) {
+            const uint32 last = std::min(rows, first + BLOCK_ROWS);
+            BlockStats block = { values[first], values[first] };
+            for (uint32 row = first + 1; row < last; row++) {
+                block.min = std::min<uint32>(block.min, values[row]);
+                block.max = std::max<uint32>(block.max, values[row]);
+            }
+            column.stats.push_back(block);
+        }
+    }
+};
+
+// Read-only mapping of an exported file; column data is used in place
+class ColumnFile
+{
+public:
+    ColumnFile() = default;
+
+    ~ColumnFile()
+    {
+        if (base) {
+            munmap((void*)base, size);
+        }
+    }
+
+    ColumnFile(const ColumnFile&) = delete;
+    ColumnFile& operator=(const ColumnFile&) = delete;
+
+    bool open(const char* path)
+    {
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat info;
+        void* mapped = MAP_FAILED;
+        if (fstat(fd, &info) == 0 && (uint64)info.st_size >= sizeof(FileHeader)) {
+            mapped = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        }
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        base = (const uint8*)mapped;
+        size = (size_t)info.st_size;
+
+        // Refuse files whose directory or sections point outside the mapping
+        const FileHeader& head = header();
+        if (head.magic != FILE_MAGIC || head.version != FILE_VERSION || head.fileSize != size
+            || sizeof(FileHeader) + (uint64)head.columnCount * sizeof(ColumnEntry) > size) {
+            return false;
+        }
+        for (uint32 i = 0; i < head.columnCount; i++) {
+            const ColumnEntry& column = columns()[i];
+            const uint64 width = column.type == COLUMN_U8 ? 1 : 4;
+            if (column.dataOffset + column.rows * width > size
+                || column.statsOffset + blockCount(column.rows) * sizeof(BlockStats) > size
+                || (column.type == COLUMN_DICT
+                    && column.dictOffset + (column.dictCount + 1ULL) * sizeof(uint32) + column.dictBytes > size)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const FileHeader& header() const
+    {
+        return *(const FileHeader*)base;
+    }
+
+    const ColumnEntry* columns() const
+    {
+        return (const ColumnEntry*)(base + sizeof(FileHeader));
+    }
+
+    const ColumnEntry* find(const char* table, const char* name) const
+    {
+        for (uint32 i = 0; i < header().columnCount; i++) {
+            const ColumnEntry& column = columns()[i];
+            if (!strncmp(column.table, table, sizeof(column.table)) && !strncmp(column.name, name, sizeof(column.name))) {
+                return &column;
+            }
+        }
+        return nullptr;
+    }
+
+    template <typename T>
+    const T* values(const ColumnEntry& column) const
+    {
+        return (const T*)(base + column.dataOffset);
+    }
+
+    const BlockStats* stats(const ColumnEntry& column) const
+    {
+        return (const BlockStats*)(base + column.statsOffset);
+    }
+
+    std::string_view dictionaryValue(const ColumnEntry& column, uint32 code) const
+    {
+        const uint32* offsets = (const uint32*)(base + column.dictOffset);
+        const char* strings = (const char*)(offsets + column.dictCount + 1);
+        return std::string_view(strings + offsets[code], offsets[code + 1] - offsets[code]);
+    }
+
+private:
+    const uint8* base = nullptr;
+    size_t size = 0;
+};
+
+} // namespace columnar
@@ -0,0 +1,100 @@
+// In-process host for the PredictoR contract (qubic-contracts/HM25.h).
+// Owns the contract state, runs Initialize and dispatches entry points by
+// function index the way the node does, so native tools can drive the real
+// contract code without a Qubic node.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+
+#include "contract_layout.h"
+
+class ContractHost
+{
+public:
+    // operatorId is the invocator of Initialize and so becomes the contract admin
+    explicit ContractHost(const m256i& operatorId)
+    {
+        // Contract state starts zeroed, as it does on chain
+        const size_t size = (sizeof(PredictoR) + alignof(PredictoR) - 1) / alignof(PredictoR) * alignof(PredictoR);
+        contract = (PredictoR*)aligned_alloc(alignof(PredictoR), size);
+        memset((void*)contract, 0, size);
+        PredictoR::registerEntryPoints(entryPoints);
+
+        uint32 largestInput = 1;
+        for (uint16 i = 0; i < contract_abi::FUNCTION_COUNT; i++) {
+            if (contract_abi::FUNCTIONS[i].inputSize > largestInput) {
+                largestInput = contract_abi::FUNCTIONS[i].inputSize;
+            }
+        }
+        inputScratch.resize((largestInput + 7) / 8);
+
+        contract->currentInvocator = operatorId;
+        uint64 unused = 0;
+        (contract->*entryPoints.procedures[0])(&unused, &unused);
+    }
+
+    ~ContractHost()
+    {
+        free(contract);
+    }
+
+    ContractHost(const ContractHost&) = delete;
+    ContractHost& operator=(const ContractHost&) = delete;
+
+    PredictoR& instance()
+    {
+        return *contract;
+    }
+
+    const ContractSystem& system() const
+    {
+        return contract->system;
+    }
+
+    void advanceTick()
+    {
+        contract->system.tick++;
+    }
+
+    // Runs END_EPOCH, moves to the next epoch and runs BEGIN_EPOCH
+    void advanceEpoch()
+    {
+        contract->endEpoch();
+        contract->system.epoch++;
+        contract->beginEpoch();
+    }
+
+    const contract_abi::FunctionInfo* function(uint16 index) const
+    {
+        const contract_abi::FunctionInfo* info = contract_abi::findFunction(index);
+        return info && entryPoints.functions[index] ? info : nullptr;
+    }
+
+    // Runs function `index` as `invocator`. Short input is zero-padded to the
+    // input struct size; output must hold function(index)->outputSize bytes.
+    // Returns false for an unknown function index.
+    bool call(uint16 index, const m256i& invocator, const void* input, uint32 inputSize, void* output)
+    {
+        const contract_abi::FunctionInfo* info = function(index);
+        if (!info) {
+            return false;
+        }
+
+        uint8* scratch = (uint8*)inputScratch.data();
+        const uint32 copied = inputSize < info->inputSize ? inputSize : info->inputSize;
+        memcpy(scratch, input, copied);
+        memset(scratch + copied, 0, info->inputSize - copied);
+        memset(output, 0, info->outputSize);
+
+        contract->currentInvocator = invocator;
+        (contract->*entryPoints.functions[index])(scratch, output);
+        return true;
+    }
+
+private:
+    PredictoR* contract;
+    ContractEntryPoints<PredictoR> entryPoints;
+    std::vector<uint64> inputScratch;  // uint64 elements keep the input struct aligned
+};
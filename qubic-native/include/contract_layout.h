@@ -0,0 +1,974 @@
+// Generated by qubic-bridge/generate-contract-layout.ts from contract-schema.ts.
+// Do not edit by hand; run `npm run qubic:layout` after changing the schema.
+
+#pragma once
+
+#include <cstddef>
+
+#include "../../qubic-contracts/HM25.h"
+
+// Compiler layout must match the schema the bridge codec encodes with
+static_assert(sizeof(RegisterUserInput) == 64, "RegisterUserInput size differs from contract-schema.ts");
+static_assert(alignof(RegisterUserInput) == 1, "RegisterUserInput alignment differs from contract-schema.ts");
+static_assert(offsetof(RegisterUserInput, username) == 0, "RegisterUserInput::username offset differs from contract-schema.ts");
+static_assert(sizeof(RegisterUserInput::username) == 32, "RegisterUserInput::username size differs from contract-schema.ts");
+static_assert(offsetof(RegisterUserInput, passwordHash) == 32, "RegisterUserInput::passwordHash offset differs from contract-schema.ts");
+static_assert(sizeof(RegisterUserInput::passwordHash) == 32, "RegisterUserInput::passwordHash size differs from contract-schema.ts");
+
+static_assert(sizeof(RegisterUserOutput) == 12, "RegisterUserOutput size differs from contract-schema.ts");
+static_assert(alignof(RegisterUserOutput) == 4, "RegisterUserOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(RegisterUserOutput, userId) == 0, "RegisterUserOutput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(RegisterUserOutput::userId) == 4, "RegisterUserOutput::userId size differs from contract-schema.ts");
+static_assert(offsetof(RegisterUserOutput, balance) == 4, "RegisterUserOutput::balance offset differs from contract-schema.ts");
+static_assert(sizeof(RegisterUserOutput::balance) == 4, "RegisterUserOutput::balance size differs from contract-schema.ts");
+static_assert(offsetof(RegisterUserOutput, success) == 8, "RegisterUserOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(RegisterUserOutput::success) == 1, "RegisterUserOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(CreateEventInput) == 424, "CreateEventInput size differs from contract-schema.ts");
+static_assert(alignof(CreateEventInput) == 4, "CreateEventInput alignment differs from contract-schema.ts");
+static_assert(offsetof(CreateEventInput, title) == 0, "CreateEventInput::title offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventInput::title) == 128, "CreateEventInput::title size differs from contract-schema.ts");
+static_assert(offsetof(CreateEventInput, description) == 128, "CreateEventInput::description offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventInput::description) == 256, "CreateEventInput::description size differs from contract-schema.ts");
+static_assert(offsetof(CreateEventInput, category) == 384, "CreateEventInput::category offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventInput::category) == 32, "CreateEventInput::category size differs from contract-schema.ts");
+static_assert(offsetof(CreateEventInput, endsAt) == 416, "CreateEventInput::endsAt offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventInput::endsAt) == 4, "CreateEventInput::endsAt size differs from contract-schema.ts");
+static_assert(offsetof(CreateEventInput, outcomeCount) == 420, "CreateEventInput::outcomeCount offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventInput::outcomeCount) == 1, "CreateEventInput::outcomeCount size differs from contract-schema.ts");
+
+static_assert(sizeof(CreateEventOutput) == 8, "CreateEventOutput size differs from contract-schema.ts");
+static_assert(alignof(CreateEventOutput) == 4, "CreateEventOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(CreateEventOutput, eventId) == 0, "CreateEventOutput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventOutput::eventId) == 4, "CreateEventOutput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(CreateEventOutput, success) == 4, "CreateEventOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(CreateEventOutput::success) == 1, "CreateEventOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(PlaceBetInput) == 16, "PlaceBetInput size differs from contract-schema.ts");
+static_assert(alignof(PlaceBetInput) == 4, "PlaceBetInput alignment differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetInput, userId) == 0, "PlaceBetInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetInput::userId) == 4, "PlaceBetInput::userId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetInput, eventId) == 4, "PlaceBetInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetInput::eventId) == 4, "PlaceBetInput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetInput, prediction) == 8, "PlaceBetInput::prediction offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetInput::prediction) == 1, "PlaceBetInput::prediction size differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetInput, amount) == 12, "PlaceBetInput::amount offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetInput::amount) == 4, "PlaceBetInput::amount size differs from contract-schema.ts");
+
+static_assert(sizeof(PlaceBetOutput) == 12, "PlaceBetOutput size differs from contract-schema.ts");
+static_assert(alignof(PlaceBetOutput) == 4, "PlaceBetOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetOutput, betId) == 0, "PlaceBetOutput::betId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetOutput::betId) == 4, "PlaceBetOutput::betId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetOutput, newBalance) == 4, "PlaceBetOutput::newBalance offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetOutput::newBalance) == 4, "PlaceBetOutput::newBalance size differs from contract-schema.ts");
+static_assert(offsetof(PlaceBetOutput, success) == 8, "PlaceBetOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceBetOutput::success) == 1, "PlaceBetOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(ResolveEventInput) == 8, "ResolveEventInput size differs from contract-schema.ts");
+static_assert(alignof(ResolveEventInput) == 4, "ResolveEventInput alignment differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventInput, eventId) == 0, "ResolveEventInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventInput::eventId) == 4, "ResolveEventInput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventInput, correctAnswer) == 4, "ResolveEventInput::correctAnswer offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventInput::correctAnswer) == 1, "ResolveEventInput::correctAnswer size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventInput, confidence) == 5, "ResolveEventInput::confidence offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventInput::confidence) == 1, "ResolveEventInput::confidence size differs from contract-schema.ts");
+
+static_assert(sizeof(ResolveEventOutput) == 12, "ResolveEventOutput size differs from contract-schema.ts");
+static_assert(alignof(ResolveEventOutput) == 4, "ResolveEventOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventOutput, winnersCount) == 0, "ResolveEventOutput::winnersCount offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventOutput::winnersCount) == 4, "ResolveEventOutput::winnersCount size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventOutput, totalPayout) == 4, "ResolveEventOutput::totalPayout offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventOutput::totalPayout) == 4, "ResolveEventOutput::totalPayout size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventOutput, success) == 8, "ResolveEventOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventOutput::success) == 1, "ResolveEventOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetBalanceInput) == 4, "GetBalanceInput size differs from contract-schema.ts");
+static_assert(alignof(GetBalanceInput) == 4, "GetBalanceInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetBalanceInput, userId) == 0, "GetBalanceInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(GetBalanceInput::userId) == 4, "GetBalanceInput::userId size differs from contract-schema.ts");
+
+static_assert(sizeof(GetBalanceOutput) == 8, "GetBalanceOutput size differs from contract-schema.ts");
+static_assert(alignof(GetBalanceOutput) == 4, "GetBalanceOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetBalanceOutput, balance) == 0, "GetBalanceOutput::balance offset differs from contract-schema.ts");
+static_assert(sizeof(GetBalanceOutput::balance) == 4, "GetBalanceOutput::balance size differs from contract-schema.ts");
+static_assert(offsetof(GetBalanceOutput, success) == 4, "GetBalanceOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetBalanceOutput::success) == 1, "GetBalanceOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetEventsInput) == 8, "GetEventsInput size differs from contract-schema.ts");
+static_assert(alignof(GetEventsInput) == 4, "GetEventsInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetEventsInput, startIndex) == 0, "GetEventsInput::startIndex offset differs from contract-schema.ts");
+static_assert(sizeof(GetEventsInput::startIndex) == 4, "GetEventsInput::startIndex size differs from contract-schema.ts");
+static_assert(offsetof(GetEventsInput, count) == 4, "GetEventsInput::count offset differs from contract-schema.ts");
+static_assert(sizeof(GetEventsInput::count) == 4, "GetEventsInput::count size differs from contract-schema.ts");
+
+static_assert(sizeof(GetEventsOutput) == 1008, "GetEventsOutput size differs from contract-schema.ts");
+static_assert(alignof(GetEventsOutput) == 4, "GetEventsOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetEventsOutput, eventCount) == 0, "GetEventsOutput::eventCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetEventsOutput::eventCount) == 4, "GetEventsOutput::eventCount size differs from contract-schema.ts");
+static_assert(offsetof(GetEventsOutput, events) == 4, "GetEventsOutput::events offset differs from contract-schema.ts");
+static_assert(sizeof(GetEventsOutput::events) == 1000, "GetEventsOutput::events size differs from contract-schema.ts");
+static_assert(offsetof(GetEventsOutput, success) == 1004, "GetEventsOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetEventsOutput::success) == 1, "GetEventsOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetContractStatsInput) == 1, "GetContractStatsInput size differs from contract-schema.ts");
+static_assert(alignof(GetContractStatsInput) == 1, "GetContractStatsInput alignment differs from contract-schema.ts");
+
+static_assert(sizeof(GetContractStatsOutput) == 432, "GetContractStatsOutput size differs from contract-schema.ts");
+static_assert(alignof(GetContractStatsOutput) == 8, "GetContractStatsOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, invocationCount) == 0, "GetContractStatsOutput::invocationCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::invocationCount) == 88, "GetContractStatsOutput::invocationCount size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, rejectionCount) == 88, "GetContractStatsOutput::rejectionCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::rejectionCount) == 56, "GetContractStatsOutput::rejectionCount size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, elementsScanned) == 144, "GetContractStatsOutput::elementsScanned offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::elementsScanned) == 176, "GetContractStatsOutput::elementsScanned size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, lastElementsScanned) == 320, "GetContractStatsOutput::lastElementsScanned offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::lastElementsScanned) == 88, "GetContractStatsOutput::lastElementsScanned size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, settlementBacklog) == 408, "GetContractStatsOutput::settlementBacklog offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::settlementBacklog) == 4, "GetContractStatsOutput::settlementBacklog size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, userCount) == 412, "GetContractStatsOutput::userCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::userCount) == 4, "GetContractStatsOutput::userCount size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, eventCount) == 416, "GetContractStatsOutput::eventCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::eventCount) == 4, "GetContractStatsOutput::eventCount size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, betCount) == 420, "GetContractStatsOutput::betCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::betCount) == 4, "GetContractStatsOutput::betCount size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, totalVolume) == 424, "GetContractStatsOutput::totalVolume offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::totalVolume) == 4, "GetContractStatsOutput::totalVolume size differs from contract-schema.ts");
+static_assert(offsetof(GetContractStatsOutput, success) == 428, "GetContractStatsOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetContractStatsOutput::success) == 1, "GetContractStatsOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(PlaceOrderInput) == 16, "PlaceOrderInput size differs from contract-schema.ts");
+static_assert(alignof(PlaceOrderInput) == 4, "PlaceOrderInput alignment differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderInput, userId) == 0, "PlaceOrderInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderInput::userId) == 4, "PlaceOrderInput::userId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderInput, eventId) == 4, "PlaceOrderInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderInput::eventId) == 4, "PlaceOrderInput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderInput, quantity) == 8, "PlaceOrderInput::quantity offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderInput::quantity) == 4, "PlaceOrderInput::quantity size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderInput, side) == 12, "PlaceOrderInput::side offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderInput::side) == 1, "PlaceOrderInput::side size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderInput, price) == 13, "PlaceOrderInput::price offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderInput::price) == 1, "PlaceOrderInput::price size differs from contract-schema.ts");
+
+static_assert(sizeof(PlaceOrderOutput) == 24, "PlaceOrderOutput size differs from contract-schema.ts");
+static_assert(alignof(PlaceOrderOutput) == 4, "PlaceOrderOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, orderId) == 0, "PlaceOrderOutput::orderId offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::orderId) == 4, "PlaceOrderOutput::orderId size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, filledQuantity) == 4, "PlaceOrderOutput::filledQuantity offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::filledQuantity) == 4, "PlaceOrderOutput::filledQuantity size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, restingQuantity) == 8, "PlaceOrderOutput::restingQuantity offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::restingQuantity) == 4, "PlaceOrderOutput::restingQuantity size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, fillCost) == 12, "PlaceOrderOutput::fillCost offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::fillCost) == 4, "PlaceOrderOutput::fillCost size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, newBalance) == 16, "PlaceOrderOutput::newBalance offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::newBalance) == 4, "PlaceOrderOutput::newBalance size differs from contract-schema.ts");
+static_assert(offsetof(PlaceOrderOutput, success) == 20, "PlaceOrderOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(PlaceOrderOutput::success) == 1, "PlaceOrderOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(CancelOrderInput) == 8, "CancelOrderInput size differs from contract-schema.ts");
+static_assert(alignof(CancelOrderInput) == 4, "CancelOrderInput alignment differs from contract-schema.ts");
+static_assert(offsetof(CancelOrderInput, userId) == 0, "CancelOrderInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(CancelOrderInput::userId) == 4, "CancelOrderInput::userId size differs from contract-schema.ts");
+static_assert(offsetof(CancelOrderInput, orderId) == 4, "CancelOrderInput::orderId offset differs from contract-schema.ts");
+static_assert(sizeof(CancelOrderInput::orderId) == 4, "CancelOrderInput::orderId size differs from contract-schema.ts");
+
+static_assert(sizeof(CancelOrderOutput) == 12, "CancelOrderOutput size differs from contract-schema.ts");
+static_assert(alignof(CancelOrderOutput) == 4, "CancelOrderOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(CancelOrderOutput, refund) == 0, "CancelOrderOutput::refund offset differs from contract-schema.ts");
+static_assert(sizeof(CancelOrderOutput::refund) == 4, "CancelOrderOutput::refund size differs from contract-schema.ts");
+static_assert(offsetof(CancelOrderOutput, newBalance) == 4, "CancelOrderOutput::newBalance offset differs from contract-schema.ts");
+static_assert(sizeof(CancelOrderOutput::newBalance) == 4, "CancelOrderOutput::newBalance size differs from contract-schema.ts");
+static_assert(offsetof(CancelOrderOutput, success) == 8, "CancelOrderOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(CancelOrderOutput::success) == 1, "CancelOrderOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetBestBidAskInput) == 4, "GetBestBidAskInput size differs from contract-schema.ts");
+static_assert(alignof(GetBestBidAskInput) == 4, "GetBestBidAskInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskInput, eventId) == 0, "GetBestBidAskInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskInput::eventId) == 4, "GetBestBidAskInput::eventId size differs from contract-schema.ts");
+
+static_assert(sizeof(GetBestBidAskOutput) == 12, "GetBestBidAskOutput size differs from contract-schema.ts");
+static_assert(alignof(GetBestBidAskOutput) == 4, "GetBestBidAskOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskOutput, bidQuantity) == 0, "GetBestBidAskOutput::bidQuantity offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskOutput::bidQuantity) == 4, "GetBestBidAskOutput::bidQuantity size differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskOutput, askQuantity) == 4, "GetBestBidAskOutput::askQuantity offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskOutput::askQuantity) == 4, "GetBestBidAskOutput::askQuantity size differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskOutput, bestBid) == 8, "GetBestBidAskOutput::bestBid offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskOutput::bestBid) == 1, "GetBestBidAskOutput::bestBid size differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskOutput, bestAsk) == 9, "GetBestBidAskOutput::bestAsk offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskOutput::bestAsk) == 1, "GetBestBidAskOutput::bestAsk size differs from contract-schema.ts");
+static_assert(offsetof(GetBestBidAskOutput, success) == 10, "GetBestBidAskOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetBestBidAskOutput::success) == 1, "GetBestBidAskOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(EnableMarketMakerInput) == 8, "EnableMarketMakerInput size differs from contract-schema.ts");
+static_assert(alignof(EnableMarketMakerInput) == 4, "EnableMarketMakerInput alignment differs from contract-schema.ts");
+static_assert(offsetof(EnableMarketMakerInput, eventId) == 0, "EnableMarketMakerInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(EnableMarketMakerInput::eventId) == 4, "EnableMarketMakerInput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(EnableMarketMakerInput, liquidity) == 4, "EnableMarketMakerInput::liquidity offset differs from contract-schema.ts");
+static_assert(sizeof(EnableMarketMakerInput::liquidity) == 4, "EnableMarketMakerInput::liquidity size differs from contract-schema.ts");
+
+static_assert(sizeof(EnableMarketMakerOutput) == 1, "EnableMarketMakerOutput size differs from contract-schema.ts");
+static_assert(alignof(EnableMarketMakerOutput) == 1, "EnableMarketMakerOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(EnableMarketMakerOutput, success) == 0, "EnableMarketMakerOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(EnableMarketMakerOutput::success) == 1, "EnableMarketMakerOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(QuoteBetInput) == 12, "QuoteBetInput size differs from contract-schema.ts");
+static_assert(alignof(QuoteBetInput) == 4, "QuoteBetInput alignment differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetInput, eventId) == 0, "QuoteBetInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetInput::eventId) == 4, "QuoteBetInput::eventId size differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetInput, amount) == 4, "QuoteBetInput::amount offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetInput::amount) == 4, "QuoteBetInput::amount size differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetInput, prediction) == 8, "QuoteBetInput::prediction offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetInput::prediction) == 1, "QuoteBetInput::prediction size differs from contract-schema.ts");
+
+static_assert(sizeof(QuoteBetOutput) == 12, "QuoteBetOutput size differs from contract-schema.ts");
+static_assert(alignof(QuoteBetOutput) == 4, "QuoteBetOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetOutput, cost) == 0, "QuoteBetOutput::cost offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetOutput::cost) == 4, "QuoteBetOutput::cost size differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetOutput, yesPriceBps) == 4, "QuoteBetOutput::yesPriceBps offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetOutput::yesPriceBps) == 4, "QuoteBetOutput::yesPriceBps size differs from contract-schema.ts");
+static_assert(offsetof(QuoteBetOutput, success) == 8, "QuoteBetOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(QuoteBetOutput::success) == 1, "QuoteBetOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(ConfigureShardInput) == 8, "ConfigureShardInput size differs from contract-schema.ts");
+static_assert(alignof(ConfigureShardInput) == 4, "ConfigureShardInput alignment differs from contract-schema.ts");
+static_assert(offsetof(ConfigureShardInput, shardIndex) == 0, "ConfigureShardInput::shardIndex offset differs from contract-schema.ts");
+static_assert(sizeof(ConfigureShardInput::shardIndex) == 4, "ConfigureShardInput::shardIndex size differs from contract-schema.ts");
+static_assert(offsetof(ConfigureShardInput, shardCount) == 4, "ConfigureShardInput::shardCount offset differs from contract-schema.ts");
+static_assert(sizeof(ConfigureShardInput::shardCount) == 4, "ConfigureShardInput::shardCount size differs from contract-schema.ts");
+
+static_assert(sizeof(ConfigureShardOutput) == 1, "ConfigureShardOutput size differs from contract-schema.ts");
+static_assert(alignof(ConfigureShardOutput) == 1, "ConfigureShardOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(ConfigureShardOutput, success) == 0, "ConfigureShardOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(ConfigureShardOutput::success) == 1, "ConfigureShardOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(ShardTransferInput) == 8, "ShardTransferInput size differs from contract-schema.ts");
+static_assert(alignof(ShardTransferInput) == 4, "ShardTransferInput alignment differs from contract-schema.ts");
+static_assert(offsetof(ShardTransferInput, userId) == 0, "ShardTransferInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(ShardTransferInput::userId) == 4, "ShardTransferInput::userId size differs from contract-schema.ts");
+static_assert(offsetof(ShardTransferInput, amount) == 4, "ShardTransferInput::amount offset differs from contract-schema.ts");
+static_assert(sizeof(ShardTransferInput::amount) == 4, "ShardTransferInput::amount size differs from contract-schema.ts");
+
+static_assert(sizeof(ShardTransferOutput) == 8, "ShardTransferOutput size differs from contract-schema.ts");
+static_assert(alignof(ShardTransferOutput) == 4, "ShardTransferOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(ShardTransferOutput, newBalance) == 0, "ShardTransferOutput::newBalance offset differs from contract-schema.ts");
+static_assert(sizeof(ShardTransferOutput::newBalance) == 4, "ShardTransferOutput::newBalance size differs from contract-schema.ts");
+static_assert(offsetof(ShardTransferOutput, success) == 4, "ShardTransferOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(ShardTransferOutput::success) == 1, "ShardTransferOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(ResolveEventsInput) == 388, "ResolveEventsInput size differs from contract-schema.ts");
+static_assert(alignof(ResolveEventsInput) == 4, "ResolveEventsInput alignment differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsInput, eventIds) == 0, "ResolveEventsInput::eventIds offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsInput::eventIds) == 256, "ResolveEventsInput::eventIds size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsInput, correctAnswers) == 256, "ResolveEventsInput::correctAnswers offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsInput::correctAnswers) == 64, "ResolveEventsInput::correctAnswers size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsInput, confidences) == 320, "ResolveEventsInput::confidences offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsInput::confidences) == 64, "ResolveEventsInput::confidences size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsInput, count) == 384, "ResolveEventsInput::count offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsInput::count) == 1, "ResolveEventsInput::count size differs from contract-schema.ts");
+
+static_assert(sizeof(ResolveEventsOutput) == 580, "ResolveEventsOutput size differs from contract-schema.ts");
+static_assert(alignof(ResolveEventsOutput) == 4, "ResolveEventsOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsOutput, winnersCount) == 0, "ResolveEventsOutput::winnersCount offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsOutput::winnersCount) == 256, "ResolveEventsOutput::winnersCount size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsOutput, totalPayout) == 256, "ResolveEventsOutput::totalPayout offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsOutput::totalPayout) == 256, "ResolveEventsOutput::totalPayout size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsOutput, resolved) == 512, "ResolveEventsOutput::resolved offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsOutput::resolved) == 64, "ResolveEventsOutput::resolved size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsOutput, resolvedCount) == 576, "ResolveEventsOutput::resolvedCount offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsOutput::resolvedCount) == 1, "ResolveEventsOutput::resolvedCount size differs from contract-schema.ts");
+static_assert(offsetof(ResolveEventsOutput, success) == 577, "ResolveEventsOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(ResolveEventsOutput::success) == 1, "ResolveEventsOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetLeaderboardInput) == 4, "GetLeaderboardInput size differs from contract-schema.ts");
+static_assert(alignof(GetLeaderboardInput) == 4, "GetLeaderboardInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardInput, count) == 0, "GetLeaderboardInput::count offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardInput::count) == 4, "GetLeaderboardInput::count size differs from contract-schema.ts");
+
+static_assert(sizeof(GetLeaderboardOutput) == 808, "GetLeaderboardOutput size differs from contract-schema.ts");
+static_assert(alignof(GetLeaderboardOutput) == 4, "GetLeaderboardOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, userIds) == 0, "GetLeaderboardOutput::userIds offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::userIds) == 200, "GetLeaderboardOutput::userIds size differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, totalWins) == 200, "GetLeaderboardOutput::totalWins offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::totalWins) == 200, "GetLeaderboardOutput::totalWins size differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, totalBets) == 400, "GetLeaderboardOutput::totalBets offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::totalBets) == 200, "GetLeaderboardOutput::totalBets size differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, balances) == 600, "GetLeaderboardOutput::balances offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::balances) == 200, "GetLeaderboardOutput::balances size differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, count) == 800, "GetLeaderboardOutput::count offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::count) == 4, "GetLeaderboardOutput::count size differs from contract-schema.ts");
+static_assert(offsetof(GetLeaderboardOutput, success) == 804, "GetLeaderboardOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetLeaderboardOutput::success) == 1, "GetLeaderboardOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetUserSummaryInput) == 4, "GetUserSummaryInput size differs from contract-schema.ts");
+static_assert(alignof(GetUserSummaryInput) == 4, "GetUserSummaryInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryInput, userId) == 0, "GetUserSummaryInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryInput::userId) == 4, "GetUserSummaryInput::userId size differs from contract-schema.ts");
+
+static_assert(sizeof(GetUserSummaryOutput) == 40, "GetUserSummaryOutput size differs from contract-schema.ts");
+static_assert(alignof(GetUserSummaryOutput) == 8, "GetUserSummaryOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, openStake) == 0, "GetUserSummaryOutput::openStake offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::openStake) == 8, "GetUserSummaryOutput::openStake size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, realizedPnl) == 8, "GetUserSummaryOutput::realizedPnl offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::realizedPnl) == 8, "GetUserSummaryOutput::realizedPnl size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, balance) == 16, "GetUserSummaryOutput::balance offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::balance) == 4, "GetUserSummaryOutput::balance size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, totalBets) == 20, "GetUserSummaryOutput::totalBets offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::totalBets) == 4, "GetUserSummaryOutput::totalBets size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, totalWins) == 24, "GetUserSummaryOutput::totalWins offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::totalWins) == 4, "GetUserSummaryOutput::totalWins size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, openBets) == 28, "GetUserSummaryOutput::openBets offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::openBets) == 4, "GetUserSummaryOutput::openBets size differs from contract-schema.ts");
+static_assert(offsetof(GetUserSummaryOutput, success) == 32, "GetUserSummaryOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetUserSummaryOutput::success) == 1, "GetUserSummaryOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(GetOutcomeTallyInput) == 4, "GetOutcomeTallyInput size differs from contract-schema.ts");
+static_assert(alignof(GetOutcomeTallyInput) == 4, "GetOutcomeTallyInput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyInput, eventId) == 0, "GetOutcomeTallyInput::eventId offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyInput::eventId) == 4, "GetOutcomeTallyInput::eventId size differs from contract-schema.ts");
+
+static_assert(sizeof(GetOutcomeTallyOutput) == 72, "GetOutcomeTallyOutput size differs from contract-schema.ts");
+static_assert(alignof(GetOutcomeTallyOutput) == 4, "GetOutcomeTallyOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, bets) == 0, "GetOutcomeTallyOutput::bets offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::bets) == 64, "GetOutcomeTallyOutput::bets size differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, outcomeCount) == 64, "GetOutcomeTallyOutput::outcomeCount offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::outcomeCount) == 1, "GetOutcomeTallyOutput::outcomeCount size differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, isResolved) == 65, "GetOutcomeTallyOutput::isResolved offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::isResolved) == 1, "GetOutcomeTallyOutput::isResolved size differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, correctAnswer) == 66, "GetOutcomeTallyOutput::correctAnswer offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::correctAnswer) == 1, "GetOutcomeTallyOutput::correctAnswer size differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, hasMarketMaker) == 67, "GetOutcomeTallyOutput::hasMarketMaker offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::hasMarketMaker) == 1, "GetOutcomeTallyOutput::hasMarketMaker size differs from contract-schema.ts");
+static_assert(offsetof(GetOutcomeTallyOutput, success) == 68, "GetOutcomeTallyOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(GetOutcomeTallyOutput::success) == 1, "GetOutcomeTallyOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(UnregisterUserInput) == 4, "UnregisterUserInput size differs from contract-schema.ts");
+static_assert(alignof(UnregisterUserInput) == 4, "UnregisterUserInput alignment differs from contract-schema.ts");
+static_assert(offsetof(UnregisterUserInput, userId) == 0, "UnregisterUserInput::userId offset differs from contract-schema.ts");
+static_assert(sizeof(UnregisterUserInput::userId) == 4, "UnregisterUserInput::userId size differs from contract-schema.ts");
+
+static_assert(sizeof(UnregisterUserOutput) == 1, "UnregisterUserOutput size differs from contract-schema.ts");
+static_assert(alignof(UnregisterUserOutput) == 1, "UnregisterUserOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(UnregisterUserOutput, success) == 0, "UnregisterUserOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(UnregisterUserOutput::success) == 1, "UnregisterUserOutput::success size differs from contract-schema.ts");
+
+static_assert(sizeof(SetMaxOpenStakeInput) == 4, "SetMaxOpenStakeInput size differs from contract-schema.ts");
+static_assert(alignof(SetMaxOpenStakeInput) == 4, "SetMaxOpenStakeInput alignment differs from contract-schema.ts");
+static_assert(offsetof(SetMaxOpenStakeInput, maxOpenStake) == 0, "SetMaxOpenStakeInput::maxOpenStake offset differs from contract-schema.ts");
+static_assert(sizeof(SetMaxOpenStakeInput::maxOpenStake) == 4, "SetMaxOpenStakeInput::maxOpenStake size differs from contract-schema.ts");
+
+static_assert(sizeof(SetMaxOpenStakeOutput) == 1, "SetMaxOpenStakeOutput size differs from contract-schema.ts");
+static_assert(alignof(SetMaxOpenStakeOutput) == 1, "SetMaxOpenStakeOutput alignment differs from contract-schema.ts");
+static_assert(offsetof(SetMaxOpenStakeOutput, success) == 0, "SetMaxOpenStakeOutput::success offset differs from contract-schema.ts");
+static_assert(sizeof(SetMaxOpenStakeOutput::success) == 1, "SetMaxOpenStakeOutput::success size differs from contract-schema.ts");
+
+namespace contract_abi
+{
+
+struct StructInfo
+{
+    uint16 id;
+    const char* name;
+    uint32 size;
+    uint32 align;
+};
+
+struct FunctionInfo
+{
+    uint16 index;
+    const char* name;
+    uint16 inputStruct;
+    uint16 outputStruct;
+    uint32 inputSize;
+    uint32 outputSize;
+};
+
+constexpr uint16 STRUCT_COUNT = 40;
+constexpr uint16 FUNCTION_COUNT = 22;
+
+constexpr StructInfo STRUCTS[STRUCT_COUNT] = {
+    { 0, "RegisterUserInput", sizeof(RegisterUserInput), alignof(RegisterUserInput) },
+    { 1, "RegisterUserOutput", sizeof(RegisterUserOutput), alignof(RegisterUserOutput) },
+    { 2, "CreateEventInput", sizeof(CreateEventInput), alignof(CreateEventInput) },
+    { 3, "CreateEventOutput", sizeof(CreateEventOutput), alignof(CreateEventOutput) },
+    { 4, "PlaceBetInput", sizeof(PlaceBetInput), alignof(PlaceBetInput) },
+    { 5, "PlaceBetOutput", sizeof(PlaceBetOutput), alignof(PlaceBetOutput) },
+    { 6, "ResolveEventInput", sizeof(ResolveEventInput), alignof(ResolveEventInput) },
+    { 7, "ResolveEventOutput", sizeof(ResolveEventOutput), alignof(ResolveEventOutput) },
+    { 8, "GetBalanceInput", sizeof(GetBalanceInput), alignof(GetBalanceInput) },
+    { 9, "GetBalanceOutput", sizeof(GetBalanceOutput), alignof(GetBalanceOutput) },
+    { 10, "GetEventsInput", sizeof(GetEventsInput), alignof(GetEventsInput) },
+    { 11, "GetEventsOutput", sizeof(GetEventsOutput), alignof(GetEventsOutput) },
+    { 12, "GetContractStatsInput", sizeof(GetContractStatsInput), alignof(GetContractStatsInput) },
+    { 13, "GetContractStatsOutput", sizeof(GetContractStatsOutput), alignof(GetContractStatsOutput) },
+    { 14, "PlaceOrderInput", sizeof(PlaceOrderInput), alignof(PlaceOrderInput) },
+    { 15, "PlaceOrderOutput", sizeof(PlaceOrderOutput), alignof(PlaceOrderOutput) },
+    { 16, "CancelOrderInput", sizeof(CancelOrderInput), alignof(CancelOrderInput) },
+    { 17, "CancelOrderOutput", sizeof(CancelOrderOutput), alignof(CancelOrderOutput) },
+    { 18, "GetBestBidAskInput", sizeof(GetBestBidAskInput), alignof(GetBestBidAskInput) },
+    { 19, "GetBestBidAskOutput", sizeof(GetBestBidAskOutput), alignof(GetBestBidAskOutput) },
+    { 20, "EnableMarketMakerInput", sizeof(EnableMarketMakerInput), alignof(EnableMarketMakerInput) },
+    { 21, "EnableMarketMakerOutput", sizeof(EnableMarketMakerOutput), alignof(EnableMarketMakerOutput) },
+    { 22, "QuoteBetInput", sizeof(QuoteBetInput), alignof(QuoteBetInput) },
+    { 23, "QuoteBetOutput", sizeof(QuoteBetOutput), alignof(QuoteBetOutput) },
+    { 24, "ConfigureShardInput", sizeof(ConfigureShardInput), alignof(ConfigureShardInput) },
+    { 25, "ConfigureShardOutput", sizeof(ConfigureShardOutput), alignof(ConfigureShardOutput) },
+    { 26, "ShardTransferInput", sizeof(ShardTransferInput), alignof(ShardTransferInput) },
+    { 27, "ShardTransferOutput", sizeof(ShardTransferOutput), alignof(ShardTransferOutput) },
+    { 28, "ResolveEventsInput", sizeof(ResolveEventsInput), alignof(ResolveEventsInput) },
+    { 29, "ResolveEventsOutput", sizeof(ResolveEventsOutput), alignof(ResolveEventsOutput) },
+    { 30, "GetLeaderboardInput", sizeof(GetLeaderboardInput), alignof(GetLeaderboardInput) },
+    { 31, "GetLeaderboardOutput", sizeof(GetLeaderboardOutput), alignof(GetLeaderboardOutput) },
+    { 32, "GetUserSummaryInput", sizeof(GetUserSummaryInput), alignof(GetUserSummaryInput) },
+    { 33, "GetUserSummaryOutput", sizeof(GetUserSummaryOutput), alignof(GetUserSummaryOutput) },
+    { 34, "GetOutcomeTallyInput", sizeof(GetOutcomeTallyInput), alignof(GetOutcomeTallyInput) },
+    { 35, "GetOutcomeTallyOutput", sizeof(GetOutcomeTallyOutput), alignof(GetOutcomeTallyOutput) },
+    { 36, "UnregisterUserInput", sizeof(UnregisterUserInput), alignof(UnregisterUserInput) },
+    { 37, "UnregisterUserOutput", sizeof(UnregisterUserOutput), alignof(UnregisterUserOutput) },
+    { 38, "SetMaxOpenStakeInput", sizeof(SetMaxOpenStakeInput), alignof(SetMaxOpenStakeInput) },
+    { 39, "SetMaxOpenStakeOutput", sizeof(SetMaxOpenStakeOutput), alignof(SetMaxOpenStakeOutput) },
+};
+
+// Function indices by name; each equals its STAT_ counter slot in HM25.h
+constexpr uint16 FUNCTION_REGISTER_USER = 0;
+constexpr uint16 FUNCTION_CREATE_EVENT = 1;
+constexpr uint16 FUNCTION_PLACE_BET = 2;
+constexpr uint16 FUNCTION_RESOLVE_EVENT = 3;
+constexpr uint16 FUNCTION_GET_BALANCE = 4;
+constexpr uint16 FUNCTION_GET_EVENTS = 5;
+constexpr uint16 FUNCTION_GET_USER_BETS = 6;
+constexpr uint16 FUNCTION_GET_CONTRACT_STATS = 7;
+constexpr uint16 FUNCTION_PLACE_ORDER = 8;
+constexpr uint16 FUNCTION_CANCEL_ORDER = 9;
+constexpr uint16 FUNCTION_GET_BEST_BID_ASK = 10;
+constexpr uint16 FUNCTION_ENABLE_MARKET_MAKER = 11;
+constexpr uint16 FUNCTION_QUOTE_BET = 12;
+constexpr uint16 FUNCTION_CONFIGURE_SHARD = 13;
+constexpr uint16 FUNCTION_SHARD_TRANSFER_OUT = 14;
+constexpr uint16 FUNCTION_SHARD_TRANSFER_IN = 15;
+constexpr uint16 FUNCTION_RESOLVE_EVENTS = 16;
+constexpr uint16 FUNCTION_GET_LEADERBOARD = 17;
+constexpr uint16 FUNCTION_GET_USER_SUMMARY = 18;
+constexpr uint16 FUNCTION_GET_OUTCOME_TALLY = 19;
+constexpr uint16 FUNCTION_UNREGISTER_USER = 20;
+constexpr uint16 FUNCTION_SET_MAX_OPEN_STAKE = 21;
+
+static_assert(FUNCTION_REGISTER_USER == STAT_REGISTER_USER, "RegisterUser index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_CREATE_EVENT == STAT_CREATE_EVENT, "CreateEvent index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_PLACE_BET == STAT_PLACE_BET, "PlaceBet index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_RESOLVE_EVENT == STAT_RESOLVE_EVENT, "ResolveEvent index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_BALANCE == STAT_GET_BALANCE, "GetBalance index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_EVENTS == STAT_GET_EVENTS, "GetEvents index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_USER_BETS == STAT_GET_USER_BETS, "GetUserBets index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_CONTRACT_STATS == STAT_GET_CONTRACT_STATS, "GetContractStats index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_PLACE_ORDER == STAT_PLACE_ORDER, "PlaceOrder index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_CANCEL_ORDER == STAT_CANCEL_ORDER, "CancelOrder index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_BEST_BID_ASK == STAT_GET_BEST_BID_ASK, "GetBestBidAsk index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_ENABLE_MARKET_MAKER == STAT_ENABLE_MARKET_MAKER, "EnableMarketMaker index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_QUOTE_BET == STAT_QUOTE_BET, "QuoteBet index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_CONFIGURE_SHARD == STAT_CONFIGURE_SHARD, "ConfigureShard index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_SHARD_TRANSFER_OUT == STAT_SHARD_TRANSFER_OUT, "ShardTransferOut index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_SHARD_TRANSFER_IN == STAT_SHARD_TRANSFER_IN, "ShardTransferIn index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_RESOLVE_EVENTS == STAT_RESOLVE_EVENTS, "ResolveEvents index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_LEADERBOARD == STAT_GET_LEADERBOARD, "GetLeaderboard index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_USER_SUMMARY == STAT_GET_USER_SUMMARY, "GetUserSummary index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_GET_OUTCOME_TALLY == STAT_GET_OUTCOME_TALLY, "GetOutcomeTally index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_UNREGISTER_USER == STAT_UNREGISTER_USER, "UnregisterUser index differs between contract-schema.ts and HM25.h");
+static_assert(FUNCTION_SET_MAX_OPEN_STAKE == STAT_SET_MAX_OPEN_STAKE, "SetMaxOpenStake index differs between contract-schema.ts and HM25.h");
+
+constexpr FunctionInfo FUNCTIONS[FUNCTION_COUNT] = {
+    { 0, "RegisterUser", 0, 1, sizeof(RegisterUserInput), sizeof(RegisterUserOutput) },
+    { 1, "CreateEvent", 2, 3, sizeof(CreateEventInput), sizeof(CreateEventOutput) },
+    { 2, "PlaceBet", 4, 5, sizeof(PlaceBetInput), sizeof(PlaceBetOutput) },
+    { 3, "ResolveEvent", 6, 7, sizeof(ResolveEventInput), sizeof(ResolveEventOutput) },
+    { 4, "GetBalance", 8, 9, sizeof(GetBalanceInput), sizeof(GetBalanceOutput) },
+    { 5, "GetEvents", 10, 11, sizeof(GetEventsInput), sizeof(GetEventsOutput) },
+    { 6, "GetUserBets", 8, 9, sizeof(GetBalanceInput), sizeof(GetBalanceOutput) },
+    { 7, "GetContractStats", 12, 13, sizeof(GetContractStatsInput), sizeof(GetContractStatsOutput) },
+    { 8, "PlaceOrder", 14, 15, sizeof(PlaceOrderInput), sizeof(PlaceOrderOutput) },
+    { 9, "CancelOrder", 16, 17, sizeof(CancelOrderInput), sizeof(CancelOrderOutput) },
+    { 10, "GetBestBidAsk", 18, 19, sizeof(GetBestBidAskInput), sizeof(GetBestBidAskOutput) },
+    { 11, "EnableMarketMaker", 20, 21, sizeof(EnableMarketMakerInput), sizeof(EnableMarketMakerOutput) },
+    { 12, "QuoteBet", 22, 23, sizeof(QuoteBetInput), sizeof(QuoteBetOutput) },
+    { 13, "ConfigureShard", 24, 25, sizeof(ConfigureShardInput), sizeof(ConfigureShardOutput) },
+    { 14, "ShardTransferOut", 26, 27, sizeof(ShardTransferInput), sizeof(ShardTransferOutput) },
+    { 15, "ShardTransferIn", 26, 27, sizeof(ShardTransferInput), sizeof(ShardTransferOutput) },
+    { 16, "ResolveEvents", 28, 29, sizeof(ResolveEventsInput), sizeof(ResolveEventsOutput) },
+    { 17, "GetLeaderboard", 30, 31, sizeof(GetLeaderboardInput), sizeof(GetLeaderboardOutput) },
+    { 18, "GetUserSummary", 32, 33, sizeof(GetUserSummaryInput), sizeof(GetUserSummaryOutput) },
+    { 19, "GetOutcomeTally", 34, 35, sizeof(GetOutcomeTallyInput), sizeof(GetOutcomeTallyOutput) },
+    { 20, "UnregisterUser", 36, 37, sizeof(UnregisterUserInput), sizeof(UnregisterUserOutput) },
+    { 21, "SetMaxOpenStake", 38, 39, sizeof(SetMaxOpenStakeInput), sizeof(SetMaxOpenStakeOutput) },
+};
+
+inline const FunctionInfo* findFunction(uint16 index)
+{
+    for (uint16 i = 0; i < FUNCTION_COUNT; i++) {
+        if (FUNCTIONS[i].index == index) {
+            return &FUNCTIONS[i];
+        }
+    }
+    return nullptr;
+}
+
+// FNV-1a over each field value in declaration order, little-endian.
+// Matches hashFields() in qubic-bridge/contract-codec.ts.
+struct FieldHasher
+{
+    uint32 hash = 2166136261u;
+
+    void mixByte(uint8 byte)
+    {
+        hash = (hash ^ byte) * 16777619u;
+    }
+
+    template <typename T>
+    void mix(T value)
+    {
+        for (uint32 i = 0; i < sizeof(T); i++) {
+            mixByte((uint8)((uint64)value >> (8 * i)));
+        }
+    }
+
+    void mixChars(const char* chars, uint32 length)
+    {
+        for (uint32 i = 0; i < length; i++) {
+            mixByte((uint8)chars[i]);
+        }
+    }
+};
+
+inline uint32 hashFields(const RegisterUserInput& value)
+{
+    FieldHasher hasher;
+    hasher.mixChars(value.username, 32);
+    hasher.mixChars(value.passwordHash, 32);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const RegisterUserOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    hasher.mix(value.balance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const CreateEventInput& value)
+{
+    FieldHasher hasher;
+    hasher.mixChars(value.title, 128);
+    hasher.mixChars(value.description, 256);
+    hasher.mixChars(value.category, 32);
+    hasher.mix(value.endsAt);
+    hasher.mix(value.outcomeCount);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const CreateEventOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const PlaceBetInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    hasher.mix(value.eventId);
+    hasher.mix(value.prediction);
+    hasher.mix(value.amount);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const PlaceBetOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.betId);
+    hasher.mix(value.newBalance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ResolveEventInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    hasher.mix(value.correctAnswer);
+    hasher.mix(value.confidence);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ResolveEventOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.winnersCount);
+    hasher.mix(value.totalPayout);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetBalanceInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetBalanceOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.balance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetEventsInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.startIndex);
+    hasher.mix(value.count);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetEventsOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventCount);
+    hasher.mixChars(value.events, 1000);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetContractStatsInput&)
+{
+    FieldHasher hasher;
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetContractStatsOutput& value)
+{
+    FieldHasher hasher;
+    for (uint32 i = 0; i < 22; i++) {
+        hasher.mix(value.invocationCount[i]);
+    }
+    for (uint32 i = 0; i < 14; i++) {
+        hasher.mix(value.rejectionCount[i]);
+    }
+    for (uint32 i = 0; i < 22; i++) {
+        hasher.mix(value.elementsScanned[i]);
+    }
+    for (uint32 i = 0; i < 22; i++) {
+        hasher.mix(value.lastElementsScanned[i]);
+    }
+    hasher.mix(value.settlementBacklog);
+    hasher.mix(value.userCount);
+    hasher.mix(value.eventCount);
+    hasher.mix(value.betCount);
+    hasher.mix(value.totalVolume);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const PlaceOrderInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    hasher.mix(value.eventId);
+    hasher.mix(value.quantity);
+    hasher.mix(value.side);
+    hasher.mix(value.price);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const PlaceOrderOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.orderId);
+    hasher.mix(value.filledQuantity);
+    hasher.mix(value.restingQuantity);
+    hasher.mix(value.fillCost);
+    hasher.mix(value.newBalance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const CancelOrderInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    hasher.mix(value.orderId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const CancelOrderOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.refund);
+    hasher.mix(value.newBalance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetBestBidAskInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetBestBidAskOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.bidQuantity);
+    hasher.mix(value.askQuantity);
+    hasher.mix(value.bestBid);
+    hasher.mix(value.bestAsk);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const EnableMarketMakerInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    hasher.mix(value.liquidity);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const EnableMarketMakerOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const QuoteBetInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    hasher.mix(value.amount);
+    hasher.mix(value.prediction);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const QuoteBetOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.cost);
+    hasher.mix(value.yesPriceBps);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ConfigureShardInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.shardIndex);
+    hasher.mix(value.shardCount);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ConfigureShardOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ShardTransferInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    hasher.mix(value.amount);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ShardTransferOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.newBalance);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ResolveEventsInput& value)
+{
+    FieldHasher hasher;
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.eventIds[i]);
+    }
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.correctAnswers[i]);
+    }
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.confidences[i]);
+    }
+    hasher.mix(value.count);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const ResolveEventsOutput& value)
+{
+    FieldHasher hasher;
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.winnersCount[i]);
+    }
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.totalPayout[i]);
+    }
+    for (uint32 i = 0; i < 64; i++) {
+        hasher.mix(value.resolved[i]);
+    }
+    hasher.mix(value.resolvedCount);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetLeaderboardInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.count);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetLeaderboardOutput& value)
+{
+    FieldHasher hasher;
+    for (uint32 i = 0; i < 50; i++) {
+        hasher.mix(value.userIds[i]);
+    }
+    for (uint32 i = 0; i < 50; i++) {
+        hasher.mix(value.totalWins[i]);
+    }
+    for (uint32 i = 0; i < 50; i++) {
+        hasher.mix(value.totalBets[i]);
+    }
+    for (uint32 i = 0; i < 50; i++) {
+        hasher.mix(value.balances[i]);
+    }
+    hasher.mix(value.count);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetUserSummaryInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetUserSummaryOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.openStake);
+    hasher.mix(value.realizedPnl);
+    hasher.mix(value.balance);
+    hasher.mix(value.totalBets);
+    hasher.mix(value.totalWins);
+    hasher.mix(value.openBets);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetOutcomeTallyInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.eventId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const GetOutcomeTallyOutput& value)
+{
+    FieldHasher hasher;
+    for (uint32 i = 0; i < 16; i++) {
+        hasher.mix(value.bets[i]);
+    }
+    hasher.mix(value.outcomeCount);
+    hasher.mix(value.isResolved);
+    hasher.mix(value.correctAnswer);
+    hasher.mix(value.hasMarketMaker);
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const UnregisterUserInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.userId);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const UnregisterUserOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const SetMaxOpenStakeInput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.maxOpenStake);
+    return hasher.hash;
+}
+
+inline uint32 hashFields(const SetMaxOpenStakeOutput& value)
+{
+    FieldHasher hasher;
+    hasher.mix(value.success);
+    return hasher.hash;
+}
+
+// Calls visitor.template visit<T>() for the struct with the given schema id
+template <typename Visitor>
+bool visitStruct(uint16 id, Visitor& visitor)
+{
+    switch (id) {
+    case 0: visitor.template visit<RegisterUserInput>(); return true;
+    case 1: visitor.template visit<RegisterUserOutput>(); return true;
+    case 2: visitor.template visit<CreateEventInput>(); return true;
+    case 3: visitor.template visit<CreateEventOutput>(); return true;
+    case 4: visitor.template visit<PlaceBetInput>(); return true;
+    case 5: visitor.template visit<PlaceBetOutput>(); return true;
+    case 6: visitor.template visit<ResolveEventInput>(); return true;
+    case 7: visitor.template visit<ResolveEventOutput>(); return true;
+    case 8: visitor.template visit<GetBalanceInput>(); return true;
+    case 9: visitor.template visit<GetBalanceOutput>(); return true;
+    case 10: visitor.template visit<GetEventsInput>(); return true;
+    case 11: visitor.template visit<GetEventsOutput>(); return true;
+    case 12: visitor.template visit<GetContractStatsInput>(); return true;
+    case 13: visitor.template visit<GetContractStatsOutput>(); return true;
+    case 14: visitor.template visit<PlaceOrderInput>(); return true;
+    case 15: visitor.template visit<PlaceOrderOutput>(); return true;
+    case 16: visitor.template visit<CancelOrderInput>(); return true;
+    case 17: visitor.template visit<CancelOrderOutput>(); return true;
+    case 18: visitor.template visit<GetBestBidAskInput>(); return true;
+    case 19: visitor.template visit<GetBestBidAskOutput>(); return true;
+    case 20: visitor.template visit<EnableMarketMakerInput>(); return true;
+    case 21: visitor.template visit<EnableMarketMakerOutput>(); return true;
+    case 22: visitor.template visit<QuoteBetInput>(); return true;
+    case 23: visitor.template visit<QuoteBetOutput>(); return true;
+    case 24: visitor.template visit<ConfigureShardInput>(); return true;
+    case 25: visitor.template visit<ConfigureShardOutput>(); return true;
+    case 26: visitor.template visit<ShardTransferInput>(); return true;
+    case 27: visitor.template visit<ShardTransferOutput>(); return true;
+    case 28: visitor.template visit<ResolveEventsInput>(); return true;
+    case 29: visitor.template visit<ResolveEventsOutput>(); return true;
+    case 30: visitor.template visit<GetLeaderboardInput>(); return true;
+    case 31: visitor.template visit<GetLeaderboardOutput>(); return true;
+    case 32: visitor.template visit<GetUserSummaryInput>(); return true;
+    case 33: visitor.template visit<GetUserSummaryOutput>(); return true;
+    case 34: visitor.template visit<GetOutcomeTallyInput>(); return true;
+    case 35: visitor.template visit<GetOutcomeTallyOutput>(); return true;
+    case 36: visitor.template visit<UnregisterUserInput>(); return true;
+    case 37: visitor.template visit<UnregisterUserOutput>(); return true;
+    case 38: visitor.template visit<SetMaxOpenStakeInput>(); return true;
+    case 39: visitor.template visit<SetMaxOpenStakeOutput>(); return true;
+    default: return false;
+    }
+}
+
+} // namespace contract_abi
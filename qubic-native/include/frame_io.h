@@ -0,0 +1,241 @@
+// Non-blocking socket helpers and buffered frame I/O for wire_protocol.h.
+// Endpoints are either a filesystem path (Unix domain socket) or host:port.
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+
+#include "wire_protocol.h"
+
+namespace net
+{
+
+inline bool isUnixEndpoint(const std::string& endpoint)
+{
+    return endpoint.find('/') != std::string::npos;
+}
+
+inline void setNonBlocking(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+inline bool resolveTcp(const std::string& endpoint, sockaddr_in& address)
+{
+    const size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos) {
+        return false;
+    }
+
+    const std::string host = endpoint.substr(0, colon);
+    addrinfo hints = {};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    if (getaddrinfo(host.empty() ? "127.0.0.1" : host.c_str(), endpoint.c_str() + colon + 1, &hints, &result) != 0) {
+        return false;
+    }
+    address = *(sockaddr_in*)result->ai_addr;
+    freeaddrinfo(result);
+    return true;
+}
+
+// Returns a listening, non-blocking socket or -1
+inline int listenEndpoint(const std::string& endpoint)
+{
+    int fd;
+    if (isUnixEndpoint(endpoint)) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        if (endpoint.size() >= sizeof(address.sun_path)) {
+            return -1;
+        }
+        strcpy(address.sun_path, endpoint.c_str());
+        unlink(endpoint.c_str());
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in address = {};
+        if (!resolveTcp(endpoint, address)) {
+            return -1;
+        }
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int reuse = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (fd < 0 || bind(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+    }
+
+    if (listen(fd, 128) != 0) {
+        close(fd);
+        return -1;
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+// Blocking connect, then switched to non-blocking. Returns -1 on failure.
+inline int connectEndpoint(const std::string& endpoint)
+{
+    int fd;
+    if (isUnixEndpoint(endpoint)) {
+        sockaddr_un address = {};
+        address.sun_family = AF_UNIX;
+        strncpy(address.sun_path, endpoint.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+    } else {
+        sockaddr_in address = {};
+        if (!resolveTcp(endpoint, address)) {
+            return -1;
+        }
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd);
+            return -1;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+    }
+
+    setNonBlocking(fd);
+    return fd;
+}
+
+// One socket with its pending input and output bytes
+struct Connection
+{
+    int fd = -1;
+    std::vector<uint8> input;
+    size_t inputOffset = 0;
+    std::vector<uint8> output;
+    size_t outputOffset = 0;
+
+    void queue(const void* data, size_t size)
+    {
+        const uint8* bytes = (const uint8*)data;
+        output.insert(output.end(), bytes, bytes + size);
+    }
+
+    void queueFrame(const wire::FrameHeader& header, const void* payload, uint32 payloadSize)
+    {
+        queue(&header, sizeof(header));
+        if (payloadSize) {
+            queue(payload, payloadSize);
+        }
+    }
+
+    bool wantsWrite() const
+    {
+        return outputOffset < output.size();
+    }
+
+    // Writes as much queued output as the socket accepts; false on error
+    bool flush()
+    {
+        while (outputOffset < output.size()) {
+            const ssize_t written = send(fd, output.data() + outputOffset, output.size() - outputOffset, MSG_NOSIGNAL);
+            if (written < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            outputOffset += (size_t)written;
+        }
+
+        if (outputOffset == output.size()) {
+            output.clear();
+            outputOffset = 0;
+        }
+        return true;
+    }
+
+    // Reads everything available; false on EOF or error
+    bool receive()
+    {
+        if (inputOffset > 0 && inputOffset == input.size()) {
+            input.clear();
+            inputOffset = 0;
+        } else if (inputOffset > 64 * 1024) {
+            input.erase(input.begin(), input.begin() + inputOffset);
+            inputOffset = 0;
+        }
+
+        uint8 buffer[64 * 1024];
+        for (;;) {
+            const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                input.insert(input.end(), buffer, buffer + received);
+                continue;
+            }
+            if (received == 0) {
+                return false;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+    }
+
+    // Next complete frame; the payload pointer is valid until the following
+    // receive(). Sets malformed on a frame that violates the size limits.
+    bool nextFrame(wire::FrameHeader& header, const uint8*& payload, bool& malformed)
+    {
+        malformed = false;
+        const size_t available = input.size() - inputOffset;
+        if (available < sizeof(wire::FrameHeader)) {
+            return false;
+        }
+
+        memcpy(&header, input.data() + inputOffset, sizeof(header));
+        if (header.size < sizeof(wire::FrameHeader) || header.size > wire::MAX_FRAME_SIZE) {
+            malformed = true;
+            return false;
+        }
+        if (available < header.size) {
+            return false;
+        }
+
+        payload = input.data() + inputOffset + sizeof(wire::FrameHeader);
+        inputOffset += header.size;
+        return true;
+    }
+
+    void reset()
+    {
+        if (fd >= 0) {
+            close(fd);
+        }
+        fd = -1;
+        input.clear();
+        inputOffset = 0;
+        output.clear();
+        outputOffset = 0;
+    }
+};
+
+} // namespace net
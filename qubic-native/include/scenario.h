@@ -0,0 +1,279 @@
+// Workload scenarios for the native harness.
+//
+// A scenario file is a list of "key = value" lines; '#' starts a comment.
+// Every key has a default, so a file only lists what it changes:
+//
+//   seed                    RNG seed (1)
+//   users                   accounts registered before the run (1000)
+//   events                  markets open at any time (100)
+//   zipf_skew               popularity skew over markets, 0 = uniform (1.0)
+//   ticks                   ticks to simulate (300)
+//   ticks_per_epoch         ticks between END_EPOCH/BEGIN_EPOCH (100)
+//   bets_per_tick           PlaceBet calls per tick (100)
+//   reads_per_tick          GetBalance calls per tick (100)
+//   bet_size_distribution   fixed | uniform | geometric (uniform)
+//   bet_size_min            smallest bet (1)
+//   bet_size_max            largest bet (5)
+//   bet_size_mean           mean of the geometric distribution (2)
+//   yes_fraction            share of bets predicting YES (0.5)
+//   outcomes                outcomes per market, 2..MAX_OUTCOMES; above 2, bets
+//                           and answers are uniform over them and yes_fraction
+//                           is unused (2)
+//   resolve_every_ticks     resolution cadence, 0 = never (10)
+//   resolve_count           markets resolved at each cadence point (1)
+//   tick_budget             transaction cost allowed per tick, 0 = unlimited (0)
+//   over_budget             defer | reject, for transactions over it (defer)
+//
+// Markets are ranked by popularity. Resolution walks the ranks round robin
+// from the hottest market down, and each resolved market is replaced by a
+// new one at the same rank, so the popularity curve stays fixed.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "tick_budget.h"
+
+enum BetSizeDistribution : uint8
+{
+    BET_SIZE_FIXED = 0,
+    BET_SIZE_UNIFORM = 1,
+    BET_SIZE_GEOMETRIC = 2,
+};
+
+struct Scenario
+{
+    std::string name;
+    uint64 seed = 1;
+    uint32 users = 1000;
+    uint32 events = 100;
+    double zipfSkew = 1.0;
+    uint32 ticks = 300;
+    uint32 ticksPerEpoch = 100;
+    uint32 betsPerTick = 100;
+    uint32 readsPerTick = 100;
+    BetSizeDistribution betSizeDistribution = BET_SIZE_UNIFORM;
+    uint32 betSizeMin = 1;
+    uint32 betSizeMax = 5;
+    double betSizeMean = 2.0;
+    double yesFraction = 0.5;
+    uint32 outcomes = 2;
+    uint32 resolveEveryTicks = 10;
+    uint32 resolveCount = 1;
+    uint64 tickBudget = 0;
+    OverBudgetPolicy overBudget = OVER_BUDGET_DEFER;
+};
+
+inline std::string trimmed(const std::string& text)
+{
+    const size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) {
+        return "";
+    }
+    const size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+inline bool applyScenarioKey(Scenario& scenario, const std::string& key, const std::string& value)
+{
+    const char* text = value.c_str();
+    if (key == "seed") {
+        scenario.seed = strtoull(text, nullptr, 10);
+    } else if (key == "users") {
+        scenario.users = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "events") {
+        scenario.events = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "zipf_skew") {
+        scenario.zipfSkew = strtod(text, nullptr);
+    } else if (key == "ticks") {
+        scenario.ticks = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "ticks_per_epoch") {
+        scenario.ticksPerEpoch = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "bets_per_tick") {
+        scenario.betsPerTick = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "reads_per_tick") {
+        scenario.readsPerTick = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "bet_size_distribution") {
+        if (value == "fixed") {
+            scenario.betSizeDistribution = BET_SIZE_FIXED;
+        } else if (value == "uniform") {
+            scenario.betSizeDistribution = BET_SIZE_UNIFORM;
+        } else if (value == "geometric") {
+            scenario.betSizeDistribution = BET_SIZE_GEOMETRIC;
+        } else {
+            return false;
+        }
+    } else if (key == "bet_size_min") {
+        scenario.betSizeMin = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "bet_size_max") {
+        scenario.betSizeMax = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "bet_size_mean") {
+        scenario.betSizeMean = strtod(text, nullptr);
+    } else if (key == "yes_fraction") {
+        scenario.yesFraction = strtod(text, nullptr);
+    } else if (key == "outcomes") {
+        scenario.outcomes = (uint32)strtoul(text, nullptr, 10);
+        if (scenario.outcomes < 2 || scenario.outcomes > MAX_OUTCOMES) {
+            return false;
+        }
+    } else if (key == "resolve_every_ticks") {
+        scenario.resolveEveryTicks = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "resolve_count") {
+        scenario.resolveCount = (uint32)strtoul(text, nullptr, 10);
+    } else if (key == "tick_budget") {
+        scenario.tickBudget = strtoull(text, nullptr, 10);
+    } else if (key == "over_budget") {
+        if (value == "defer") {
+            scenario.overBudget = OVER_BUDGET_DEFER;
+        } else if (value == "reject") {
+            scenario.overBudget = OVER_BUDGET_REJECT;
+        } else {
+            return false;
+        }
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Returns false and prints the offending line on a parse error
+inline bool loadScenario(const char* path, Scenario& scenario)
+{
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "cannot open scenario %s\n", path);
+        return false;
+    }
+
+    std::string name = path;
+    const size_t slash = name.find_last_of('/');
+    scenario.name = slash == std::string::npos ? name : name.substr(slash + 1);
+
+    char line[512];
+    uint32 lineNumber = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        lineNumber++;
+        std::string text = line;
+        const size_t comment = text.find('#');
+        if (comment != std::string::npos) {
+            text.resize(comment);
+        }
+        text = trimmed(text);
+        if (text.empty()) {
+            continue;
+        }
+
+        const size_t equals = text.find('=');
+        if (equals == std::string::npos
+            || !applyScenarioKey(scenario, trimmed(text.substr(0, equals)), trimmed(text.substr(equals + 1)))) {
+            fprintf(stderr, "%s:%u: cannot parse \"%s\"\n", path, lineNumber, text.c_str());
+            ok = false;
+        }
+    }
+    fclose(file);
+
+    if (ok && (!scenario.users || !scenario.events || !scenario.ticksPerEpoch
+        || scenario.betSizeMin > scenario.betSizeMax)) {
+        fprintf(stderr, "%s: users, events and ticks_per_epoch must be non-zero and bet_size_min <= bet_size_max\n", path);
+        ok = false;
+    }
+    return ok;
+}
+
+// Samples ranks 0..count-1 with probability proportional to 1 / (rank + 1)^skew
+class ZipfSampler
+{
+public:
+    ZipfSampler(uint32 count, double skew)
+        : cumulative(count)
+    {
+        double total = 0;
+        for (uint32 rank = 0; rank < count; rank++) {
+            total += 1.0 / pow(rank + 1.0, skew);
+            cumulative[rank] = total;
+        }
+        for (double& value : cumulative) {
+            value /= total;
+        }
+    }
+
+    template <typename Rng>
+    uint32 sample(Rng& rng) const
+    {
+        const double point = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        const auto it = std::lower_bound(cumulative.begin(), cumulative.end(), point);
+        return it == cumulative.end() ? (uint32)cumulative.size() - 1 : (uint32)(it - cumulative.begin());
+    }
+
+    // Probability mass of the hottest `count` ranks
+    double headShare(uint32 count) const
+    {
+        return count == 0 ? 0.0 : cumulative[std::min<size_t>(count, cumulative.size()) - 1];
+    }
+
+private:
+    std::vector<double> cumulative;
+};
+
+template <typename Rng>
+uint32 sampleBetSize(const Scenario& scenario, Rng& rng)
+{
+    switch (scenario.betSizeDistribution) {
+    case BET_SIZE_FIXED:
+        return scenario.betSizeMin;
+    case BET_SIZE_GEOMETRIC: {
+        const double mean = std::max(scenario.betSizeMean, 1.0);
+        const uint32 size = 1 + std::geometric_distribution<uint32>(1.0 / mean)(rng);
+        return std::min(std::max(size, scenario.betSizeMin), scenario.betSizeMax);
+    }
+    default:
+        return std::uniform_int_distribution<uint32>(scenario.betSizeMin, scenario.betSizeMax)(rng);
+    }
+}
+
+// Latency samples in nanoseconds with percentile lookup
+class LatencyRecorder
+{
+public:
+    void record(uint64 nanoseconds)
+    {
+        samples.push_back(nanoseconds);
+        total += nanoseconds;
+        sorted = false;
+    }
+
+    size_t count() const
+    {
+        return samples.size();
+    }
+
+    uint64 totalNanoseconds() const
+    {
+        return total;
+    }
+
+    uint64 percentile(double fraction)
+    {
+        if (samples.empty()) {
+            return 0;
+        }
+        if (!sorted) {
+            std::sort(samples.begin(), samples.end());
+            sorted = true;
+        }
+        const size_t index = std::min(samples.size() - 1, (size_t)(fraction * samples.size()));
+        return samples[index];
+    }
+
+private:
+    std::vector<uint64> samples;
+    uint64 total = 0;
+    bool sorted = true;
+};
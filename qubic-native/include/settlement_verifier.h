@@ -0,0 +1,325 @@
+// Independent recomputation of ResolveEvent / ResolveEvents results.
+//
+// From the contract state before a resolution, the resolution entries, the
+// results the contract reported and the state after it, recomputes every
+// payout from the bets, order books and positions and diffs it against the
+// contract: per-entry winners and payout, each user's balance, totalWins and
+// flat bet aggregates (openBets, openStake, realizedPnl), the flags of settled bets and resolved events. Bets of other events must
+// come through untouched.
+//
+// Bets are grouped by event with a parallel counting sort, events are then
+// settled on a thread pool with each worker crediting users in its own delta
+// arrays, and a last parallel pass sums the deltas per user. Only the
+// resolution code in HM25.h is mirrored here; nothing is shared with it.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "contract_layout.h"
+#include "thread_pool.h"
+
+struct Resolution
+{
+    uint32 eventId;
+    uint8 correctAnswer;
+};
+
+// ResolveEventOutput, or one entry of ResolveEventsOutput
+struct ResolutionResult
+{
+    uint32 winnersCount;
+    uint32 totalPayout;
+    uint8 resolved;
+};
+
+struct SettlementReport
+{
+    uint32 resolvedEvents = 0;
+    uint64 settledBets = 0;
+    uint64 mismatches = 0;
+    std::vector<std::string> details;  // The first MAX_DETAILS mismatches
+
+    bool ok() const
+    {
+        return mismatches == 0;
+    }
+};
+
+class SettlementVerifier
+{
+public:
+    static constexpr uint32 MAX_DETAILS = 20;
+
+    explicit SettlementVerifier(uint32 threads)
+        : pool(threads), workerMismatches(pool.size()), workerDetails(pool.size())
+    {
+    }
+
+    uint32 threads() const
+    {
+        return pool.size();
+    }
+
+    SettlementReport verify(const CONTRACT_STATE& before, const std::vector<Resolution>& resolutions,
+        const std::vector<ResolutionResult>& reported, const CONTRACT_STATE& after)
+    {
+        const uint32 workers = pool.size();
+        const uint32 entries = (uint32)resolutions.size();
+        const uint32 users = before.userCount;
+        const uint32 bets = before.betCount;
+        for (uint32 worker = 0; worker < workers; worker++) {
+            workerMismatches[worker] = 0;
+            workerDetails[worker].clear();
+        }
+
+        // Entries that resolve, in contract order: a repeated event is
+        // already closed by the time its second entry is reached, and an
+        // answer past the event's outcomes is rejected
+        SettlementReport report;
+        entryOfEvent.assign(before.eventCount, -1);
+        for (uint32 entry = 0; entry < entries; entry++) {
+            const uint32 eventId = resolutions[entry].eventId;
+            if (eventId != 0 && eventId <= before.eventCount && before.events[eventId - 1].id == eventId
+                && before.events[eventId - 1].isActive && !before.events[eventId - 1].isResolved
+                && resolutions[entry].correctAnswer < before.events[eventId - 1].outcomeCount
+                && entryOfEvent[eventId - 1] < 0) {
+                entryOfEvent[eventId - 1] = (sint32)entry;
+                report.resolvedEvents++;
+            }
+        }
+
+        counts.assign((size_t)workers * entries, 0);
+        balanceDelta.resize((size_t)workers * users);
+        winsDelta.resize((size_t)workers * users);
+        stakeDelta.resize((size_t)workers * users);
+        pnlDelta.resize((size_t)workers * users);
+        settledDelta.resize((size_t)workers * users);
+        grouped.resize(bets);
+        groupStart.assign(entries + 1, 0);
+        computed.assign(entries, ResolutionResult{ 0, 0, 0 });
+        const uint32 betChunk = (bets + workers - 1) / workers;
+        const uint32 userChunk = (users + workers - 1) / workers;
+
+        // Count pending bets per resolving entry; bets left out must be unchanged
+        pool.run([&](uint32 worker) {
+            std::fill(balanceDelta.begin() + (size_t)worker * users, balanceDelta.begin() + (size_t)(worker + 1) * users, 0);
+            std::fill(winsDelta.begin() + (size_t)worker * users, winsDelta.begin() + (size_t)(worker + 1) * users, 0);
+            std::fill(stakeDelta.begin() + (size_t)worker * users, stakeDelta.begin() + (size_t)(worker + 1) * users, 0);
+            std::fill(pnlDelta.begin() + (size_t)worker * users, pnlDelta.begin() + (size_t)(worker + 1) * users, 0);
+            std::fill(settledDelta.begin() + (size_t)worker * users, settledDelta.begin() + (size_t)(worker + 1) * users, 0);
+
+            uint32* workerCounts = counts.data() + (size_t)worker * entries;
+            const uint32 end = std::min(bets, (worker + 1) * betChunk);
+            for (uint32 i = worker * betChunk; i < end; i++) {
+                const Bet& bet = before.bets[i];
+                const sint32 entry = bet.isProcessed ? -1 : entryOfEvent[bet.eventId - 1];
+                if (entry >= 0) {
+                    workerCounts[entry]++;
+                } else if (after.bets[i].isProcessed != bet.isProcessed || after.bets[i].isWon != bet.isWon) {
+                    mismatch(worker, "bet %u of unresolved or settled event %u changed", i + 1, bet.eventId);
+                }
+            }
+        });
+
+        // Turn counts into scatter cursors: entry-major, then worker order
+        uint32 offset = 0;
+        for (uint32 entry = 0; entry < entries; entry++) {
+            groupStart[entry] = offset;
+            for (uint32 worker = 0; worker < workers; worker++) {
+                const uint32 count = counts[(size_t)worker * entries + entry];
+                counts[(size_t)worker * entries + entry] = offset;
+                offset += count;
+            }
+        }
+        groupStart[entries] = offset;
+        report.settledBets = offset;
+
+        pool.run([&](uint32 worker) {
+            uint32* cursors = counts.data() + (size_t)worker * entries;
+            const uint32 end = std::min(bets, (worker + 1) * betChunk);
+            for (uint32 i = worker * betChunk; i < end; i++) {
+                const Bet& bet = before.bets[i];
+                const sint32 entry = bet.isProcessed ? -1 : entryOfEvent[bet.eventId - 1];
+                if (entry >= 0) {
+                    grouped[cursors[entry]++] = i;
+                }
+            }
+        });
+
+        // Settle events; workers pull entries until none are left
+        std::atomic<uint32> nextEntry(0);
+        pool.run([&](uint32 worker) {
+            UserDeltas deltas = { balanceDelta.data() + (size_t)worker * users, winsDelta.data() + (size_t)worker * users,
+                stakeDelta.data() + (size_t)worker * users, pnlDelta.data() + (size_t)worker * users,
+                settledDelta.data() + (size_t)worker * users };
+            for (uint32 entry = nextEntry++; entry < entries; entry = nextEntry++) {
+                const uint32 eventId = resolutions[entry].eventId;
+                if (eventId == 0 || eventId > before.eventCount || entryOfEvent[eventId - 1] != (sint32)entry) {
+                    continue;
+                }
+                settleEvent(worker, before, after, eventId - 1, resolutions[entry].correctAnswer,
+                    groupStart[entry], groupStart[entry + 1], deltas, computed[entry]);
+            }
+        });
+
+        // Sum the deltas per user and compare with the state after
+        pool.run([&](uint32 worker) {
+            const uint32 end = std::min(users, (worker + 1) * userChunk);
+            for (uint32 user = worker * userChunk; user < end; user++) {
+                uint64 credit = 0;
+                uint32 wins = 0;
+                uint64 stake = 0;
+                sint64 pnl = 0;
+                uint32 settled = 0;
+                for (uint32 source = 0; source < workers; source++) {
+                    credit += balanceDelta[(size_t)source * users + user];
+                    wins += winsDelta[(size_t)source * users + user];
+                    stake += stakeDelta[(size_t)source * users + user];
+                    pnl += pnlDelta[(size_t)source * users + user];
+                    settled += settledDelta[(size_t)source * users + user];
+                }
+
+                // Balances are uint32 in the contract, so compare modulo 2^32
+                const uint32 balance = (uint32)(before.users[user].balance + credit);
+                if (after.users[user].balance != balance || after.users[user].totalWins != before.users[user].totalWins + wins) {
+                    mismatch(worker, "user %u: balance %u, expected %u; wins %u, expected %u", user + 1,
+                        after.users[user].balance, balance, after.users[user].totalWins, before.users[user].totalWins + wins);
+                }
+                const User& was = before.users[user];
+                const User& now = after.users[user];
+                if (now.openBets != was.openBets - settled || now.openStake != was.openStake - stake
+                    || now.realizedPnl != was.realizedPnl + pnl) {
+                    mismatch(worker, "user %u: open %u / %llu, realized %lld; expected %u / %llu, %lld", user + 1,
+                        now.openBets, (unsigned long long)now.openStake, (long long)now.realizedPnl, was.openBets - settled,
+                        (unsigned long long)(was.openStake - stake), (long long)(was.realizedPnl + pnl));
+                }
+            }
+        });
+
+        for (uint32 entry = 0; entry < entries; entry++) {
+            const ResolutionResult& expected = computed[entry];
+            const ResolutionResult actual = entry < reported.size() ? reported[entry] : ResolutionResult{ 0, 0, 0 };
+            if (actual.resolved != expected.resolved || actual.winnersCount != expected.winnersCount
+                || actual.totalPayout != expected.totalPayout) {
+                mismatch(0, "entry %u (event %u): reported resolved=%u winners=%u payout=%u, expected %u/%u/%u",
+                    entry, resolutions[entry].eventId, actual.resolved, actual.winnersCount, actual.totalPayout,
+                    expected.resolved, expected.winnersCount, expected.totalPayout);
+            }
+        }
+
+        for (uint32 worker = 0; worker < workers; worker++) {
+            report.mismatches += workerMismatches[worker];
+            for (const std::string& detail : workerDetails[worker]) {
+                if (report.details.size() < MAX_DETAILS) {
+                    report.details.push_back(detail);
+                }
+            }
+        }
+        return report;
+    }
+
+private:
+    ThreadPool pool;
+    std::vector<sint32> entryOfEvent;   // Event slot -> resolving entry, or -1
+    std::vector<uint32> counts;         // [worker * entries + entry]: bet count, then scatter cursor
+    std::vector<uint32> groupStart;     // Entry -> first of its bets in grouped
+    std::vector<uint32> grouped;        // Pending bet slots, grouped by entry
+    std::vector<uint64> balanceDelta;   // [worker * users + user]
+    std::vector<uint32> winsDelta;      // [worker * users + user]
+    std::vector<uint64> stakeDelta;     // Settled flat bet stake, [worker * users + user]
+    std::vector<sint64> pnlDelta;       // [worker * users + user]
+    std::vector<uint32> settledDelta;   // Settled flat bets, [worker * users + user]
+    std::vector<ResolutionResult> computed;
+    std::vector<uint64> workerMismatches;
+    std::vector<std::vector<std::string>> workerDetails;
+
+    // One worker's rows of the per-user delta arrays
+    struct UserDeltas
+    {
+        uint64* credit;
+        uint32* wins;
+        uint64* stake;
+        sint64* pnl;
+        uint32* settled;
+    };
+
+    // Flat bets pay winReward, resting orders are refunded, and positions
+    // pay ORDER_SHARE_PAYOUT per winning share, as in ResolveEvent
+    void settleEvent(uint32 worker, const CONTRACT_STATE& before, const CONTRACT_STATE& after, uint32 eventSlot,
+        uint8 answer, uint32 first, uint32 last, const UserDeltas& deltas, ResolutionResult& result)
+    {
+        uint64* credit = deltas.credit;
+        uint32* wins = deltas.wins;
+        uint32 winners = 0;
+        uint64 payout = 0;
+        for (uint32 i = first; i < last; i++) {
+            const Bet& bet = before.bets[grouped[i]];
+            const uint8 won = bet.prediction == answer;
+            if (won) {
+                winners++;
+                payout += before.winReward;
+                credit[bet.userId - 1] += before.winReward;
+                wins[bet.userId - 1]++;
+            }
+            deltas.stake[bet.userId - 1] += bet.amount;
+            deltas.pnl[bet.userId - 1] += (sint64)(won ? before.winReward : 0) - bet.amount;
+            deltas.settled[bet.userId - 1]++;
+            if (!after.bets[grouped[i]].isProcessed || after.bets[grouped[i]].isWon != won) {
+                mismatch(worker, "bet %u on event %u: processed=%u won=%u, expected won=%u", grouped[i] + 1,
+                    eventSlot + 1, after.bets[grouped[i]].isProcessed, after.bets[grouped[i]].isWon, won);
+            }
+        }
+
+        const OrderBook& book = before.books[eventSlot];
+        for (uint32 level = 0; level < ORDER_PRICE_LEVELS; level++) {
+            for (uint32 slot = book.bidHead[level]; slot; slot = before.orders[slot - 1].next) {
+                const Order& order = before.orders[slot - 1];
+                credit[order.userId - 1] += (uint64)order.quantity * order.price;
+            }
+            for (uint32 slot = book.askHead[level]; slot; slot = before.orders[slot - 1].next) {
+                const Order& order = before.orders[slot - 1];
+                credit[order.userId - 1] += (uint64)order.quantity * (ORDER_SHARE_PAYOUT - order.price);
+            }
+        }
+
+        for (uint32 slot = book.positionHead; slot; slot = before.positions[slot - 1].nextInEvent) {
+            const Position& position = before.positions[slot - 1];
+            const uint32 shares = answer == 1 ? position.yesShares : position.noShares;
+            if (shares) {
+                winners++;
+                payout += (uint64)shares * ORDER_SHARE_PAYOUT;
+                credit[position.userId - 1] += (uint64)shares * ORDER_SHARE_PAYOUT;
+                wins[position.userId - 1]++;
+            }
+        }
+
+        const Event& event = after.events[eventSlot];
+        if (!event.isResolved || event.isActive || event.correctAnswer != answer) {
+            mismatch(worker, "event %u: resolved=%u active=%u answer=%u, expected answer %u", eventSlot + 1,
+                event.isResolved, event.isActive, event.correctAnswer, answer);
+        }
+
+        result.winnersCount = winners;
+        result.totalPayout = (uint32)payout;
+        result.resolved = 1;
+    }
+
+    void mismatch(uint32 worker, const char* format, ...)
+    {
+        workerMismatches[worker]++;
+        if (workerDetails[worker].size() < MAX_DETAILS) {
+            char line[256];
+            va_list args;
+            va_start(args, format);
+            vsnprintf(line, sizeof(line), format, args);
+            va_end(args);
+            workerDetails[worker].push_back(line);
+        }
+    }
+};
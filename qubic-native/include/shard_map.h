@@ -0,0 +1,72 @@
+// Id routing for a sharded PredictoR deployment: shardCount instances of
+// qubic-contracts/HM25.h, instance k configured with ConfigureShard(k, N).
+// qubic-bridge/shard-map.ts applies the same rules; keep them in step.
+//
+//   - Events interleave: global event g lives on shard (g - 1) % N under
+//     local id (g - 1) / N + 1, so round-robin creation keeps shards even.
+//   - Users are registered on every shard under the same id. Their balance
+//     starts on the home shard, (userId - 1) % N, and is moved to an event's
+//     shard with ShardTransferOut/ShardTransferIn before betting there.
+//   - Bet ids interleave like event ids: shard-local bet b on shard k is
+//     global bet (b - 1) * N + k + 1, so bets on different shards never
+//     share an id.
+//   - Order ids are local to a shard; globally they are local * N + shard.
+
+#pragma once
+
+#include "contract_layout.h"
+
+struct ShardMap
+{
+    uint32 shardCount = 1;
+
+    uint32 eventShard(uint32 globalEventId) const
+    {
+        return (globalEventId - 1) % shardCount;
+    }
+
+    uint32 localEventId(uint32 globalEventId) const
+    {
+        return (globalEventId - 1) / shardCount + 1;
+    }
+
+    uint32 globalEventId(uint32 shard, uint32 localEventId) const
+    {
+        return (localEventId - 1) * shardCount + shard + 1;
+    }
+
+    uint32 homeShard(uint32 userId) const
+    {
+        return (userId - 1) % shardCount;
+    }
+
+    uint32 betShard(uint32 globalBetId) const
+    {
+        return (globalBetId - 1) % shardCount;
+    }
+
+    uint32 localBetId(uint32 globalBetId) const
+    {
+        return (globalBetId - 1) / shardCount + 1;
+    }
+
+    uint32 globalBetId(uint32 shard, uint32 localBetId) const
+    {
+        return (localBetId - 1) * shardCount + shard + 1;
+    }
+
+    uint32 orderShard(uint64 globalOrderId) const
+    {
+        return (uint32)(globalOrderId % shardCount);
+    }
+
+    uint32 localOrderId(uint64 globalOrderId) const
+    {
+        return (uint32)(globalOrderId / shardCount);
+    }
+
+    uint64 globalOrderId(uint32 shard, uint32 localOrderId) const
+    {
+        return (uint64)localOrderId * shardCount + shard;
+    }
+};
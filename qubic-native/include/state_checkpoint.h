@@ -0,0 +1,388 @@
+// Epoch checkpoints of CONTRACT_STATE, stored as compressed deltas.
+//
+// The state is cut into diff units: one per record of the fixed-size arrays
+// (users, events, bets, orders, positions, books, makers, tallies) and
+// GAP_CHUNK_BYTES pieces of everything between them (counters, settings,
+// leaderboard, temporaries). A checkpoint holds only the units that changed
+// since the previous one, each XORed with its previous bytes and run-length
+// coded, so an untouched record costs nothing and a settled bet costs the
+// few bytes that flipped. A base checkpoint is the same encoding against an
+// all-zero state, which also squeezes out the unused capacity of the arrays.
+//
+// Files are PREFIX.<epoch>.ckpt, one per epoch. A delta names the epoch it
+// applies on top of; restore walks back to the nearest base and applies the
+// deltas forward, so a chain is at most baseEvery checkpoints long. Every
+// header carries a hash of the state it encodes, checked at each step.
+//
+// Payload, per changed unit in unit order:
+//   varint  units skipped since the previous changed unit
+//   runs    (varint equal bytes, varint literal bytes, XORed literal bytes)
+//           until the unit's end
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "contract_layout.h"
+
+namespace checkpoint
+{
+
+constexpr uint32 CHECKPOINT_MAGIC = 0x4b445250;  // "PRDK"
+constexpr uint32 CHECKPOINT_VERSION = 1;
+constexpr uint32 GAP_CHUNK_BYTES = 256;
+
+enum CheckpointKind : uint8
+{
+    CHECKPOINT_BASE = 0,
+    CHECKPOINT_DELTA = 1,
+};
+
+struct CheckpointHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint64 stateSize;
+    uint32 unitCount;     // Diff units of this build's state
+    uint32 changedUnits;
+    uint64 payloadSize;
+    uint64 stateHash;     // stateHash() of the state after applying this checkpoint
+    uint32 tick;
+    uint16 epoch;
+    uint16 parentEpoch;   // Checkpoint a delta applies on top of; unused for a base
+    uint8 kind;
+    uint8 reserved[7];
+};
+
+struct DiffUnit
+{
+    uint32 offset;
+    uint32 size;
+};
+
+// Unit table of this build: records of the state arrays in declaration
+// order, with the bytes between them cut into GAP_CHUNK_BYTES chunks
+inline const std::vector<DiffUnit>& diffUnits()
+{
+    static const std::vector<DiffUnit> units = [] {
+        struct RecordArray
+        {
+            size_t offset;
+            size_t recordSize;
+            size_t count;
+        };
+        RecordArray arrays[] = {
+            { offsetof(CONTRACT_STATE, users), sizeof(User), MAX_USERS },
+            { offsetof(CONTRACT_STATE, events), sizeof(Event), MAX_EVENTS },
+            { offsetof(CONTRACT_STATE, bets), sizeof(Bet), MAX_BETS },
+            { offsetof(CONTRACT_STATE, orders), sizeof(Order), MAX_ORDERS },
+            { offsetof(CONTRACT_STATE, positions), sizeof(Position), MAX_POSITIONS },
+            { offsetof(CONTRACT_STATE, books), sizeof(OrderBook), MAX_EVENTS },
+            { offsetof(CONTRACT_STATE, makers), sizeof(MarketMaker), MAX_EVENTS },
+            { offsetof(CONTRACT_STATE, tallies), sizeof(OutcomeTally), MAX_EVENTS },
+        };
+        std::sort(std::begin(arrays), std::end(arrays),
+            [](const RecordArray& a, const RecordArray& b) { return a.offset < b.offset; });
+
+        std::vector<DiffUnit> result;
+        size_t cursor = 0;
+        const auto addGap = [&](size_t end) {
+            while (cursor < end) {
+                const size_t size = std::min<size_t>(GAP_CHUNK_BYTES, end - cursor);
+                result.push_back({ (uint32)cursor, (uint32)size });
+                cursor += size;
+            }
+        };
+        for (const RecordArray& array : arrays) {
+            addGap(array.offset);
+            for (size_t i = 0; i < array.count; i++) {
+                result.push_back({ (uint32)(array.offset + i * array.recordSize), (uint32)array.recordSize });
+            }
+            cursor = array.offset + array.count * array.recordSize;
+        }
+        addGap(sizeof(CONTRACT_STATE));
+        return result;
+    }();
+    return units;
+}
+
+// FNV-1a over 8-byte words, then the tail bytes
+inline uint64 stateHash(const CONTRACT_STATE& state)
+{
+    const uint8* bytes = (const uint8*)&state;
+    const size_t words = sizeof(state) / 8;
+    uint64 hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < words; i++) {
+        uint64 word;
+        memcpy(&word, bytes + i * 8, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
+    }
+    for (size_t i = words * 8; i < sizeof(state); i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline std::string checkpointPath(const std::string& prefix, uint16 epoch)
+{
+    return prefix + "." + std::to_string(epoch) + ".ckpt";
+}
+
+inline void putVarint(std::vector<uint8>& out, uint32 value)
+{
+    while (value >= 0x80) {
+        out.push_back((uint8)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8)value);
+}
+
+inline bool getVarint(const uint8*& in, const uint8* end, uint32& value)
+{
+    value = 0;
+    for (uint32 shift = 0; shift < 35 && in < end; shift += 7) {
+        const uint8 byte = *in++;
+        value |= (uint32)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Run-length codes current XOR previous over one unit. A literal run ends
+// at two equal bytes in a row, so a lone equal byte does not cost a new run.
+inline void encodeUnit(std::vector<uint8>& out, const uint8* current, const uint8* previous, uint32 size)
+{
+    uint32 i = 0;
+    while (i < size) {
+        const uint32 equalStart = i;
+        while (i < size && current[i] == previous[i]) {
+            i++;
+        }
+        const uint32 literalStart = i;
+        while (i < size && (current[i] != previous[i] || (i + 1 < size && current[i + 1] != previous[i + 1]))) {
+            i++;
+        }
+        putVarint(out, literalStart - equalStart);
+        putVarint(out, i - literalStart);
+        for (uint32 j = literalStart; j < i; j++) {
+            out.push_back(current[j] ^ previous[j]);
+        }
+    }
+}
+
+inline bool decodeUnit(const uint8*& in, const uint8* end, uint8* target, uint32 size)
+{
+    uint32 i = 0;
+    while (i < size) {
+        uint32 equal;
+        uint32 literal;
+        if (!getVarint(in, end, equal) || !getVarint(in, end, literal) || equal + literal > size - i
+            || (uint64)(end - in) < literal) {
+            return false;
+        }
+        i += equal;
+        for (uint32 j = 0; j < literal; j++) {
+            target[i + j] ^= in[j];
+        }
+        in += literal;
+        i += literal;
+    }
+    return true;
+}
+
+// Encodes the units of current that differ from previous; returns how many
+inline uint32 encodeState(std::vector<uint8>& out, const CONTRACT_STATE& current, const CONTRACT_STATE& previous)
+{
+    const std::vector<DiffUnit>& units = diffUnits();
+    const uint8* now = (const uint8*)&current;
+    const uint8* was = (const uint8*)&previous;
+    uint32 changed = 0;
+    uint32 nextUnit = 0;
+    for (uint32 u = 0; u < units.size(); u++) {
+        const DiffUnit& unit = units[u];
+        if (!memcmp(now + unit.offset, was + unit.offset, unit.size)) {
+            continue;
+        }
+        putVarint(out, u - nextUnit);
+        encodeUnit(out, now + unit.offset, was + unit.offset, unit.size);
+        nextUnit = u + 1;
+        changed++;
+    }
+    return changed;
+}
+
+inline bool applyPayload(const std::vector<uint8>& payload, uint32 changedUnits, CONTRACT_STATE& state)
+{
+    const std::vector<DiffUnit>& units = diffUnits();
+    uint8* bytes = (uint8*)&state;
+    const uint8* in = payload.data();
+    const uint8* end = in + payload.size();
+    uint32 nextUnit = 0;
+    for (uint32 i = 0; i < changedUnits; i++) {
+        uint32 skipped;
+        if (!getVarint(in, end, skipped) || skipped >= units.size() - nextUnit) {
+            return false;
+        }
+        const DiffUnit& unit = units[nextUnit + skipped];
+        if (!decodeUnit(in, end, bytes + unit.offset, unit.size)) {
+            return false;
+        }
+        nextUnit += skipped + 1;
+    }
+    return in == end;
+}
+
+// Header of the checkpoint at path, if it is one from this build
+inline bool readHeader(const std::string& path, CheckpointHeader& header, std::vector<uint8>* payload = nullptr)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    bool read = fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == CHECKPOINT_MAGIC && header.version == CHECKPOINT_VERSION
+        && header.stateSize == sizeof(CONTRACT_STATE) && header.unitCount == diffUnits().size();
+    if (read && payload) {
+        payload->resize(header.payloadSize);
+        read = fread(payload->data(), 1, payload->size(), file) == payload->size();
+    }
+    fclose(file);
+    return read;
+}
+
+inline const CONTRACT_STATE& zeroState()
+{
+    static const std::unique_ptr<CONTRACT_STATE> zero(new CONTRACT_STATE());
+    return *zero;
+}
+
+// One checkpoint written
+struct CheckpointInfo
+{
+    CheckpointKind kind = CHECKPOINT_BASE;
+    uint16 epoch = 0;
+    uint32 changedUnits = 0;
+    uint64 fileBytes = 0;
+    uint64 micros = 0;
+};
+
+// Writes the checkpoints of one contract instance. Keeps a copy of the
+// state at the last checkpoint to diff against.
+class CheckpointWriter
+{
+public:
+    // A base is written first and then after every baseEvery - 1 deltas
+    CheckpointWriter(const std::string& prefix, uint32 baseEvery)
+        : prefix(prefix), baseEvery(std::max(1u, baseEvery)), previous(new CONTRACT_STATE)
+    {
+    }
+
+    // Replaces PREFIX.<epoch>.ckpt by rename, so readers never see a partial file
+    bool write(const CONTRACT_STATE& state, const ContractSystem& system, CheckpointInfo* info = nullptr)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const bool base = !written || sinceBase + 1 >= baseEvery;
+        payload.clear();
+
+        CheckpointHeader header = {};
+        header.magic = CHECKPOINT_MAGIC;
+        header.version = CHECKPOINT_VERSION;
+        header.stateSize = sizeof(CONTRACT_STATE);
+        header.unitCount = (uint32)diffUnits().size();
+        header.changedUnits = encodeState(payload, state, base ? zeroState() : *previous);
+        header.payloadSize = payload.size();
+        header.stateHash = stateHash(state);
+        header.tick = system.tick;
+        header.epoch = system.epoch;
+        header.parentEpoch = base ? 0 : previousEpoch;
+        header.kind = base ? CHECKPOINT_BASE : CHECKPOINT_DELTA;
+
+        const std::string path = checkpointPath(prefix, system.epoch);
+        const std::string temporary = path + ".tmp";
+        FILE* file = fopen(temporary.c_str(), "wb");
+        if (!file) {
+            return false;
+        }
+        const bool saved = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+        if (fclose(file) != 0 || !saved || rename(temporary.c_str(), path.c_str()) != 0) {
+            return false;
+        }
+
+        memcpy((void*)previous.get(), &state, sizeof(state));
+        previousEpoch = system.epoch;
+        sinceBase = base ? 0 : sinceBase + 1;
+        written = true;
+        if (info) {
+            info->kind = (CheckpointKind)header.kind;
+            info->epoch = header.epoch;
+            info->changedUnits = header.changedUnits;
+            info->fileBytes = sizeof(header) + payload.size();
+            info->micros = (uint64)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        }
+        return true;
+    }
+
+private:
+    const std::string prefix;
+    const uint32 baseEvery;
+    std::unique_ptr<CONTRACT_STATE> previous;
+    std::vector<uint8> payload;
+    bool written = false;
+    uint16 previousEpoch = 0;
+    uint32 sinceBase = 0;
+};
+
+// Rebuilds the state of epoch from its checkpoint chain. Fails on a missing
+// or foreign link, or when any step does not reproduce its recorded hash.
+inline bool restore(const std::string& prefix, uint16 epoch, CONTRACT_STATE& state, ContractSystem* system = nullptr,
+    uint32* chainLength = nullptr)
+{
+    // Walk back to the base; parents are always older epochs
+    std::vector<uint16> chain;
+    CheckpointHeader header;
+    for (uint16 link = epoch;;) {
+        if (!readHeader(checkpointPath(prefix, link), header)) {
+            return false;
+        }
+        chain.push_back(link);
+        if (header.kind == CHECKPOINT_BASE) {
+            break;
+        }
+        if (header.kind != CHECKPOINT_DELTA || header.parentEpoch >= link) {
+            return false;
+        }
+        link = header.parentEpoch;
+    }
+
+    memset((void*)&state, 0, sizeof(state));
+    std::vector<uint8> payload;
+    for (auto link = chain.rbegin(); link != chain.rend(); ++link) {
+        if (!readHeader(checkpointPath(prefix, *link), header, &payload)
+            || !applyPayload(payload, header.changedUnits, state) || stateHash(state) != header.stateHash) {
+            return false;
+        }
+    }
+
+    if (system) {
+        system->tick = header.tick;
+        system->epoch = header.epoch;
+    }
+    if (chainLength) {
+        *chainLength = (uint32)chain.size();
+    }
+    return true;
+}
+
+} // namespace checkpoint
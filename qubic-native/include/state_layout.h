@@ -0,0 +1,169 @@
+// Layout of the record structs CONTRACT_STATE holds in arrays, worked out by
+// the compiler from HM25.h: size, alignment, the padding holes between
+// fields and the bytes each array takes at the configured capacities.
+//
+// Fields are listed by hand in declaration order. A field added to HM25.h
+// but not here shows up as a new hole, so the padding budget flags it until
+// the list is updated.
+//
+// The budgets are the layout as of the last deliberate change. state_layout
+// (make layout) reports against them and fails when a struct or the whole
+// state grows; lower them when a change shrinks the state, raise them only
+// on purpose.
+
+#pragma once
+
+#include <cstddef>
+
+#include "contract_layout.h"
+
+namespace state_layout
+{
+
+// Budgets
+constexpr uint64 STATE_SIZE_BUDGET = 7882656;
+
+struct FieldInfo
+{
+    const char* name;
+    uint32 offset;
+    uint32 size;
+};
+
+struct StructInfo
+{
+    const char* name;
+    uint32 size;
+    uint32 align;
+    const FieldInfo* fields;
+    uint32 fieldCount;
+    uint32 capacity;       // Elements of the array in CONTRACT_STATE
+    uint32 sizeBudget;
+    uint32 paddingBudget;  // Bytes per element
+};
+
+#define STATE_FIELD(Type, field) FieldInfo{ #field, (uint32)offsetof(Type, field), (uint32)sizeof(Type::field) }
+
+constexpr FieldInfo USER_FIELDS[] = {
+    STATE_FIELD(User, username), STATE_FIELD(User, passwordHash), STATE_FIELD(User, balance),
+    STATE_FIELD(User, totalBets), STATE_FIELD(User, totalWins), STATE_FIELD(User, isActive), STATE_FIELD(User, id),
+    STATE_FIELD(User, openBets), STATE_FIELD(User, openStake), STATE_FIELD(User, realizedPnl),
+};
+
+constexpr FieldInfo EVENT_FIELDS[] = {
+    STATE_FIELD(Event, title), STATE_FIELD(Event, description), STATE_FIELD(Event, category),
+    STATE_FIELD(Event, createdAt), STATE_FIELD(Event, endsAt), STATE_FIELD(Event, isActive),
+    STATE_FIELD(Event, isResolved), STATE_FIELD(Event, correctAnswer), STATE_FIELD(Event, outcomeCount),
+    STATE_FIELD(Event, totalBets), STATE_FIELD(Event, yesBets), STATE_FIELD(Event, noBets), STATE_FIELD(Event, id),
+};
+
+constexpr FieldInfo BET_FIELDS[] = {
+    STATE_FIELD(Bet, userId), STATE_FIELD(Bet, eventId), STATE_FIELD(Bet, prediction), STATE_FIELD(Bet, amount),
+    STATE_FIELD(Bet, createdAt), STATE_FIELD(Bet, isWon), STATE_FIELD(Bet, isProcessed), STATE_FIELD(Bet, id),
+};
+
+constexpr FieldInfo ORDER_FIELDS[] = {
+    STATE_FIELD(Order, userId), STATE_FIELD(Order, eventId), STATE_FIELD(Order, quantity), STATE_FIELD(Order, prev),
+    STATE_FIELD(Order, next), STATE_FIELD(Order, generation), STATE_FIELD(Order, price), STATE_FIELD(Order, side),
+    STATE_FIELD(Order, isActive),
+};
+
+constexpr FieldInfo POSITION_FIELDS[] = {
+    STATE_FIELD(Position, userId), STATE_FIELD(Position, eventId), STATE_FIELD(Position, yesShares),
+    STATE_FIELD(Position, noShares), STATE_FIELD(Position, nextInEvent),
+};
+
+constexpr FieldInfo ORDER_BOOK_FIELDS[] = {
+    STATE_FIELD(OrderBook, bidHead), STATE_FIELD(OrderBook, bidTail), STATE_FIELD(OrderBook, askHead),
+    STATE_FIELD(OrderBook, askTail), STATE_FIELD(OrderBook, bidQuantity), STATE_FIELD(OrderBook, askQuantity),
+    STATE_FIELD(OrderBook, positionHead), STATE_FIELD(OrderBook, bestBid), STATE_FIELD(OrderBook, bestAsk),
+};
+
+constexpr FieldInfo MARKET_MAKER_FIELDS[] = {
+    STATE_FIELD(MarketMaker, collected), STATE_FIELD(MarketMaker, liquidity), STATE_FIELD(MarketMaker, yesShares),
+    STATE_FIELD(MarketMaker, noShares), STATE_FIELD(MarketMaker, isEnabled),
+};
+
+constexpr FieldInfo OUTCOME_TALLY_FIELDS[] = {
+    STATE_FIELD(OutcomeTally, bets),
+};
+
+#undef STATE_FIELD
+
+#define STATE_STRUCT(Type, fields, capacity, sizeBudget, paddingBudget) \
+    StructInfo{ #Type, (uint32)sizeof(Type), (uint32)alignof(Type), fields, (uint32)(sizeof(fields) / sizeof(FieldInfo)), \
+        capacity, sizeBudget, paddingBudget }
+
+constexpr StructInfo STRUCTS[] = {
+    STATE_STRUCT(User, USER_FIELDS, MAX_USERS, 104, 3),
+    STATE_STRUCT(Event, EVENT_FIELDS, MAX_EVENTS, 444, 0),
+    STATE_STRUCT(Bet, BET_FIELDS, MAX_BETS, 28, 5),
+    STATE_STRUCT(Order, ORDER_FIELDS, MAX_ORDERS, 28, 1),
+    STATE_STRUCT(Position, POSITION_FIELDS, MAX_POSITIONS, 20, 0),
+    STATE_STRUCT(OrderBook, ORDER_BOOK_FIELDS, MAX_EVENTS, 2384, 2),
+    STATE_STRUCT(MarketMaker, MARKET_MAKER_FIELDS, MAX_EVENTS, 24, 3),
+    STATE_STRUCT(OutcomeTally, OUTCOME_TALLY_FIELDS, MAX_EVENTS, 64, 0),
+};
+
+#undef STATE_STRUCT
+
+constexpr uint32 STRUCT_COUNT = sizeof(STRUCTS) / sizeof(StructInfo);
+
+constexpr uint32 fieldBytes(const StructInfo& info)
+{
+    uint32 bytes = 0;
+    for (uint32 i = 0; i < info.fieldCount; i++) {
+        bytes += info.fields[i].size;
+    }
+    return bytes;
+}
+
+// Holes between fields and after the last one
+constexpr uint32 padding(const StructInfo& info)
+{
+    return info.size - fieldBytes(info);
+}
+
+// Bytes of padding before field i, or after the last field for i == fieldCount
+constexpr uint32 holeBefore(const StructInfo& info, uint32 i)
+{
+    const uint32 end = i ? info.fields[i - 1].offset + info.fields[i - 1].size : 0;
+    return (i < info.fieldCount ? info.fields[i].offset : info.size) - end;
+}
+
+// Fields listed in declaration order, none overlapping, all inside the struct
+constexpr bool fieldsInOrder(const StructInfo& info)
+{
+    uint32 end = 0;
+    for (uint32 i = 0; i < info.fieldCount; i++) {
+        if (info.fields[i].offset < end) {
+            return false;
+        }
+        end = info.fields[i].offset + info.fields[i].size;
+    }
+    return end <= info.size;
+}
+
+constexpr bool allFieldsInOrder()
+{
+    for (uint32 i = 0; i < STRUCT_COUNT; i++) {
+        if (!fieldsInOrder(STRUCTS[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(allFieldsInOrder(), "state_layout.h field lists must follow the declaration order in HM25.h");
+
+constexpr uint64 arrayBytes(const StructInfo& info)
+{
+    return (uint64)info.size * info.capacity;
+}
+
+constexpr uint64 arrayPadding(const StructInfo& info)
+{
+    return (uint64)padding(info) * info.capacity;
+}
+
+} // namespace state_layout
@@ -0,0 +1,63 @@
+// Contract state snapshots: a small header followed by the raw
+// CONTRACT_STATE bytes of qubic-contracts/HM25.h. The header records the
+// state size, so a snapshot written by a different build of the contract is
+// refused instead of misread.
+
+#pragma once
+
+#include <cstdio>
+
+#include "contract_layout.h"
+
+namespace snapshot
+{
+
+constexpr uint32 SNAPSHOT_MAGIC = 0x53445250;  // "PRDS"
+constexpr uint32 SNAPSHOT_VERSION = 1;
+
+struct SnapshotHeader
+{
+    uint32 magic;
+    uint32 version;
+    uint64 stateSize;
+    uint32 tick;
+    uint16 epoch;
+    uint16 reserved;
+};
+
+inline bool save(const char* path, const CONTRACT_STATE& state, const ContractSystem& system)
+{
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    const SnapshotHeader header = { SNAPSHOT_MAGIC, SNAPSHOT_VERSION, sizeof(CONTRACT_STATE), system.tick, system.epoch, 0 };
+    const bool written = fwrite(&header, sizeof(header), 1, file) == 1
+        && fwrite(&state, sizeof(state), 1, file) == 1;
+    return fclose(file) == 0 && written;
+}
+
+// Fills state (and system, when given) from the snapshot at path
+inline bool load(const char* path, CONTRACT_STATE& state, ContractSystem* system = nullptr)
+{
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    SnapshotHeader header;
+    bool loaded = fread(&header, sizeof(header), 1, file) == 1
+        && header.magic == SNAPSHOT_MAGIC && header.version == SNAPSHOT_VERSION
+        && header.stateSize == sizeof(CONTRACT_STATE)
+        && fread(&state, sizeof(state), 1, file) == 1;
+    fclose(file);
+
+    if (loaded && system) {
+        system->tick = header.tick;
+        system->epoch = header.epoch;
+    }
+    return loaded;
+}
+
+} // namespace snapshot
@@ -0,0 +1,99 @@
+// Fixed set of worker threads for data-parallel phases in the native tools.
+// run() hands the same task to every worker, the calling thread included as
+// worker 0, and returns once all of them finished; tasks split their work
+// by worker index or by pulling items from an atomic counter.
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "contract_layout.h"
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(uint32 threads)
+        : threadCount(threads ? threads : 1)
+    {
+        for (uint32 worker = 1; worker < threadCount; worker++) {
+            workers.emplace_back([this, worker] { workerLoop(worker); });
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            generation++;
+        }
+        started.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    uint32 size() const
+    {
+        return threadCount;
+    }
+
+    void run(const std::function<void(uint32)>& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            current = &task;
+            pending = threadCount - 1;
+            generation++;
+        }
+        started.notify_all();
+
+        task(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        finished.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    const uint32 threadCount;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    const std::function<void(uint32)>* current = nullptr;
+    uint64 generation = 0;
+    uint32 pending = 0;
+    bool stopping = false;
+
+    void workerLoop(uint32 worker)
+    {
+        uint64 seen = 0;
+        for (;;) {
+            const std::function<void(uint32)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                started.wait(lock, [&] { return generation != seen; });
+                seen = generation;
+                if (stopping) {
+                    return;
+                }
+                task = current;
+            }
+
+            (*task)(worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+};
@@ -0,0 +1,142 @@
+// Per-tick admission control for contract calls, used by mock_node and
+// workload.
+//
+// A call costs 1 plus the elements it scanned, as the contract reports in
+// lastElementsScanned for its function (function index and STAT_ index are
+// the same in HM25.h). Before a call runs, its cost is estimated from the
+// recent calls of that function: the estimate jumps to any higher cost at
+// once and decays by an eighth per call otherwise, so a ResolveEvent that
+// just scanned the whole bet table is not underestimated for the next one.
+//
+// A call is admitted while its estimate fits in what is left of the tick's
+// limit. The first call of a tick is always admitted, so a call costlier
+// than the whole limit still runs, alone in its tick.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include "contract_layout.h"
+
+static_assert(STAT_PROCEDURE_COUNT == contract_abi::FUNCTION_COUNT, "tick_budget.h reads lastElementsScanned by function index");
+
+enum OverBudgetPolicy : uint8
+{
+    OVER_BUDGET_DEFER = 0,   // Leave the call, and the calls queued after it, for the next tick
+    OVER_BUDGET_REJECT = 1,  // Fail the call and go on with the next one
+};
+
+// One finished tick
+struct TickUsage
+{
+    uint64 spent = 0;
+    uint32 admitted = 0;
+    uint32 deferred = 0;
+    uint32 rejected = 0;
+};
+
+class TickBudget
+{
+public:
+    // limit 0 admits everything but still tracks costs
+    explicit TickBudget(uint64 limit)
+        : limit(limit), estimates(STAT_PROCEDURE_COUNT, 1)
+    {
+    }
+
+    uint64 ceiling() const
+    {
+        return limit;
+    }
+
+    uint64 estimate(uint16 function) const
+    {
+        return function < estimates.size() ? estimates[function] : 1;
+    }
+
+    bool admit(uint16 function) const
+    {
+        return !limit || current.admitted == 0 || current.spent + estimate(function) <= limit;
+    }
+
+    // Charges a call that ran, from the contract's counters
+    void charge(const CONTRACT_STATE& state, uint16 function)
+    {
+        const uint64 cost = 1 + (function < STAT_PROCEDURE_COUNT ? state.lastElementsScanned[function] : 0);
+        current.spent += cost;
+        current.admitted++;
+        if (function < estimates.size()) {
+            estimates[function] = std::max(cost, estimates[function] - estimates[function] / 8);
+        }
+    }
+
+    void defer(uint32 calls)
+    {
+        current.deferred += calls;
+    }
+
+    void reject()
+    {
+        current.rejected++;
+    }
+
+    // Closes the tick: returns its usage and starts a new one
+    TickUsage endTick()
+    {
+        const TickUsage finished = current;
+        current = TickUsage();
+        return finished;
+    }
+
+private:
+    uint64 limit;
+    std::vector<uint64> estimates;  // By function index
+    TickUsage current;
+};
+
+// How close ticks came to the limit, over a run or an epoch
+class BudgetReport
+{
+public:
+    static constexpr uint32 BUCKETS = 5;
+
+    void add(const TickUsage& usage, uint64 limit)
+    {
+        ticks++;
+        spent += usage.spent;
+        peak = std::max(peak, usage.spent);
+        deferred += usage.deferred;
+        rejected += usage.rejected;
+        if (limit) {
+            const double share = (double)usage.spent / limit;
+            buckets[share < 0.5 ? 0 : share < 0.8 ? 1 : share < 0.95 ? 2 : share <= 1.0 ? 3 : 4]++;
+        }
+    }
+
+    // e.g. "budget 20000: avg 41% peak 100% ticks <50%=80 50-80%=12 80-95%=5 95-100%=3 over=0 deferred=120 rejected=0"
+    void print(FILE* out, uint64 limit) const
+    {
+        if (!limit) {
+            fprintf(out, "budget unlimited: avg cost %.0f, peak %llu", ticks ? (double)spent / ticks : 0.0,
+                (unsigned long long)peak);
+            return;
+        }
+        static const char* const NAMES[BUCKETS] = { "<50%", "50-80%", "80-95%", "95-100%", "over" };
+        fprintf(out, "budget %llu: avg %.0f%% peak %.0f%% ticks", (unsigned long long)limit,
+            ticks ? 100.0 * spent / ticks / limit : 0.0, 100.0 * peak / limit);
+        for (uint32 i = 0; i < BUCKETS; i++) {
+            fprintf(out, " %s=%u", NAMES[i], buckets[i]);
+        }
+        fprintf(out, " deferred=%llu rejected=%llu", (unsigned long long)deferred, (unsigned long long)rejected);
+    }
+
+private:
+    uint32 ticks = 0;
+    uint64 spent = 0;
+    uint64 peak = 0;
+    uint64 deferred = 0;
+    uint64 rejected = 0;
+    uint32 buckets[BUCKETS] = {};
+};
@@ -0,0 +1,98 @@
+// Local framing spoken between the bridge, qubic_clientd and the node side.
+// Mirrored in qubic-bridge/wire-protocol.ts; payloads are the packed contract
+// structs described by contract_layout.h.
+
+#pragma once
+
+#include "../contract_core/contract_def.h"
+
+namespace wire
+{
+
+enum FrameType : uint16
+{
+    FRAME_CALL_FUNCTION = 1,     // Read-only call; payload is the input struct
+    FRAME_SEND_TRANSACTION = 2,  // Payload is TransactionPrefix then the input struct
+    FRAME_RESPONSE = 3,          // Payload is the output struct when status is STATUS_OK
+    FRAME_TRANSACTION_BATCH = 4, // Payload is a sequence of FRAME_SEND_TRANSACTION frames
+    FRAME_GET_TICK = 5,          // No payload; answered with TickInfo
+    FRAME_QUERY_BETS = 6,        // read_replica only; payload is BetQuery, answered with BetQueryResult then BetRecords
+};
+
+enum FrameStatus : uint16
+{
+    STATUS_OK = 0,
+    STATUS_UNKNOWN_FUNCTION = 1,
+    STATUS_BAD_INPUT = 2,
+    STATUS_UNAVAILABLE = 3,      // No upstream node connection
+    STATUS_OVER_BUDGET = 4,      // Transaction rejected: the tick's cost budget was used up
+};
+
+struct FrameHeader
+{
+    uint32 size;           // Whole frame, header included
+    uint16 type;
+    uint16 inputType;      // Contract function index
+    uint32 requestId;      // Echoed in the matching FRAME_RESPONSE
+    uint16 contractIndex;  // Contract instance on the node
+    uint16 status;
+};
+
+struct TransactionPrefix
+{
+    uint64 amount;         // QU attached to the transaction
+};
+
+struct TickInfo
+{
+    uint32 tick;
+    uint16 epoch;
+    uint16 reserved;
+};
+
+// Bet filter served by read_replica. Zero userId / eventId match any;
+// maxAmount 0 means no upper bound.
+struct BetQuery
+{
+    uint32 userId;
+    uint32 eventId;
+    uint32 minAmount;
+    uint32 maxAmount;
+    uint32 offset;         // Matches to skip, for paging
+    uint16 limit;          // Records wanted, at most MAX_QUERY_BETS
+    uint8 unsettledOnly;
+    uint8 kernel;          // ScanKernel in bet_scan.h; 0 = the replica's default
+};
+
+struct BetQueryResult
+{
+    uint32 total;          // Matches over the whole bet table
+    uint32 count;          // BetRecords that follow
+    uint32 tick;           // Tick of the mirrored state
+    uint32 scanMicros;
+};
+
+struct BetRecord
+{
+    uint32 id;
+    uint32 userId;
+    uint32 eventId;
+    uint32 amount;
+    uint32 createdAt;
+    uint8 prediction;
+    uint8 isWon;
+    uint8 isProcessed;
+    uint8 reserved;
+};
+
+static_assert(sizeof(FrameHeader) == 16, "FrameHeader is shared with wire-protocol.ts");
+static_assert(sizeof(TransactionPrefix) == 8, "TransactionPrefix is shared with wire-protocol.ts");
+static_assert(sizeof(TickInfo) == 8, "TickInfo is shared with wire-protocol.ts");
+static_assert(sizeof(BetQuery) == 24, "BetQuery is shared with wire-protocol.ts");
+static_assert(sizeof(BetQueryResult) == 16, "BetQueryResult is shared with wire-protocol.ts");
+static_assert(sizeof(BetRecord) == 24, "BetRecord is shared with wire-protocol.ts");
+
+constexpr uint32 MAX_FRAME_SIZE = 1 << 20;
+constexpr uint32 MAX_QUERY_BETS = 1000;
+
+} // namespace wire
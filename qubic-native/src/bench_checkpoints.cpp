@@ -0,0 +1,227 @@
+// bench_checkpoints: epoch delta checkpoints (state_checkpoint.h) against
+// full snapshots.
+//
+// Runs one contract through epochs of registrations, new events, flat bets,
+// order book trades and batch resolutions, checkpointing it at every epoch
+// with several base intervals at once. Then restores every epoch from every
+// checkpoint set and checks it against the hash of the live state taken at
+// that epoch, and the last epoch byte for byte. Reports storage against one
+// full snapshot per epoch, write time, chain length and restore time.
+//
+// Usage: bench_checkpoints [epochs]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "contract_host.h"
+#include "state_checkpoint.h"
+#include "state_snapshot.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x636b707473ULL, 0, 0, 0 } };
+constexpr uint32 START_USERS = 5000;
+constexpr uint32 USERS_PER_EPOCH = 20;
+constexpr uint32 EVENTS_PER_EPOCH = 20;
+constexpr uint32 BETS_PER_EPOCH = 2000;
+constexpr uint32 ORDERS_PER_EPOCH = 60;
+constexpr uint32 TICKS_PER_EPOCH = 10;
+constexpr uint32 BENCH_BALANCE = 1000000;
+
+struct CheckpointSet
+{
+    uint32 baseEvery;
+    std::string prefix;
+    std::unique_ptr<checkpoint::CheckpointWriter> writer;
+    uint64 baseBytes = 0;
+    uint64 deltaBytes = 0;
+    uint32 bases = 0;
+    uint32 deltas = 0;
+    uint64 writeUs = 0;
+};
+
+struct Simulation
+{
+    ContractHost host;
+    std::mt19937 rng;
+    uint32 nextResolve = 5;  // Initialize's sample events stay open
+
+    Simulation()
+        : host(OPERATOR_ID), rng(43)
+    {
+        registerUsers(START_USERS - 1);
+        createEvents(EVENTS_PER_EPOCH * 2);
+    }
+
+    CONTRACT_STATE& state()
+    {
+        return host.instance().state;
+    }
+
+    void registerUsers(uint32 count)
+    {
+        for (uint32 i = 0; i < count && state().userCount < MAX_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+            state().users[state().userCount - 1].balance = BENCH_BALANCE;
+        }
+    }
+
+    void createEvents(uint32 count)
+    {
+        for (uint32 i = 0; i < count && state().eventCount < MAX_EVENTS; i++) {
+            CreateEventInput input = {};
+            input.endsAt = host.system().tick + 1000;
+            CreateEventOutput output;
+            host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+    }
+
+    // Bets go to the open events, which are the newest ones
+    uint32 openEvent()
+    {
+        return nextResolve + rng() % (state().eventCount - nextResolve + 1);
+    }
+
+    void runEpoch()
+    {
+        registerUsers(USERS_PER_EPOCH);
+        createEvents(EVENTS_PER_EPOCH);
+        for (uint32 tick = 0; tick < TICKS_PER_EPOCH; tick++) {
+            for (uint32 i = 0; i < BETS_PER_EPOCH / TICKS_PER_EPOCH && state().betCount < MAX_BETS; i++) {
+                PlaceBetInput input = { (uint32)(1 + rng() % state().userCount), openEvent(), (uint8)(rng() & 1),
+                    (uint32)(1 + rng() % 50) };
+                PlaceBetOutput output;
+                host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+            }
+            for (uint32 i = 0; i < ORDERS_PER_EPOCH / TICKS_PER_EPOCH; i++) {
+                PlaceOrderInput input = { (uint32)(1 + rng() % state().userCount), openEvent(), (uint32)(1 + rng() % 10),
+                    (uint8)(rng() & 1 ? ORDER_SIDE_SELL : ORDER_SIDE_BUY), (uint8)(40 + rng() % 21) };
+                PlaceOrderOutput output;
+                host.call(8, OPERATOR_ID, &input, sizeof(input), &output);
+            }
+            host.advanceTick();
+        }
+
+        // Settle the oldest open events, as many as were created
+        ResolveEventsInput input = {};
+        for (uint32 i = 0; i < EVENTS_PER_EPOCH && nextResolve <= state().eventCount; i++) {
+            input.eventIds[i] = nextResolve++;
+            input.correctAnswers[i] = (uint8)(rng() & 1);
+            input.confidences[i] = 100;
+            input.count = (uint8)(i + 1);
+        }
+        ResolveEventsOutput output;
+        host.call(16, OPERATOR_ID, &input, sizeof(input), &output);
+        host.advanceEpoch();
+    }
+};
+
+uint64 microsecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 epochs = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 40;
+    if (!epochs || epochs > MAX_BETS / BETS_PER_EPOCH) {
+        fprintf(stderr, "usage: %s [epochs]   (1..%u)\n", argv[0], MAX_BETS / BETS_PER_EPOCH);
+        return 2;
+    }
+
+    char directory[] = "/tmp/bench_checkpoints.XXXXXX";
+    if (!mkdtemp(directory)) {
+        fprintf(stderr, "bench_checkpoints: cannot create a scratch directory\n");
+        return 1;
+    }
+
+    std::vector<CheckpointSet> sets;
+    for (uint32 baseEvery : { 1u, 4u, 8u, 16u }) {
+        sets.push_back({ baseEvery, std::string(directory) + "/base" + std::to_string(baseEvery), nullptr });
+        sets.back().writer.reset(new checkpoint::CheckpointWriter(sets.back().prefix, baseEvery));
+    }
+
+    // Epochs written: the start, then the beginning of every simulated epoch
+    Simulation* simulation = new Simulation;
+    std::vector<uint16> written;
+    std::vector<uint64> hashes;
+    bool ok = true;
+    for (uint32 epoch = 0; epoch <= epochs; epoch++) {
+        if (epoch) {
+            simulation->runEpoch();
+        }
+        written.push_back(simulation->host.system().epoch);
+        hashes.push_back(checkpoint::stateHash(simulation->state()));
+        for (CheckpointSet& set : sets) {
+            checkpoint::CheckpointInfo info;
+            if (!set.writer->write(simulation->state(), simulation->host.system(), &info)) {
+                fprintf(stderr, "cannot write %s\n", checkpoint::checkpointPath(set.prefix, written.back()).c_str());
+                ok = false;
+                continue;
+            }
+            (info.kind == checkpoint::CHECKPOINT_BASE ? set.baseBytes : set.deltaBytes) += info.fileBytes;
+            (info.kind == checkpoint::CHECKPOINT_BASE ? set.bases : set.deltas)++;
+            set.writeUs += info.micros;
+        }
+    }
+
+    const CONTRACT_STATE& live = simulation->state();
+    const uint64 fullSize = sizeof(snapshot::SnapshotHeader) + sizeof(CONTRACT_STATE);
+    printf("%u epochs: %u users, %u events, %u bets; full snapshot %llu bytes\n\n", epochs, live.userCount,
+        live.eventCount, live.betCount, (unsigned long long)fullSize);
+    printf("%10s %12s %8s %11s %11s %10s %6s %12s %12s\n", "base every", "bytes", "of full", "avg base", "avg delta",
+        "write us", "chain", "restore us", "max restore");
+
+    std::unique_ptr<CONTRACT_STATE> restored(new CONTRACT_STATE);
+    for (CheckpointSet& set : sets) {
+        uint32 longestChain = 0;
+        uint64 restoreUs = 0;
+        uint64 slowestUs = 0;
+        for (size_t i = 0; i < written.size(); i++) {
+            uint32 chain = 0;
+            const auto start = std::chrono::steady_clock::now();
+            const bool restoredOk = checkpoint::restore(set.prefix, written[i], *restored, nullptr, &chain);
+            const uint64 elapsed = microsecondsSince(start);
+            if (!restoredOk || checkpoint::stateHash(*restored) != hashes[i]) {
+                fprintf(stderr, "base every %u: epoch %u does not restore to the live state\n", set.baseEvery, written[i]);
+                ok = false;
+            }
+            longestChain = std::max(longestChain, chain);
+            restoreUs += elapsed;
+            slowestUs = std::max(slowestUs, elapsed);
+        }
+        if (memcmp((const void*)restored.get(), &live, sizeof(live)) != 0) {
+            fprintf(stderr, "base every %u: last epoch differs from the live state\n", set.baseEvery);
+            ok = false;
+        }
+
+        const uint64 total = set.baseBytes + set.deltaBytes;
+        printf("%10u %12llu %7.2f%% %11llu %11llu %10llu %6u %12llu %12llu\n", set.baseEvery, (unsigned long long)total,
+            100.0 * total / (fullSize * written.size()), (unsigned long long)(set.bases ? set.baseBytes / set.bases : 0),
+            (unsigned long long)(set.deltas ? set.deltaBytes / set.deltas : 0),
+            (unsigned long long)(set.writeUs / written.size()), longestChain,
+            (unsigned long long)(restoreUs / written.size()), (unsigned long long)slowestUs);
+
+        for (uint16 epoch : written) {
+            unlink(checkpoint::checkpointPath(set.prefix, epoch).c_str());
+        }
+    }
+    rmdir(directory);
+    delete simulation;
+
+    printf(ok ? "\nEvery epoch restored to the live state from every checkpoint set.\n" : "\nCheckpoint restore check FAILED.\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+// bench_leaderboard: the maintained top-K leaderboard in HM25.h.
+//
+// Drives MAX_USERS users through rounds of flat bets, order book trades and
+// resolutions, and after every resolution checks the leaderboard against a
+// full sort of all users by totalWins: same win counts rank for rank, ranks
+// recorded for exactly the listed users. Then times GetLeaderboard against
+// the full scan it replaces.
+//
+// Usage: bench_leaderboard [rounds]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "contract_host.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x6c65616465727362ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = MAX_USERS;
+constexpr uint32 BENCH_BALANCE = 1000000;
+constexpr uint32 BETS_PER_ROUND = 600;
+constexpr uint32 ORDERS_PER_ROUND = 40;
+
+struct Bench
+{
+    ContractHost host;
+
+    Bench()
+        : host(OPERATOR_ID)
+    {
+        // Initialize created user 1; the harness funds every account directly
+        for (uint32 i = 1; i < BENCH_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < BENCH_USERS; i++) {
+            host.instance().state.users[i].balance = BENCH_BALANCE;
+        }
+    }
+
+    CONTRACT_STATE& state()
+    {
+        return host.instance().state;
+    }
+
+    GetLeaderboardOutput leaderboard(uint32 count)
+    {
+        GetLeaderboardInput input = { count };
+        GetLeaderboardOutput output;
+        host.call(17, OPERATOR_ID, &input, sizeof(input), &output);
+        return output;
+    }
+
+    // Bets and crossing orders on a fresh event, then its resolution
+    void playRound(std::mt19937& rng)
+    {
+        CreateEventInput create = {};
+        CreateEventOutput created;
+        host.call(1, OPERATOR_ID, &create, sizeof(create), &created);
+
+        // A skewed user distribution lets some users pull ahead
+        std::uniform_int_distribution<uint32> anyUser(1, BENCH_USERS);
+        for (uint32 i = 0; i < BETS_PER_ROUND; i++) {
+            PlaceBetInput input = {};
+            input.userId = rng() % 4 ? 1 + rng() % 200 : anyUser(rng);
+            input.eventId = created.eventId;
+            input.prediction = (uint8)(rng() & 1);
+            input.amount = 1 + rng() % 20;
+            PlaceBetOutput output;
+            host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < ORDERS_PER_ROUND; i++) {
+            PlaceOrderInput input = { anyUser(rng), created.eventId, (uint32)(1 + rng() % 5), (uint8)(i & 1), 50 };
+            PlaceOrderOutput output;
+            host.call(8, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+
+        ResolveEventsInput input = {};
+        input.eventIds[0] = created.eventId;
+        input.correctAnswers[0] = (uint8)(rng() & 1);
+        input.count = 1;
+        ResolveEventsOutput output;
+        host.call(16, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+};
+
+// Top `count` win counts by sorting every user, as a scan-based ranking would
+std::vector<uint32> topWinsByScan(CONTRACT_STATE& state, uint32 count)
+{
+    std::vector<uint32> wins(state.userCount);
+    for (uint32 i = 0; i < state.userCount; i++) {
+        wins[i] = state.users[i].totalWins;
+    }
+    count = std::min(count, (uint32)wins.size());
+    std::partial_sort(wins.begin(), wins.begin() + count, wins.end(), std::greater<uint32>());
+    wins.resize(count);
+    return wins;
+}
+
+bool check(Bench& bench, uint32 round)
+{
+    CONTRACT_STATE& state = bench.state();
+    const GetLeaderboardOutput board = bench.leaderboard(LEADERBOARD_SIZE);
+    const std::vector<uint32> expected = topWinsByScan(state, LEADERBOARD_SIZE);
+
+    uint32 ranked = 0;
+    for (uint32 i = 0; i < state.userCount; i++) {
+        ranked += state.leaderboardRank[i] != 0;
+    }
+    if (ranked != board.count) {
+        fprintf(stderr, "round %u: %u users carry a rank, board lists %u\n", round, ranked, board.count);
+        return false;
+    }
+
+    for (uint32 rank = 0; rank < LEADERBOARD_SIZE; rank++) {
+        // Users without wins never enter the board
+        const uint32 wanted = rank < expected.size() ? expected[rank] : 0;
+        const uint32 listed = rank < board.count ? board.totalWins[rank] : 0;
+        if (wanted != listed
+            || (rank < board.count && state.leaderboardRank[board.userIds[rank] - 1] != rank + 1)) {
+            fprintf(stderr, "round %u, rank %u: board has user %u with %u wins, full sort has %u wins\n",
+                round, rank + 1, board.userIds[rank], listed, wanted);
+            return false;
+        }
+    }
+    return true;
+}
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 rounds = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 150;
+    if (!rounds || rounds > MAX_EVENTS - 4 || (uint64)rounds * BETS_PER_ROUND > MAX_BETS) {
+        fprintf(stderr, "usage: %s [rounds]   (at most %u)\n", argv[0], MAX_BETS / BETS_PER_ROUND);
+        return 2;
+    }
+
+    Bench* bench = new Bench();
+    std::mt19937 rng(17);
+    bool ok = true;
+    for (uint32 round = 0; round < rounds && ok; round++) {
+        bench->playRound(rng);
+        ok = check(*bench, round);
+    }
+
+    const uint32 iterations = 2000;
+    uint64 sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; i++) {
+        sink += bench->leaderboard(10 + i % 41).totalWins[0];
+    }
+    const double boardNs = nanosecondsSince(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations / 20; i++) {
+        sink += topWinsByScan(bench->state(), 10 + i % 41)[0];
+    }
+    const double scanNs = nanosecondsSince(start) / (iterations / 20);
+
+    const GetLeaderboardOutput top = bench->leaderboard(3);
+    printf("%u rounds, %u users, leaderboard holds %u; top wins %u / %u / %u\n", rounds, BENCH_USERS,
+        bench->state().leaderboardCount, top.totalWins[0], top.totalWins[1], top.totalWins[2]);
+    printf("%-28s %10.0f ns\n", "GetLeaderboard(10..50)", boardNs);
+    printf("%-28s %10.0f ns\n", "full scan + partial sort", scanNs);
+    printf("(sink %llu)\n", (unsigned long long)(sink & 0xff));
+
+    delete bench;
+    printf(ok ? "\nLeaderboard matched a full sort after every resolution.\n" : "\nLeaderboard check FAILED.\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,227 @@
+// bench_lmsr: LMSR market maker in HM25.h.
+//
+// Compares the contract's fixed-point quotes with the same formulas in double
+// precision, times QuoteBet and market maker PlaceBet against flat PlaceBet,
+// and checks that the market maker never loses more than its b ln 2 bound.
+//
+// Usage: bench_lmsr [iterations]
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "contract_host.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x626c6d7362656e63ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 64;
+constexpr uint32 BENCH_BALANCE = 1000000000;
+constexpr uint32 MAKER_EVENT = 1;  // Created by Initialize
+constexpr uint32 FLAT_EVENT = 2;
+
+struct Bench
+{
+    ContractHost host;
+
+    explicit Bench(uint32 liquidity)
+        : host(OPERATOR_ID)
+    {
+        // Initialize created user 1; the harness funds every account directly
+        for (uint32 i = 1; i < BENCH_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < BENCH_USERS; i++) {
+            host.instance().state.users[i].balance = BENCH_BALANCE;
+        }
+
+        EnableMarketMakerInput input = { MAKER_EVENT, liquidity };
+        EnableMarketMakerOutput output;
+        host.call(11, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+
+    QuoteBetOutput quote(uint8 prediction, uint32 shares)
+    {
+        QuoteBetInput input = {};
+        input.eventId = MAKER_EVENT;
+        input.amount = shares;
+        input.prediction = prediction;
+        QuoteBetOutput output;
+        host.call(12, OPERATOR_ID, &input, sizeof(input), &output);
+        return output;
+    }
+
+    PlaceBetOutput placeBet(uint32 userId, uint32 eventId, uint8 prediction, uint32 amount)
+    {
+        PlaceBetInput input = {};
+        input.userId = userId;
+        input.eventId = eventId;
+        input.prediction = prediction;
+        input.amount = amount;
+        PlaceBetOutput output;
+        host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+        return output;
+    }
+
+    MarketMaker& maker()
+    {
+        return host.instance().state.makers[MAKER_EVENT - 1];
+    }
+};
+
+double softplus(double x)
+{
+    return x > 0 ? x + log1p(exp(-x)) : log1p(exp(x));
+}
+
+// Exact LMSR cost of `shares` shares in payout units of ORDER_SHARE_PAYOUT
+double exactCost(double liquidity, double yesShares, double noShares, uint8 prediction, double shares)
+{
+    const double d = (prediction ? yesShares - noShares : noShares - yesShares) / liquidity;
+    return ORDER_SHARE_PAYOUT * liquidity * (softplus(d + shares / liquidity) - softplus(d));
+}
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Sweeps market states and trade sizes; returns false on any quote below the
+// exact cost, which would let traders drain the maker
+bool checkAccuracy()
+{
+    printf("%10s %10s %14s %14s %14s\n", "b", "quotes", "max abs err", "max rel err", "max bps err");
+    printf("%10s %10s %14s %14s %14s\n", "", "", "", "(cost >= 1000)", "(YES price)");
+    bool ok = true;
+    const uint32 liquidities[] = { 10, 100, 1000, 100000, LMSR_MAX_LIQUIDITY };
+    for (uint32 liquidity : liquidities) {
+        Bench* bench = new Bench(liquidity);
+        double maxAbsolute = 0;
+        double maxRelative = 0;
+        double maxPriceBps = 0;
+        uint32 quotes = 0;
+
+        for (double imbalance = -20; imbalance <= 20; imbalance += 0.37) {
+            const uint32 offset = (uint32)(fabs(imbalance) * liquidity);
+            bench->maker().yesShares = imbalance > 0 ? offset : 0;
+            bench->maker().noShares = imbalance > 0 ? 0 : offset;
+
+            for (uint32 shares = 1; shares <= 10 * liquidity && shares <= LMSR_MAX_TRADE; shares = shares * 3 + 1) {
+                for (uint8 prediction = 0; prediction < 2; prediction++) {
+                    const QuoteBetOutput quote = bench->quote(prediction, shares);
+                    const double exact = exactCost(liquidity, bench->maker().yesShares, bench->maker().noShares, prediction, shares);
+                    const double error = quote.cost - exact;
+                    quotes++;
+
+                    maxAbsolute = std::max(maxAbsolute, fabs(error));
+                    if (exact >= 1000) {
+                        maxRelative = std::max(maxRelative, fabs(error) / exact);
+                    }
+                    if (error < 0) {
+                        fprintf(stderr, "b=%u q=(%u, %u) %s x%u: quoted %u, exact %.3f\n", liquidity,
+                            bench->maker().yesShares, bench->maker().noShares, prediction ? "YES" : "NO", shares,
+                            quote.cost, exact);
+                        ok = false;
+                    }
+
+                    const double exactPrice = 1 / (1 + exp(-((double)bench->maker().yesShares - bench->maker().noShares) / liquidity));
+                    maxPriceBps = std::max(maxPriceBps, fabs(quote.yesPriceBps - exactPrice * PRICE_BASIS_POINTS));
+                }
+            }
+        }
+
+        printf("%10u %10u %14.3f %14.6f %14.3f\n", liquidity, quotes, maxAbsolute, maxRelative, maxPriceBps);
+        delete bench;
+    }
+    return ok;
+}
+
+void benchmarkThroughput(uint32 iterations)
+{
+    Bench* bench = new Bench(1000);
+    std::mt19937 rng(3);
+
+    auto start = std::chrono::steady_clock::now();
+    uint64 sink = 0;
+    for (uint32 i = 0; i < iterations; i++) {
+        sink += bench->quote((uint8)(i & 1), 1 + rng() % 100).cost;
+    }
+    const double quoteNs = nanosecondsSince(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; i++) {
+        sink += bench->placeBet(1 + i % BENCH_USERS, MAKER_EVENT, (uint8)(i & 1), 1 + rng() % 100).newBalance;
+    }
+    const double makerNs = nanosecondsSince(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; i++) {
+        sink += bench->placeBet(1 + i % BENCH_USERS, FLAT_EVENT, (uint8)(i & 1), 1 + rng() % 100).newBalance;
+    }
+    const double flatNs = nanosecondsSince(start) / iterations;
+
+    printf("\n%-24s %10s %12s\n", "call", "ns/call", "calls/s");
+    printf("%-24s %10.0f %12.0f\n", "QuoteBet", quoteNs, 1e9 / quoteNs);
+    printf("%-24s %10.0f %12.0f\n", "PlaceBet (market maker)", makerNs, 1e9 / makerNs);
+    printf("%-24s %10.0f %12.0f\n", "PlaceBet (flat)", flatNs, 1e9 / flatNs);
+    printf("(sink %llu)\n", (unsigned long long)(sink & 0xff));
+    delete bench;
+}
+
+// Random trades, then resolution; the maker's loss is what users gained
+bool checkLossBound(uint32 trades)
+{
+    const uint32 liquidity = 500;
+    Bench* bench = new Bench(liquidity);
+    std::mt19937 rng(11);
+
+    const uint64 initial = (uint64)BENCH_USERS * BENCH_BALANCE;
+    for (uint32 i = 0; i < trades; i++) {
+        // Drift towards YES so the market ends far from even
+        bench->placeBet(1 + rng() % BENCH_USERS, MAKER_EVENT, rng() % 10 < 6 ? 1 : 0, 1 + rng() % 200);
+    }
+
+    ResolveEventInput input = { MAKER_EVENT, 1, 100 };
+    ResolveEventOutput output;
+    bench->host.call(3, OPERATOR_ID, &input, sizeof(input), &output);
+
+    uint64 balances = 0;
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        balances += bench->host.instance().state.users[i].balance;
+    }
+    const double loss = (double)balances - (double)initial;
+    const double bound = ORDER_SHARE_PAYOUT * liquidity * log(2.0);
+    printf("\nmaker loss after %u trades: %.0f (bound b ln 2 = %.0f, collected %llu)\n",
+        trades, loss, bound, (unsigned long long)bench->maker().collected);
+
+    delete bench;
+    return loss <= bound;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 iterations = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 200000;
+    if (!iterations) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 2;
+    }
+
+    printf("LMSR quotes against double precision (costs in balance units)\n\n");
+    const bool accurate = checkAccuracy();
+    benchmarkThroughput(iterations);
+    const bool bounded = checkLossBound(20000);
+
+    if (!accurate || !bounded) {
+        printf("\nLMSR check FAILED.\n");
+        return 1;
+    }
+    printf("\nQuotes never undercut the exact cost and the loss stays within b ln 2.\n");
+    return 0;
+}
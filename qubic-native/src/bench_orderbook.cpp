@@ -0,0 +1,316 @@
+// bench_orderbook: order book matching cost in HM25.h against book depth.
+//
+// For several resting book depths, times PlaceOrder that rests, CancelOrder,
+// and crossing PlaceOrder calls that fill 1, 8 and 64 maker orders, so the
+// cost per fill can be compared across depths. Then runs a randomized
+// order/cancel sequence and checks that value is conserved: balances plus
+// locked order collateral plus outstanding YES/NO share pairs never change,
+// and resolution returns everything to balances. Last, trades on more
+// (user, event) pairs than MAX_POSITION_LOAD over several epochs, resolving
+// each epoch's events, to check that END_EPOCH gives their position slots
+// back and keeps the positions of an open event.
+//
+// Usage: bench_orderbook [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "contract_host.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x626f6f6b62656e63ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 1000;
+constexpr uint32 BENCH_BALANCE = 1000000;
+constexpr uint32 BENCH_EVENT = 1;
+
+struct Bench
+{
+    ContractHost host;
+
+    Bench()
+        : host(OPERATOR_ID)
+    {
+        // Initialize created user 1; the harness funds every account directly
+        for (uint32 i = 1; i < BENCH_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < BENCH_USERS; i++) {
+            host.instance().state.users[i].balance = BENCH_BALANCE;
+        }
+    }
+
+    PlaceOrderOutput placeOrder(uint32 userId, uint8 side, uint8 price, uint32 quantity, uint32 eventId = BENCH_EVENT)
+    {
+        PlaceOrderInput input = { userId, eventId, quantity, side, price };
+        PlaceOrderOutput output;
+        host.call(8, OPERATOR_ID, &input, sizeof(input), &output);
+        return output;
+    }
+
+    CancelOrderOutput cancelOrder(uint32 userId, uint32 orderId)
+    {
+        CancelOrderInput input = { userId, orderId };
+        CancelOrderOutput output;
+        host.call(9, OPERATOR_ID, &input, sizeof(input), &output);
+        return output;
+    }
+
+    // Half the depth as bids at 1..40, half as asks at 60..99
+    void fillBook(uint32 depth)
+    {
+        for (uint32 i = 0; i < depth; i++) {
+            const uint32 userId = 1 + i % BENCH_USERS;
+            if (i % 2) {
+                placeOrder(userId, ORDER_SIDE_BUY, (uint8)(1 + i % 40), 1 + i % 5);
+            } else {
+                placeOrder(userId, ORDER_SIDE_SELL, (uint8)(60 + i % 40), 1 + i % 5);
+            }
+        }
+    }
+};
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void benchmarkDepth(uint32 depth, uint32 iterations)
+{
+    Bench* bench = new Bench();
+    bench->fillBook(depth);
+
+    // Resting orders that improve the best bid, then their cancellation
+    std::vector<uint32> orderIds(iterations);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; i++) {
+        orderIds[i] = bench->placeOrder(1 + i % BENCH_USERS, ORDER_SIDE_BUY, 45, 1).orderId;
+    }
+    const double restNs = nanosecondsSince(start) / iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < iterations; i++) {
+        bench->cancelOrder(1 + i % BENCH_USERS, orderIds[i]);
+    }
+    const double cancelNs = nanosecondsSince(start) / iterations;
+
+    // Takers that consume exactly `fills` one-share asks at 50
+    double fillNs[3];
+    const uint32 fillCounts[3] = { 1, 8, 64 };
+    for (uint32 f = 0; f < 3; f++) {
+        double total = 0;
+        const uint32 rounds = iterations / fillCounts[f] + 1;
+        for (uint32 round = 0; round < rounds; round++) {
+            for (uint32 i = 0; i < fillCounts[f]; i++) {
+                bench->placeOrder(1 + (round + i) % BENCH_USERS, ORDER_SIDE_SELL, 50, 1);
+            }
+            start = std::chrono::steady_clock::now();
+            bench->placeOrder(1 + (round * 7) % BENCH_USERS, ORDER_SIDE_BUY, 50, fillCounts[f]);
+            total += nanosecondsSince(start);
+        }
+        fillNs[f] = total / rounds;
+    }
+
+    printf("%8u %10.0f %10.0f %10.0f %10.0f %10.0f %10.1f\n",
+        depth, restNs, cancelNs, fillNs[0], fillNs[1], fillNs[2], fillNs[2] / 64);
+    delete bench;
+}
+
+// Balances + locked order collateral + ORDER_SHARE_PAYOUT per outstanding
+// YES/NO pair; returns false when YES and NO shares of an event diverge
+bool totalValue(Bench& bench, uint64& total)
+{
+    const CONTRACT_STATE& state = bench.host.instance().state;
+    total = 0;
+    for (uint32 i = 0; i < state.userCount; i++) {
+        total += state.users[i].balance;
+    }
+    for (uint32 i = 0; i < state.orderHighWater; i++) {
+        const Order& order = state.orders[i];
+        if (order.isActive) {
+            total += (uint64)order.quantity * (order.side == ORDER_SIDE_BUY ? order.price : ORDER_SHARE_PAYOUT - order.price);
+        }
+    }
+
+    uint64 yesShares[MAX_EVENTS] = {};
+    uint64 noShares[MAX_EVENTS] = {};
+    for (uint32 i = 0; i < MAX_POSITIONS; i++) {
+        const Position& position = state.positions[i];
+        if (position.userId) {
+            yesShares[position.eventId - 1] += position.yesShares;
+            noShares[position.eventId - 1] += position.noShares;
+        }
+    }
+    for (uint32 i = 0; i < state.eventCount; i++) {
+        if (yesShares[i] != noShares[i]) {
+            fprintf(stderr, "event %u: %llu YES shares but %llu NO shares\n",
+                i + 1, (unsigned long long)yesShares[i], (unsigned long long)noShares[i]);
+            return false;
+        }
+        total += yesShares[i] * ORDER_SHARE_PAYOUT;
+    }
+    return true;
+}
+
+bool verifyConservation(uint32 operations)
+{
+    Bench* bench = new Bench();
+    std::mt19937 rng(7);
+    std::vector<std::pair<uint32, uint32>> resting;  // (userId, orderId)
+
+    uint64 initial;
+    totalValue(*bench, initial);
+
+    bool ok = true;
+    for (uint32 i = 0; i < operations && ok; i++) {
+        if (!resting.empty() && rng() % 4 == 0) {
+            const uint32 pick = rng() % resting.size();
+            bench->cancelOrder(resting[pick].first, resting[pick].second);
+            resting[pick] = resting.back();
+            resting.pop_back();
+        } else {
+            const uint32 userId = 1 + rng() % 50;
+            const PlaceOrderOutput output = bench->placeOrder(userId, (uint8)(rng() % 2), (uint8)(30 + rng() % 41),
+                1 + rng() % 20, 1 + rng() % 2);
+            if (output.orderId) {
+                resting.push_back({ userId, output.orderId });
+            }
+        }
+
+        uint64 total;
+        ok = totalValue(*bench, total);
+        if (ok && total != initial) {
+            fprintf(stderr, "operation %u: total value %llu, expected %llu\n",
+                i, (unsigned long long)total, (unsigned long long)initial);
+            ok = false;
+        }
+    }
+
+    // Resolution refunds resting orders and pays one side of every pair
+    for (uint32 eventId = 1; eventId <= 2 && ok; eventId++) {
+        ResolveEventInput input = { eventId, (uint8)(eventId % 2), 100 };
+        ResolveEventOutput output;
+        bench->host.call(3, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+
+    uint64 balances = 0;
+    for (uint32 i = 0; i < bench->host.instance().state.userCount; i++) {
+        balances += bench->host.instance().state.users[i].balance;
+    }
+    if (ok && balances != initial) {
+        fprintf(stderr, "after resolution balances hold %llu, expected %llu\n",
+            (unsigned long long)balances, (unsigned long long)initial);
+        ok = false;
+    }
+
+    delete bench;
+    return ok;
+}
+
+// Every user on one side of a one-share trade at 50: two new positions per pair
+bool tradeEveryUser(Bench& bench, uint32 eventId)
+{
+    for (uint32 userId = 1; userId + 1 <= BENCH_USERS; userId += 2) {
+        bench.placeOrder(userId, ORDER_SIDE_SELL, 50, 1, eventId);
+        if (bench.placeOrder(userId + 1, ORDER_SIDE_BUY, 50, 1, eventId).filledQuantity != 1) {
+            fprintf(stderr, "event %u: trade between users %u and %u did not fill (%u positions)\n",
+                eventId, userId, userId + 1, bench.host.instance().state.positionCount);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool verifyPositionReuse()
+{
+    constexpr uint32 EVENTS_PER_EPOCH = 8;
+    constexpr uint32 EPOCHS = 4;
+    static_assert(EVENTS_PER_EPOCH * BENCH_USERS < MAX_POSITION_LOAD, "one epoch must fit the position table");
+    static_assert(EPOCHS * EVENTS_PER_EPOCH * BENCH_USERS > MAX_POSITION_LOAD, "the run must outgrow the position table");
+
+    Bench* bench = new Bench();
+    const CONTRACT_STATE& state = bench->host.instance().state;
+    uint64 initial;
+    totalValue(*bench, initial);
+
+    // BENCH_EVENT stays open throughout; its positions must survive every rebuild
+    bool ok = tradeEveryUser(*bench, BENCH_EVENT);
+    const uint32 openPositions = state.positionCount;
+
+    uint64 created = openPositions;
+    for (uint32 epoch = 0; epoch < EPOCHS && ok; epoch++) {
+        for (uint32 i = 0; i < EVENTS_PER_EPOCH && ok; i++) {
+            CreateEventInput input = {};
+            CreateEventOutput output;
+            bench->host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+            ok = output.success && tradeEveryUser(*bench, output.eventId);
+            created += BENCH_USERS;
+
+            ResolveEventInput resolve = { output.eventId, (uint8)(i % 2), 100 };
+            ResolveEventOutput resolved;
+            bench->host.call(3, OPERATOR_ID, &resolve, sizeof(resolve), &resolved);
+        }
+        bench->host.advanceEpoch();
+
+        if (ok && state.positionCount != openPositions) {
+            fprintf(stderr, "epoch %u: %u positions after END_EPOCH, expected %u\n", epoch, state.positionCount, openPositions);
+            ok = false;
+        }
+    }
+
+    // The open event's positions are still found: trading again adds none
+    if (ok) {
+        ok = tradeEveryUser(*bench, BENCH_EVENT);
+    }
+    if (ok && state.positionCount != openPositions) {
+        fprintf(stderr, "open event: %u positions after trading again, expected %u\n", state.positionCount, openPositions);
+        ok = false;
+    }
+
+    uint64 total;
+    if (ok && (!totalValue(*bench, total) || total != initial)) {
+        fprintf(stderr, "after %llu positions: total value %llu, expected %llu\n",
+            (unsigned long long)created, (unsigned long long)total, (unsigned long long)initial);
+        ok = false;
+    }
+    if (ok) {
+        printf("Position table reused: %llu positions over %u epochs, load limit %u.\n",
+            (unsigned long long)created, EPOCHS, MAX_POSITION_LOAD);
+    }
+
+    delete bench;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 iterations = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 2000;
+    if (!iterations) {
+        fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+        return 2;
+    }
+
+    printf("Order book matching, %u iterations per column (ns per call)\n\n", iterations);
+    printf("%8s %10s %10s %10s %10s %10s %10s\n", "depth", "rest", "cancel", "1 fill", "8 fills", "64 fills", "per fill");
+    const uint32 depths[] = { 0, 100, 1000, 10000 };
+    for (uint32 depth : depths) {
+        benchmarkDepth(depth, iterations);
+    }
+
+    const bool conserved = verifyConservation(20000);
+    printf(conserved ? "\nValue conserved across 20000 random orders and cancels and through resolution.\n"
+                     : "\nConservation check FAILED.\n");
+    const bool reused = verifyPositionReuse();
+    if (!reused) {
+        printf("Position reuse check FAILED.\n");
+    }
+    return conserved && reused ? 0 : 1;
+}
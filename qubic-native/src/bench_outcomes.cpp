@@ -0,0 +1,219 @@
+// bench_outcomes: one N-outcome market against N binary markets.
+//
+// The same bets are placed two ways: on one event with N outcomes, and as
+// YES bets on one of N binary events (a bet on outcome k is a YES on event
+// k). The binary set is settled with N ResolveEvent calls and with one
+// ResolveEvents call, the multi-outcome event with a single ResolveEvent and
+// with a one-entry ResolveEvents.
+// Reports events used, time and elements scanned for each, and checks that
+// all four leave the same balances, wins, P&L and bet flags, and that
+// GetOutcomeTally matches the per-event bet counts of the binary set.
+//
+// Usage: bench_outcomes [bets]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "contract_host.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x6f7574636f6dULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 1000;
+constexpr uint32 BENCH_BALANCE = 1000000;
+
+struct Bench
+{
+    ContractHost host;
+    uint32 firstEventId;
+
+    // One event with `outcomes` outcomes, or that many binary events
+    Bench(uint32 outcomes, bool multiOutcome)
+        : host(OPERATOR_ID)
+    {
+        // Initialize created user 1 and the sample events
+        for (uint32 i = 1; i < BENCH_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < BENCH_USERS; i++) {
+            state().users[i].balance = BENCH_BALANCE;
+        }
+
+        firstEventId = state().eventCount + 1;
+        for (uint32 i = 0; i < (multiOutcome ? 1 : outcomes); i++) {
+            CreateEventInput input = {};
+            input.outcomeCount = (uint8)(multiOutcome ? outcomes : 2);
+            CreateEventOutput output;
+            host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+    }
+
+    CONTRACT_STATE& state()
+    {
+        return host.instance().state;
+    }
+
+    uint32 events()
+    {
+        return state().eventCount - firstEventId + 1;
+    }
+};
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+void placeBets(Bench& singles, Bench& batch, Bench& multi, Bench& multiBatch, uint32 outcomes, uint32 bets)
+{
+    std::mt19937 rng(outcomes);
+    for (uint32 i = 0; i < bets; i++) {
+        const uint32 userId = 1 + rng() % BENCH_USERS;
+        const uint8 outcome = (uint8)(rng() % outcomes);
+        const uint32 amount = 1 + rng() % 50;
+        PlaceBetOutput output;
+
+        PlaceBetInput binary = { userId, singles.firstEventId + outcome, 1, amount };
+        singles.host.call(2, OPERATOR_ID, &binary, sizeof(binary), &output);
+        batch.host.call(2, OPERATOR_ID, &binary, sizeof(binary), &output);
+
+        PlaceBetInput input = { userId, multi.firstEventId, outcome, amount };
+        multi.host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+        multiBatch.host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+}
+
+bool sameOutcome(Bench& binary, Bench& multi, const char* name)
+{
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        const User& expected = multi.state().users[i];
+        const User& user = binary.state().users[i];
+        if (user.balance != expected.balance || user.totalWins != expected.totalWins
+            || user.openStake != expected.openStake || user.realizedPnl != expected.realizedPnl) {
+            fprintf(stderr, "%s, user %u: balance %u / %u, wins %u / %u, realized %lld / %lld\n", name, i + 1,
+                user.balance, expected.balance, user.totalWins, expected.totalWins, (long long)user.realizedPnl,
+                (long long)expected.realizedPnl);
+            return false;
+        }
+    }
+    for (uint32 i = 0; i < multi.state().betCount; i++) {
+        if (binary.state().bets[i].isProcessed != multi.state().bets[i].isProcessed
+            || binary.state().bets[i].isWon != multi.state().bets[i].isWon) {
+            fprintf(stderr, "%s, bet %u settled differently\n", name, i + 1);
+            return false;
+        }
+    }
+    return binary.state().settlementBacklog == multi.state().settlementBacklog;
+}
+
+bool sameTally(Bench& binary, Bench& multi, uint32 outcomes)
+{
+    GetOutcomeTallyInput input = { multi.firstEventId };
+    GetOutcomeTallyOutput output;
+    multi.host.call(19, OPERATOR_ID, &input, sizeof(input), &output);
+    if (!output.success || output.outcomeCount != outcomes) {
+        fprintf(stderr, "GetOutcomeTally failed for %u outcomes\n", outcomes);
+        return false;
+    }
+    for (uint32 k = 0; k < outcomes; k++) {
+        if (output.bets[k] != binary.state().events[binary.firstEventId - 1 + k].yesBets) {
+            fprintf(stderr, "outcome %u: %u bets, binary event has %u\n", k, output.bets[k],
+                binary.state().events[binary.firstEventId - 1 + k].yesBets);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool compare(uint32 outcomes, uint32 bets)
+{
+    Bench* singles = new Bench(outcomes, false);
+    Bench* batch = new Bench(outcomes, false);
+    Bench* multi = new Bench(outcomes, true);
+    Bench* multiBatch = new Bench(outcomes, true);
+    placeBets(*singles, *batch, *multi, *multiBatch, outcomes, bets);
+    bool ok = sameTally(*singles, *multi, outcomes);
+
+    const uint8 winner = (uint8)(outcomes / 2);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 k = 0; k < outcomes; k++) {
+        ResolveEventInput input = { singles->firstEventId + k, (uint8)(k == winner), 100 };
+        ResolveEventOutput output;
+        singles->host.call(3, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+    const double singlesNs = nanosecondsSince(start);
+
+    ResolveEventsInput batchInput = {};
+    for (uint32 k = 0; k < outcomes; k++) {
+        batchInput.eventIds[k] = batch->firstEventId + k;
+        batchInput.correctAnswers[k] = (uint8)(k == winner);
+        batchInput.confidences[k] = 100;
+    }
+    batchInput.count = (uint8)outcomes;
+    ResolveEventsOutput batchOutput;
+    start = std::chrono::steady_clock::now();
+    batch->host.call(16, OPERATOR_ID, &batchInput, sizeof(batchInput), &batchOutput);
+    const double batchNs = nanosecondsSince(start);
+
+    ResolveEventInput input = { multi->firstEventId, winner, 100 };
+    ResolveEventOutput output;
+    start = std::chrono::steady_clock::now();
+    multi->host.call(3, OPERATOR_ID, &input, sizeof(input), &output);
+    const double multiNs = nanosecondsSince(start);
+
+    batchInput = {};
+    batchInput.eventIds[0] = multiBatch->firstEventId;
+    batchInput.correctAnswers[0] = winner;
+    batchInput.confidences[0] = 100;
+    batchInput.count = 1;
+    ResolveEventsOutput multiBatchOutput;
+    start = std::chrono::steady_clock::now();
+    multiBatch->host.call(16, OPERATOR_ID, &batchInput, sizeof(batchInput), &multiBatchOutput);
+    const double multiBatchNs = nanosecondsSince(start);
+
+    ok = output.success && batchOutput.resolvedCount == outcomes && multiBatchOutput.resolvedCount == 1
+        && sameOutcome(*singles, *multi, "ResolveEvent") && sameOutcome(*batch, *multi, "ResolveEvents")
+        && sameOutcome(*multiBatch, *multi, "multi-outcome ResolveEvents") && ok;
+    printf("%8u %7u / %u %12.1f %12.1f %12.1f %12.1f %14llu %14llu %14llu %14llu\n", outcomes, singles->events(),
+        multi->events(), singlesNs / 1e3, batchNs / 1e3, multiNs / 1e3, multiBatchNs / 1e3,
+        (unsigned long long)singles->state().elementsScanned[STAT_RESOLVE_EVENT],
+        (unsigned long long)batch->state().elementsScanned[STAT_RESOLVE_EVENTS],
+        (unsigned long long)multi->state().elementsScanned[STAT_RESOLVE_EVENT],
+        (unsigned long long)multiBatch->state().elementsScanned[STAT_RESOLVE_EVENTS]);
+
+    delete singles;
+    delete batch;
+    delete multi;
+    delete multiBatch;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 bets = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 90000;
+    if (!bets || bets > MAX_BETS) {
+        fprintf(stderr, "usage: %s [bets]   (at most MAX_BETS = %u)\n", argv[0], MAX_BETS);
+        return 2;
+    }
+
+    printf("Settling %u bets over N outcomes: N binary events against one N-outcome event\n\n", bets);
+    printf("%8s %11s %12s %12s %12s %12s %14s %14s %14s %14s\n", "outcomes", "events", "singles us", "batch us",
+        "multi us", "m-batch us", "singles scans", "batch scans", "multi scans", "m-batch scans");
+
+    bool ok = true;
+    const uint32 outcomeCounts[] = { 3, 4, 8, MAX_OUTCOMES };
+    for (uint32 outcomes : outcomeCounts) {
+        ok = compare(outcomes, bets) && ok;
+    }
+
+    printf(ok ? "\nOne multi-outcome market settles exactly like its binary equivalent.\n"
+              : "\nMulti-outcome settlement check FAILED.\n");
+    return ok ? 0 : 1;
+}
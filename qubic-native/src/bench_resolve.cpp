@@ -0,0 +1,242 @@
+// bench_resolve: ResolveEvents against one ResolveEvent call per event.
+//
+// Builds two identical contracts holding flat bets, resting orders and order
+// book positions on BENCH_EVENTS events, then resolves the first K events
+// with K ResolveEvent calls on one and a single ResolveEvents call on the
+// other. Reports time and elements scanned per resolved event, and checks
+// that both leave the same balances, win counts and bet flags. Last, checks
+// the open stake limit the same aggregates feed: only the operator sets it,
+// a bet past it is rejected, and settling frees the stake again.
+//
+// Usage: bench_resolve [bets]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "contract_host.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x7265736f6c76ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 1000;
+constexpr uint32 BENCH_BALANCE = 1000000;
+constexpr uint32 BENCH_EVENTS = MAX_RESOLVE_BATCH;
+
+struct Bench
+{
+    ContractHost host;
+
+    explicit Bench(uint32 bets)
+        : host(OPERATOR_ID)
+    {
+        // Initialize created user 1 and the first events
+        for (uint32 i = 1; i < BENCH_USERS; i++) {
+            RegisterUserInput input = {};
+            RegisterUserOutput output;
+            host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        for (uint32 i = 0; i < BENCH_USERS; i++) {
+            host.instance().state.users[i].balance = BENCH_BALANCE;
+        }
+        while (host.instance().state.eventCount < BENCH_EVENTS) {
+            CreateEventInput input = {};
+            CreateEventOutput output;
+            host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+
+        std::mt19937 rng(5);
+        for (uint32 i = 0; i < bets; i++) {
+            PlaceBetInput input = {};
+            input.userId = 1 + rng() % BENCH_USERS;
+            input.eventId = 1 + rng() % BENCH_EVENTS;
+            input.prediction = (uint8)(rng() & 1);
+            input.amount = 1 + rng() % 50;
+            PlaceBetOutput output;
+            host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+
+        // A crossed pair leaves positions, a third order rests in the book
+        for (uint32 eventId = 1; eventId <= BENCH_EVENTS; eventId++) {
+            for (uint32 i = 0; i < 3; i++) {
+                PlaceOrderInput input = { (uint32)(1 + rng() % BENCH_USERS), eventId, (uint32)(1 + rng() % 10),
+                    (uint8)(i == 1 ? ORDER_SIDE_SELL : ORDER_SIDE_BUY), (uint8)(i == 2 ? 30 : 50) };
+                PlaceOrderOutput output;
+                host.call(8, OPERATOR_ID, &input, sizeof(input), &output);
+            }
+        }
+    }
+
+    CONTRACT_STATE& state()
+    {
+        return host.instance().state;
+    }
+};
+
+uint8 answerFor(uint32 eventId)
+{
+    return (uint8)(eventId * 7 % 3 != 0);
+}
+
+double nanosecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool sameOutcome(Bench& single, Bench& batch)
+{
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        if (single.state().users[i].balance != batch.state().users[i].balance
+            || single.state().users[i].totalWins != batch.state().users[i].totalWins) {
+            fprintf(stderr, "user %u: balance %u / %u, wins %u / %u\n", i + 1,
+                single.state().users[i].balance, batch.state().users[i].balance,
+                single.state().users[i].totalWins, batch.state().users[i].totalWins);
+            return false;
+        }
+        if (single.state().users[i].openStake != batch.state().users[i].openStake
+            || single.state().users[i].realizedPnl != batch.state().users[i].realizedPnl) {
+            fprintf(stderr, "user %u: open stake %llu / %llu, realized %lld / %lld\n", i + 1,
+                (unsigned long long)single.state().users[i].openStake, (unsigned long long)batch.state().users[i].openStake,
+                (long long)single.state().users[i].realizedPnl, (long long)batch.state().users[i].realizedPnl);
+            return false;
+        }
+    }
+    for (uint32 i = 0; i < single.state().betCount; i++) {
+        if (single.state().bets[i].isProcessed != batch.state().bets[i].isProcessed
+            || single.state().bets[i].isWon != batch.state().bets[i].isWon) {
+            fprintf(stderr, "bet %u settled differently\n", i + 1);
+            return false;
+        }
+    }
+    return single.state().settlementBacklog == batch.state().settlementBacklog;
+}
+
+bool compare(uint32 batchSize, uint32 bets)
+{
+    Bench* single = new Bench(bets);
+    Bench* batch = new Bench(bets);
+
+    uint64 singleWinners = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32 eventId = 1; eventId <= batchSize; eventId++) {
+        ResolveEventInput input = { eventId, answerFor(eventId), 100 };
+        ResolveEventOutput output;
+        single->host.call(3, OPERATOR_ID, &input, sizeof(input), &output);
+        singleWinners += output.winnersCount;
+    }
+    const double singleNs = nanosecondsSince(start);
+    const uint64 singleScanned = single->state().elementsScanned[STAT_RESOLVE_EVENT];
+
+    ResolveEventsInput input = {};
+    for (uint32 i = 0; i < batchSize; i++) {
+        input.eventIds[i] = i + 1;
+        input.correctAnswers[i] = answerFor(i + 1);
+        input.confidences[i] = 100;
+    }
+    input.count = (uint8)batchSize;
+    ResolveEventsOutput output;
+    start = std::chrono::steady_clock::now();
+    batch->host.call(16, OPERATOR_ID, &input, sizeof(input), &output);
+    const double batchNs = nanosecondsSince(start);
+    const uint64 batchScanned = batch->state().elementsScanned[STAT_RESOLVE_EVENTS];
+
+    uint64 batchWinners = 0;
+    for (uint32 i = 0; i < batchSize; i++) {
+        batchWinners += output.winnersCount[i];
+    }
+
+    const bool ok = output.resolvedCount == batchSize && batchWinners == singleWinners && sameOutcome(*single, *batch);
+    printf("%6u %14.1f %14.1f %14.0f %14.0f %8.1fx\n", batchSize,
+        singleNs / batchSize / 1e3, batchNs / batchSize / 1e3,
+        (double)singleScanned / batchSize, (double)batchScanned / batchSize, singleNs / batchNs);
+
+    delete single;
+    delete batch;
+    return ok;
+}
+
+bool verifyExposureLimit()
+{
+    constexpr uint32 LIMIT = 100;
+    constexpr uint32 USER_ID = 2;
+    constexpr m256i OTHER_ID = { { 1, 0, 0, 0 } };
+
+    Bench* bench = new Bench(0);
+    const CONTRACT_STATE& state = bench->state();
+    const auto placeBet = [&](uint32 eventId, uint32 amount) {
+        PlaceBetInput input = {};
+        input.userId = USER_ID;
+        input.eventId = eventId;
+        input.prediction = 1;
+        input.amount = amount;
+        PlaceBetOutput output;
+        bench->host.call(contract_abi::FUNCTION_PLACE_BET, OPERATOR_ID, &input, sizeof(input), &output);
+        return output.success != 0;
+    };
+
+    bool ok = true;
+    SetMaxOpenStakeInput input = { LIMIT };
+    SetMaxOpenStakeOutput output;
+    bench->host.call(contract_abi::FUNCTION_SET_MAX_OPEN_STAKE, OTHER_ID, &input, sizeof(input), &output);
+    if (output.success || state.maxOpenStake) {
+        fprintf(stderr, "SetMaxOpenStake accepted from a non-admin\n");
+        ok = false;
+    }
+    bench->host.call(contract_abi::FUNCTION_SET_MAX_OPEN_STAKE, OPERATOR_ID, &input, sizeof(input), &output);
+    if (!output.success || state.maxOpenStake != LIMIT) {
+        fprintf(stderr, "SetMaxOpenStake failed for the admin\n");
+        ok = false;
+    }
+
+    // Bets up to the limit go through, one unit past it does not
+    if (ok && (!placeBet(1, 60) || !placeBet(2, LIMIT - 60))) {
+        fprintf(stderr, "bets within the open stake limit were rejected\n");
+        ok = false;
+    }
+    if (ok && (placeBet(2, 1) || state.rejectionCount[REJECT_EXPOSURE_LIMIT] != 1)) {
+        fprintf(stderr, "a bet past the open stake limit was not rejected as exposureLimit\n");
+        ok = false;
+    }
+
+    // Settling event 1 frees its 60
+    ResolveEventInput resolve = { 1, answerFor(1), 100 };
+    ResolveEventOutput resolved;
+    bench->host.call(contract_abi::FUNCTION_RESOLVE_EVENT, OPERATOR_ID, &resolve, sizeof(resolve), &resolved);
+    if (ok && (!placeBet(3, 60) || placeBet(3, 1))) {
+        fprintf(stderr, "settling did not free the open stake, or freed too much\n");
+        ok = false;
+    }
+
+    delete bench;
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const uint32 bets = argc > 1 ? (uint32)strtoul(argv[1], nullptr, 10) : 90000;
+    if (!bets || bets > MAX_BETS) {
+        fprintf(stderr, "usage: %s [bets]   (at most MAX_BETS = %u)\n", argv[0], MAX_BETS);
+        return 2;
+    }
+
+    printf("Resolving K of %u events holding %u bets (per resolved event)\n\n", BENCH_EVENTS, bets);
+    printf("%6s %14s %14s %14s %14s %9s\n", "K", "single us", "batch us", "single scans", "batch scans", "speedup");
+
+    bool ok = true;
+    const uint32 batchSizes[] = { 1, 4, 16, MAX_RESOLVE_BATCH };
+    for (uint32 batchSize : batchSizes) {
+        ok = compare(batchSize, bets) && ok;
+    }
+
+    printf(ok ? "\nResolveEvents settles exactly like one ResolveEvent per event.\n"
+              : "\nBatch resolution check FAILED.\n");
+
+    const bool limited = verifyExposureLimit();
+    printf(limited ? "Open stake limit set by the operator only and enforced on PlaceBet.\n"
+                   : "Open stake limit check FAILED.\n");
+    return ok && limited ? 0 : 1;
+}
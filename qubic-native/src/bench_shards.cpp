@@ -0,0 +1,344 @@
+// bench_shards: weak scaling of a sharded PredictoR deployment.
+//
+// Runs 1, 2, 4 and 8 instances of HM25.h, one thread per shard, routed by
+// shard_map.h. Every shard takes the same number of bets per tick on its own
+// events; a configurable share of them comes from users whose home shard is
+// elsewhere. A tick has three phases separated by barriers, as a router
+// would sequence them across instances:
+//   1. each shard plans its bets and asks home shards for the funds of
+//      cross-shard bettors,
+//   2. home shards run ShardTransferOut for the requests addressed to them,
+//   3. event shards run ShardTransferIn for the funds that left, then PlaceBet.
+//
+// Aggregate throughput and scaling are measured against wall time, so they
+// only grow with the shard count while there is a core per shard thread.
+// A projection from the busiest shard thread's CPU time, what one core per
+// shard would deliver, is printed next to them; it is not a measurement,
+// as it leaves out the barrier waits and the cache and memory bandwidth
+// the threads share. Afterwards every unit of funding must be in a balance or a bet,
+// and the sums of ShardTransferOut and ShardTransferIn must agree.
+//
+// Usage: bench_shards [ticks] [bets-per-tick] [cross-shard-percent]
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "contract_host.h"
+#include "shard_map.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x7368617264626e63ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 2000;  // Divisible by every shard count run
+constexpr uint32 BENCH_BALANCE = 1000000;
+constexpr uint32 BENCH_EVENTS = 64;   // Per shard, including Initialize's
+constexpr uint32 MAX_BET_AMOUNT = 100;
+
+struct Options
+{
+    uint32 ticks = 40;
+    uint32 betsPerTick = 2000;
+    uint32 crossPercent = 20;
+};
+
+// Reusable barrier for the tick phases (std::barrier needs C++20)
+class Barrier
+{
+public:
+    explicit Barrier(uint32 parties)
+        : parties(parties)
+    {
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        const uint64 arrival = generation;
+        if (++waiting == parties) {
+            waiting = 0;
+            generation++;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&] { return generation != arrival; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable released;
+    const uint32 parties;
+    uint32 waiting = 0;
+    uint64 generation = 0;
+};
+
+struct PlannedBet
+{
+    uint32 userId;
+    uint32 eventId;  // Local to the shard placing it
+    uint32 amount;
+    uint8 prediction;
+};
+
+// Funds for one cross-shard bet, from the user's home shard to an event shard
+struct Transfer
+{
+    uint32 userId;
+    uint32 amount;
+    uint8 sent;
+};
+
+struct Shard
+{
+    std::unique_ptr<ContractHost> host;
+    std::vector<PlannedBet> bets;
+    double cpuSeconds = 0;
+    uint64 placed = 0;
+    uint64 rejected = 0;
+};
+
+struct Cluster
+{
+    ShardMap map;
+    std::vector<Shard> shards;
+    std::vector<std::vector<Transfer>> outbox;  // [homeShard * N + eventShard]
+    Barrier barrier;
+
+    explicit Cluster(uint32 shardCount)
+        : shards(shardCount), outbox(shardCount * shardCount), barrier(shardCount)
+    {
+        map.shardCount = shardCount;
+    }
+};
+
+double threadCpuSeconds()
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Same users on every shard, funded on their home shard only
+void setUpShard(Cluster& cluster, uint32 shard)
+{
+    cluster.shards[shard].host.reset(new ContractHost(OPERATOR_ID));
+    ContractHost& host = *cluster.shards[shard].host;
+
+    ConfigureShardInput configure = { shard, cluster.map.shardCount };
+    ConfigureShardOutput configured;
+    host.call(13, OPERATOR_ID, &configure, sizeof(configure), &configured);
+
+    // Initialize created user 1 and the first events
+    for (uint32 i = 1; i < BENCH_USERS; i++) {
+        RegisterUserInput input = {};
+        RegisterUserOutput output;
+        host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        host.instance().state.users[i].balance = cluster.map.homeShard(i + 1) == shard ? BENCH_BALANCE : 0;
+    }
+    while (host.instance().state.eventCount < BENCH_EVENTS) {
+        CreateEventInput input = {};
+        CreateEventOutput output;
+        host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+}
+
+void runShard(Cluster& cluster, uint32 shard, const Options& options)
+{
+    Shard& self = cluster.shards[shard];
+    const uint32 shardCount = cluster.map.shardCount;
+    const uint32 homeUsers = BENCH_USERS / shardCount;
+    std::mt19937 rng(shard * 7919 + 1);
+
+    cluster.barrier.wait();
+    const double start = threadCpuSeconds();
+
+    for (uint32 tick = 0; tick < options.ticks; tick++) {
+        // Phase 1: plan bets, request funds for bettors homed elsewhere
+        self.bets.clear();
+        for (uint32 i = 0; i < options.betsPerTick; i++) {
+            uint32 home = shard;
+            if (shardCount > 1 && rng() % 100 < options.crossPercent) {
+                home = (shard + 1 + rng() % (shardCount - 1)) % shardCount;
+            }
+            PlannedBet bet;
+            bet.userId = 1 + home + shardCount * (rng() % homeUsers);
+            bet.eventId = 1 + rng() % BENCH_EVENTS;
+            bet.amount = 1 + rng() % MAX_BET_AMOUNT;
+            bet.prediction = (uint8)(rng() & 1);
+            self.bets.push_back(bet);
+
+            if (home != shard) {
+                cluster.outbox[home * shardCount + shard].push_back({ bet.userId, bet.amount, 0 });
+            }
+        }
+        cluster.barrier.wait();
+
+        // Phase 2: debit home balances for the other shards
+        for (uint32 target = 0; target < shardCount; target++) {
+            for (Transfer& transfer : cluster.outbox[shard * shardCount + target]) {
+                ShardTransferInput input = { transfer.userId, transfer.amount };
+                ShardTransferOutput output;
+                self.host->call(14, OPERATOR_ID, &input, sizeof(input), &output);
+                transfer.sent = output.success;
+            }
+        }
+        cluster.barrier.wait();
+
+        // Phase 3: credit what arrived, then place this shard's bets
+        for (uint32 home = 0; home < shardCount; home++) {
+            std::vector<Transfer>& inbound = cluster.outbox[home * shardCount + shard];
+            for (const Transfer& transfer : inbound) {
+                if (transfer.sent) {
+                    ShardTransferInput input = { transfer.userId, transfer.amount };
+                    ShardTransferOutput output;
+                    self.host->call(15, OPERATOR_ID, &input, sizeof(input), &output);
+                }
+            }
+            inbound.clear();
+        }
+        for (const PlannedBet& bet : self.bets) {
+            PlaceBetInput input = {};
+            input.userId = bet.userId;
+            input.eventId = bet.eventId;
+            input.prediction = bet.prediction;
+            input.amount = bet.amount;
+            PlaceBetOutput output;
+            self.host->call(2, OPERATOR_ID, &input, sizeof(input), &output);
+            if (output.success) {
+                self.placed++;
+            } else {
+                self.rejected++;
+            }
+        }
+        cluster.barrier.wait();
+    }
+
+    self.cpuSeconds = threadCpuSeconds() - start;
+}
+
+// Funding is conserved: balances plus placed bet amounts on all shards
+bool verify(Cluster& cluster, uint64& transfers)
+{
+    uint64 value = 0;
+    uint64 out = 0;
+    uint64 in = 0;
+    transfers = 0;
+    for (Shard& shard : cluster.shards) {
+        const CONTRACT_STATE& state = shard.host->instance().state;
+        for (uint32 i = 0; i < state.userCount; i++) {
+            value += state.users[i].balance;
+        }
+        value += state.totalVolume;
+        out += state.transferredOut;
+        in += state.transferredIn;
+        transfers += state.invocationCount[STAT_SHARD_TRANSFER_IN];
+    }
+
+    const uint64 funded = (uint64)BENCH_USERS * BENCH_BALANCE;
+    bool ok = true;
+    if (out != in) {
+        fprintf(stderr, "transferred out %llu but in %llu\n", (unsigned long long)out, (unsigned long long)in);
+        ok = false;
+    }
+    if (value != funded) {
+        fprintf(stderr, "balances and bets hold %llu, funded %llu\n", (unsigned long long)value, (unsigned long long)funded);
+        ok = false;
+    }
+    return ok;
+}
+
+bool runCluster(uint32 shardCount, const Options& options, double& baseline)
+{
+    Cluster cluster(shardCount);
+    {
+        std::vector<std::thread> threads;
+        for (uint32 shard = 0; shard < shardCount; shard++) {
+            threads.emplace_back(setUpShard, std::ref(cluster), shard);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32 shard = 0; shard < shardCount; shard++) {
+        threads.emplace_back(runShard, std::ref(cluster), shard, std::cref(options));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64 placed = 0;
+    uint64 rejected = 0;
+    double busiest = 0;
+    for (const Shard& shard : cluster.shards) {
+        placed += shard.placed;
+        rejected += shard.rejected;
+        busiest = std::max(busiest, shard.cpuSeconds);
+    }
+    uint64 transfers;
+    const bool ok = verify(cluster, transfers);
+
+    const double wallRate = placed / wallSeconds;
+    const double projected = placed / busiest;
+    if (shardCount == 1) {
+        baseline = wallRate;
+    }
+    printf("%6u %10llu %8llu %10llu %10.1f %12.0f %8.2fx %12.1f %13.0f\n", shardCount,
+        (unsigned long long)placed, (unsigned long long)rejected, (unsigned long long)transfers,
+        wallSeconds * 1e3, wallRate, wallRate / baseline, busiest * 1e3, projected);
+    return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (argc > 1) {
+        options.ticks = (uint32)strtoul(argv[1], nullptr, 10);
+    }
+    if (argc > 2) {
+        options.betsPerTick = (uint32)strtoul(argv[2], nullptr, 10);
+    }
+    if (argc > 3) {
+        options.crossPercent = (uint32)strtoul(argv[3], nullptr, 10);
+    }
+    if (!options.ticks || !options.betsPerTick || options.crossPercent > 100
+        || (uint64)options.ticks * options.betsPerTick > MAX_BETS) {
+        fprintf(stderr, "usage: %s [ticks] [bets-per-tick] [cross-shard-percent]\n", argv[0]);
+        fprintf(stderr, "ticks * bets-per-tick must not exceed MAX_BETS (%u)\n", MAX_BETS);
+        return 2;
+    }
+
+    printf("Sharded betting, %u ticks of %u bets per shard, %u%% from users homed on another shard\n",
+        options.ticks, options.betsPerTick, options.crossPercent);
+    printf("%u hardware threads; scaling is measured wall throughput against 1 shard. 'projected/s' is\n"
+           "not measured: it assumes one core per shard and divides by the busiest shard's CPU time.\n\n",
+        std::thread::hardware_concurrency());
+    printf("%6s %10s %8s %10s %10s %12s %9s %12s %13s\n",
+        "shards", "bets", "rejected", "transfers", "wall ms", "bets/s wall", "scaling", "busiest ms", "projected/s");
+
+    bool ok = true;
+    double baseline = 0;
+    const uint32 shardCounts[] = { 1, 2, 4, 8 };
+    for (uint32 shardCount : shardCounts) {
+        ok = runCluster(shardCount, options, baseline) && ok;
+    }
+
+    printf(ok ? "\nFunding conserved and shard transfers balanced at every shard count.\n"
+              : "\nShard check FAILED.\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,162 @@
+// checkpoints: inspect and restore the epoch checkpoints mock_node writes
+// with --checkpoints PREFIX (state_checkpoint.h).
+//
+//   list PREFIX                    every checkpoint: kind, parent, changed
+//                                  units and size against a full snapshot
+//   verify PREFIX                  restores every epoch and checks its hash
+//   restore PREFIX EPOCH SNAPSHOT  writes the state of EPOCH as a
+//                                  state_snapshot.h file, for read_replica,
+//                                  export_columns and the like
+//
+// Usage: checkpoints list|verify PREFIX
+//        checkpoints restore PREFIX EPOCH SNAPSHOT
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <dirent.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "state_checkpoint.h"
+#include "state_snapshot.h"
+
+namespace
+{
+
+uint64 microsecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Epochs with a PREFIX.<epoch>.ckpt file, ascending
+std::vector<uint16> findEpochs(const std::string& prefix)
+{
+    const size_t slash = prefix.rfind('/');
+    const std::string directory = slash == std::string::npos ? "." : prefix.substr(0, slash + 1);
+    const std::string stem = (slash == std::string::npos ? prefix : prefix.substr(slash + 1)) + ".";
+    const std::string suffix = ".ckpt";
+
+    std::vector<uint16> epochs;
+    DIR* dir = opendir(directory.c_str());
+    if (!dir) {
+        return epochs;
+    }
+    while (const dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.size() <= stem.size() + suffix.size() || name.compare(0, stem.size(), stem) != 0
+            || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+            continue;
+        }
+        const std::string epoch = name.substr(stem.size(), name.size() - stem.size() - suffix.size());
+        if (epoch.empty() || epoch.size() > 5 || epoch.find_first_not_of("0123456789") != std::string::npos) {
+            continue;
+        }
+        const unsigned long value = strtoul(epoch.c_str(), nullptr, 10);
+        if (value <= 0xffff) {
+            epochs.push_back((uint16)value);
+        }
+    }
+    closedir(dir);
+    std::sort(epochs.begin(), epochs.end());
+    return epochs;
+}
+
+int list(const std::string& prefix)
+{
+    const std::vector<uint16> epochs = findEpochs(prefix);
+    if (epochs.empty()) {
+        fprintf(stderr, "checkpoints: no %s.<epoch>.ckpt files\n", prefix.c_str());
+        return 1;
+    }
+
+    const uint64 fullSize = sizeof(snapshot::SnapshotHeader) + sizeof(CONTRACT_STATE);
+    uint64 total = 0;
+    printf("%6s %6s %6s %9s %10s %12s %8s\n", "epoch", "kind", "parent", "tick", "units", "bytes", "of full");
+    for (uint16 epoch : epochs) {
+        checkpoint::CheckpointHeader header;
+        if (!checkpoint::readHeader(checkpoint::checkpointPath(prefix, epoch), header)) {
+            printf("%6u unreadable, or from another build of HM25.h\n", epoch);
+            continue;
+        }
+        const uint64 bytes = sizeof(header) + header.payloadSize;
+        const bool base = header.kind == checkpoint::CHECKPOINT_BASE;
+        printf("%6u %6s %6s %9u %10u %12llu %7.2f%%\n", epoch, base ? "base" : "delta",
+            base ? "-" : std::to_string(header.parentEpoch).c_str(), header.tick, header.changedUnits,
+            (unsigned long long)bytes, 100.0 * bytes / fullSize);
+        total += bytes;
+    }
+    printf("\n%zu checkpoints, %llu bytes; full snapshots would take %llu (%.2f%%)\n", epochs.size(),
+        (unsigned long long)total, (unsigned long long)(fullSize * epochs.size()), 100.0 * total / (fullSize * epochs.size()));
+    return 0;
+}
+
+int verify(const std::string& prefix)
+{
+    const std::vector<uint16> epochs = findEpochs(prefix);
+    if (epochs.empty()) {
+        fprintf(stderr, "checkpoints: no %s.<epoch>.ckpt files\n", prefix.c_str());
+        return 1;
+    }
+
+    std::unique_ptr<CONTRACT_STATE> state(new CONTRACT_STATE);
+    uint32 failed = 0;
+    uint32 longestChain = 0;
+    uint64 slowestUs = 0;
+    for (uint16 epoch : epochs) {
+        uint32 chain = 0;
+        const auto start = std::chrono::steady_clock::now();
+        if (!checkpoint::restore(prefix, epoch, *state, nullptr, &chain)) {
+            fprintf(stderr, "epoch %u does not restore\n", epoch);
+            failed++;
+            continue;
+        }
+        longestChain = std::max(longestChain, chain);
+        slowestUs = std::max(slowestUs, microsecondsSince(start));
+    }
+    printf("%zu epochs, %u failed; longest chain %u, slowest restore %lluus\n", epochs.size(), failed, longestChain,
+        (unsigned long long)slowestUs);
+    return failed ? 1 : 0;
+}
+
+int restore(const std::string& prefix, uint16 epoch, const char* snapshotPath)
+{
+    std::unique_ptr<CONTRACT_STATE> state(new CONTRACT_STATE);
+    ContractSystem system = {};
+    uint32 chain = 0;
+    const auto start = std::chrono::steady_clock::now();
+    if (!checkpoint::restore(prefix, epoch, *state, &system, &chain)) {
+        fprintf(stderr, "checkpoints: cannot restore epoch %u from %s\n", epoch, prefix.c_str());
+        return 1;
+    }
+    const uint64 elapsed = microsecondsSince(start);
+
+    if (!snapshot::save(snapshotPath, *state, system)) {
+        fprintf(stderr, "checkpoints: cannot write %s\n", snapshotPath);
+        return 1;
+    }
+    printf("epoch %u (tick %u) restored from %u checkpoint(s) in %lluus: %u users, %u events, %u bets\n", system.epoch,
+        system.tick, chain, (unsigned long long)elapsed, state->userCount, state->eventCount, state->betCount);
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::string command = argc > 1 ? argv[1] : "";
+    if (argc == 3 && command == "list") {
+        return list(argv[2]);
+    }
+    if (argc == 3 && command == "verify") {
+        return verify(argv[2]);
+    }
+    if (argc == 5 && command == "restore" && strtoul(argv[3], nullptr, 10) <= 0xffff) {
+        return restore(argv[2], (uint16)strtoul(argv[3], nullptr, 10), argv[4]);
+    }
+    fprintf(stderr, "usage: %s list|verify PREFIX\n       %s restore PREFIX EPOCH SNAPSHOT\n", argv[0], argv[0]);
+    return 2;
+}
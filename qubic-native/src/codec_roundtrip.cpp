@@ -0,0 +1,146 @@
+// Decodes contract I/O records encoded by qubic-bridge/contract-codec.ts through
+// the C++ structs in HM25.h, then writes each record back with the field hash
+// computed from the struct members. qubic-bridge/codec-bench.ts drives this to
+// prove the bridge codec and the compiler agree on every layout.
+//
+// Usage: codec_roundtrip [--bench iterations] < fixture > echoed
+//
+// Input record:  uint16 structId, uint16 reserved, uint32 size, size bytes
+// Output record: uint16 structId, uint16 status,   uint32 hash, size bytes
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "contract_layout.h"
+
+namespace
+{
+
+enum RecordStatus : uint16
+{
+    RECORD_OK = 0,
+    RECORD_UNKNOWN_STRUCT = 1,
+    RECORD_SIZE_MISMATCH = 2,
+};
+
+struct RecordHeader
+{
+    uint16 structId;
+    uint16 status;
+    uint32 value;  // Size on input, field hash on output
+};
+
+// Copies the wire bytes into the contract struct, hashes it member by member
+// and copies the struct back out
+struct RoundTrip
+{
+    const uint8* input;
+    uint8* output;
+    uint32 hash;
+
+    template <typename T>
+    void visit()
+    {
+        T value;
+        memcpy(&value, input, sizeof(T));
+        hash = contract_abi::hashFields(value);
+        memcpy(output, &value, sizeof(T));
+    }
+};
+
+struct Record
+{
+    RecordHeader header;
+    std::vector<uint8> bytes;
+};
+
+bool readRecords(std::vector<Record>& records)
+{
+    RecordHeader header;
+    while (fread(&header, sizeof(header), 1, stdin) == 1) {
+        Record record;
+        record.header = header;
+        record.bytes.resize(header.value);
+        if (header.value && fread(record.bytes.data(), 1, header.value, stdin) != header.value) {
+            fprintf(stderr, "codec_roundtrip: truncated record for struct %u\n", header.structId);
+            return false;
+        }
+        records.push_back(std::move(record));
+    }
+    return true;
+}
+
+void benchmark(const std::vector<Record>& records, uint32 iterations)
+{
+    std::vector<uint8> scratch(4096);
+    for (const Record& record : records) {
+        if (record.header.structId >= contract_abi::STRUCT_COUNT) {
+            continue;
+        }
+
+        RoundTrip roundTrip = { record.bytes.data(), scratch.data(), 0 };
+        uint32 sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 i = 0; i < iterations; i++) {
+            contract_abi::visitStruct(record.header.structId, roundTrip);
+            sink += roundTrip.hash;
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const double nanoseconds = std::chrono::duration<double, std::nano>(elapsed).count();
+
+        fprintf(stderr, "%-24s %6u bytes %10.1f ns/roundtrip (sink %08x)\n",
+            contract_abi::STRUCTS[record.header.structId].name, (unsigned)record.bytes.size(),
+            nanoseconds / iterations, sink);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    uint32 benchIterations = 0;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--bench") && i + 1 < argc) {
+            benchIterations = (uint32)strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: %s [--bench iterations] < fixture > echoed\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::vector<Record> records;
+    if (!readRecords(records)) {
+        return 1;
+    }
+
+    std::vector<uint8> output;
+    for (const Record& record : records) {
+        RecordHeader header = { record.header.structId, RECORD_OK, 0 };
+        output.resize(record.bytes.size());
+
+        if (header.structId >= contract_abi::STRUCT_COUNT) {
+            header.status = RECORD_UNKNOWN_STRUCT;
+        } else if (contract_abi::STRUCTS[header.structId].size != record.bytes.size()) {
+            header.status = RECORD_SIZE_MISMATCH;
+        } else {
+            RoundTrip roundTrip = { record.bytes.data(), output.data(), 0 };
+            contract_abi::visitStruct(header.structId, roundTrip);
+            header.value = roundTrip.hash;
+        }
+
+        fwrite(&header, sizeof(header), 1, stdout);
+        if (header.status != RECORD_OK) {
+            // Echo the size back so the reader can stay in sync
+            output.assign(record.bytes.begin(), record.bytes.end());
+        }
+        fwrite(output.data(), 1, output.size(), stdout);
+    }
+
+    if (benchIterations) {
+        benchmark(records, benchIterations);
+    }
+
+    return 0;
+}
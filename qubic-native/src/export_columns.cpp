@@ -0,0 +1,333 @@
+// export_columns: writes the users, events and bets of a contract state as
+// a column_store.h file for analytics.
+//
+// The state comes from a state_snapshot.h file, or with --synthetic from a
+// contract driven through --days days of event creation and betting. After
+// writing, the file is mapped back and volume per category per day is run
+// over the columns and over the padded Bet structs; both must agree.
+//
+// Ticks count seconds in HM25.h (an event lasts 604800 ticks, 7 days), so
+// days are createdAt / --ticks-per-day.
+//
+// Usage: export_columns (--snapshot FILE | --synthetic) [--out FILE] [--days N] [--ticks-per-day N]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "column_query.h"
+#include "contract_host.h"
+#include "state_snapshot.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x636f6c756d6e73ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 2000;
+constexpr uint32 BENCH_BALANCE = 1000000;
+constexpr const char* CATEGORIES[] = { "Sports", "Crypto", "Technology", "Politics", "Entertainment", "Space", "Science", "Finance" };
+
+struct Options
+{
+    std::string snapshotPath;
+    bool synthetic = false;
+    std::string outPath = "predictor.columns";
+    uint32 days = 30;
+    uint32 ticksPerDay = 86400;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Fixed-size char fields are NUL padded but not always NUL terminated
+template <size_t N>
+std::string text(const char (&field)[N])
+{
+    return std::string(field, strnlen(field, N));
+}
+
+// Events and bets spread over `days` days, with day-to-day swings in how
+// busy each category is
+void buildSynthetic(ContractHost& host, const Options& options)
+{
+    CONTRACT_STATE& state = host.instance().state;
+    for (uint32 i = 1; i < BENCH_USERS; i++) {
+        RegisterUserInput input = {};
+        snprintf(input.username, sizeof(input.username), "user%u", i + 1);
+        RegisterUserOutput output;
+        host.call(0, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        state.users[i].balance = BENCH_BALANCE;
+    }
+
+    std::mt19937 rng(37);
+    const uint32 categoryCount = sizeof(CATEGORIES) / sizeof(CATEGORIES[0]);
+    const uint32 eventsPerDay = std::min(20u, (MAX_EVENTS - state.eventCount) / options.days);
+    const uint32 betsPerDay = (MAX_BETS - state.betCount) / options.days;
+    for (uint32 day = 0; day < options.days; day++) {
+        for (uint32 i = 0; i < eventsPerDay; i++) {
+            CreateEventInput input = {};
+            snprintf(input.title, sizeof(input.title), "Day %u market %u", day, i + 1);
+            snprintf(input.category, sizeof(input.category), "%s", CATEGORIES[rng() % categoryCount]);
+            input.endsAt = host.system().tick + 7 * options.ticksPerDay;
+            CreateEventOutput output;
+            host.call(1, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+
+        // Bets land on the newest events, spread over the day
+        for (uint32 i = 0; i < betsPerDay; i++) {
+            if (i % (betsPerDay / 100 + 1) == 0) {
+                for (uint32 step = 0; step < options.ticksPerDay / 100; step++) {
+                    host.advanceTick();
+                }
+            }
+            PlaceBetInput input = {};
+            input.userId = 1 + rng() % BENCH_USERS;
+            input.eventId = state.eventCount - rng() % std::min(state.eventCount, 3 * eventsPerDay);
+            input.prediction = (uint8)(rng() & 1);
+            input.amount = 1 + rng() % (day % 7 + 5);
+            PlaceBetOutput output;
+            host.call(2, OPERATOR_ID, &input, sizeof(input), &output);
+        }
+        while (host.system().tick < (day + 1) * options.ticksPerDay) {
+            host.advanceTick();
+        }
+    }
+}
+
+void exportState(const CONTRACT_STATE& state, columnar::ColumnWriter& writer)
+{
+    std::vector<uint32> u32;
+    std::vector<uint8> u8;
+    std::vector<std::string> strings;
+
+    const uint32 users = state.userCount;
+    auto userU32 = [&](const char* name, uint32 User::*field) {
+        u32.resize(users);
+        for (uint32 i = 0; i < users; i++) {
+            u32[i] = state.users[i].*field;
+        }
+        writer.addU32("users", name, u32);
+    };
+    userU32("id", &User::id);
+    userU32("balance", &User::balance);
+    userU32("totalBets", &User::totalBets);
+    userU32("totalWins", &User::totalWins);
+    u8.resize(users);
+    strings.resize(users);
+    for (uint32 i = 0; i < users; i++) {
+        u8[i] = state.users[i].isActive;
+        strings[i] = text(state.users[i].username);
+    }
+    writer.addU8("users", "isActive", u8);
+    writer.addDict("users", "username", strings);
+
+    const uint32 events = state.eventCount;
+    auto eventU32 = [&](const char* name, uint32 Event::*field) {
+        u32.resize(events);
+        for (uint32 i = 0; i < events; i++) {
+            u32[i] = state.events[i].*field;
+        }
+        writer.addU32("events", name, u32);
+    };
+    auto eventU8 = [&](const char* name, uint8 Event::*field) {
+        u8.resize(events);
+        for (uint32 i = 0; i < events; i++) {
+            u8[i] = state.events[i].*field;
+        }
+        writer.addU8("events", name, u8);
+    };
+    eventU32("id", &Event::id);
+    eventU32("createdAt", &Event::createdAt);
+    eventU32("endsAt", &Event::endsAt);
+    eventU32("totalBets", &Event::totalBets);
+    eventU32("yesBets", &Event::yesBets);
+    eventU32("noBets", &Event::noBets);
+    eventU8("isActive", &Event::isActive);
+    eventU8("isResolved", &Event::isResolved);
+    eventU8("correctAnswer", &Event::correctAnswer);
+    eventU8("outcomeCount", &Event::outcomeCount);
+    strings.resize(events);
+    for (uint32 i = 0; i < events; i++) {
+        strings[i] = text(state.events[i].category);
+    }
+    writer.addDict("events", "category", strings);
+    for (uint32 i = 0; i < events; i++) {
+        strings[i] = text(state.events[i].title);
+    }
+    writer.addDict("events", "title", strings);
+
+    const uint32 bets = state.betCount;
+    auto betU32 = [&](const char* name, uint32 Bet::*field) {
+        u32.resize(bets);
+        for (uint32 i = 0; i < bets; i++) {
+            u32[i] = state.bets[i].*field;
+        }
+        writer.addU32("bets", name, u32);
+    };
+    auto betU8 = [&](const char* name, uint8 Bet::*field) {
+        u8.resize(bets);
+        for (uint32 i = 0; i < bets; i++) {
+            u8[i] = state.bets[i].*field;
+        }
+        writer.addU8("bets", name, u8);
+    };
+    betU32("id", &Bet::id);
+    betU32("userId", &Bet::userId);
+    betU32("eventId", &Bet::eventId);
+    betU32("amount", &Bet::amount);
+    betU32("createdAt", &Bet::createdAt);
+    betU8("prediction", &Bet::prediction);
+    betU8("isWon", &Bet::isWon);
+    betU8("isProcessed", &Bet::isProcessed);
+}
+
+// The same aggregate read straight from the Bet and Event structs
+std::vector<columnar::VolumeRow> volumeFromStructs(const CONTRACT_STATE& state, uint32 ticksPerDay)
+{
+    std::vector<std::string> names;
+    std::vector<uint32> categoryOfEvent(state.eventCount);
+    for (uint32 i = 0; i < state.eventCount; i++) {
+        const std::string name = text(state.events[i].category);
+        categoryOfEvent[i] = (uint32)(std::find(names.begin(), names.end(), name) - names.begin());
+        if (categoryOfEvent[i] == names.size()) {
+            names.push_back(name);
+        }
+    }
+
+    uint32 lastDay = 0;
+    for (uint32 i = 0; i < state.betCount; i++) {
+        lastDay = std::max(lastDay, state.bets[i].createdAt / ticksPerDay);
+    }
+    std::vector<uint64> bets(names.size() * (lastDay + 1), 0);
+    std::vector<uint64> volume(names.size() * (lastDay + 1), 0);
+    for (uint32 i = 0; i < state.betCount; i++) {
+        const Bet& bet = state.bets[i];
+        const size_t cell = (size_t)categoryOfEvent[bet.eventId - 1] * (lastDay + 1) + bet.createdAt / ticksPerDay;
+        bets[cell]++;
+        volume[cell] += bet.amount;
+    }
+
+    std::vector<columnar::VolumeRow> rows;
+    for (uint32 category = 0; category < names.size(); category++) {
+        for (uint32 day = 0; day <= lastDay; day++) {
+            const size_t cell = (size_t)category * (lastDay + 1) + day;
+            if (bets[cell]) {
+                rows.push_back({ names[category], day, bets[cell], volume[cell] });
+            }
+        }
+    }
+    return rows;
+}
+
+bool sameRows(const std::vector<columnar::VolumeRow>& a, const std::vector<columnar::VolumeRow>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].category != b[i].category || a[i].day != b[i].day || a[i].bets != b[i].bets || a[i].volume != b[i].volume) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--synthetic") {
+            options.synthetic = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--snapshot") {
+            options.snapshotPath = value;
+        } else if (arg == "--out") {
+            options.outPath = value;
+        } else if (arg == "--days") {
+            options.days = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--ticks-per-day") {
+            options.ticksPerDay = (uint32)strtoul(value, nullptr, 10);
+        } else {
+            return false;
+        }
+    }
+    return options.synthetic != !options.snapshotPath.empty() && options.days && options.days <= 200
+        && options.ticksPerDay >= 100;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s (--snapshot FILE | --synthetic) [--out FILE] [--days N] [--ticks-per-day N]\n", argv[0]);
+        return 2;
+    }
+
+    ContractHost* host = new ContractHost(OPERATOR_ID);
+    CONTRACT_STATE& state = host->instance().state;
+    ContractSystem system = host->system();
+    if (options.synthetic) {
+        buildSynthetic(*host, options);
+        system = host->system();
+    } else if (!snapshot::load(options.snapshotPath.c_str(), state, &system)) {
+        fprintf(stderr, "export_columns: cannot load %s (missing, or from another build of HM25.h)\n",
+            options.snapshotPath.c_str());
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    columnar::ColumnWriter writer;
+    exportState(state, writer);
+    if (!writer.write(options.outPath.c_str(), system.tick, system.epoch)) {
+        fprintf(stderr, "export_columns: cannot write %s\n", options.outPath.c_str());
+        return 1;
+    }
+    const double exportMs = millisecondsSince(start);
+
+    columnar::ColumnFile file;
+    if (!file.open(options.outPath.c_str())) {
+        fprintf(stderr, "export_columns: cannot map %s back\n", options.outPath.c_str());
+        return 1;
+    }
+    printf("%u users, %u events, %u bets -> %s: %u columns, %.1f KiB (state %.1f KiB), %.1f ms\n", state.userCount,
+        state.eventCount, state.betCount, options.outPath.c_str(), file.header().columnCount,
+        file.header().fileSize / 1024.0, sizeof(CONTRACT_STATE) / 1024.0, exportMs);
+
+    // Volume per category per day both ways; best of a few runs each
+    std::vector<columnar::VolumeRow> fromColumns;
+    std::vector<columnar::VolumeRow> fromStructs;
+    double columnsMs = 1e30;
+    double structsMs = 1e30;
+    for (uint32 run = 0; run < 5; run++) {
+        columnar::ScanStats scan;
+        start = std::chrono::steady_clock::now();
+        columnar::volumeByCategoryDay(file, options.ticksPerDay, 0, UINT32_MAX / options.ticksPerDay, fromColumns, scan);
+        columnsMs = std::min(columnsMs, millisecondsSince(start));
+
+        start = std::chrono::steady_clock::now();
+        fromStructs = volumeFromStructs(state, options.ticksPerDay);
+        structsMs = std::min(structsMs, millisecondsSince(start));
+    }
+    const bool ok = sameRows(fromColumns, fromStructs);
+    printf("volume per category per day: %zu rows; columns %.3f ms, padded structs %.3f ms\n", fromColumns.size(),
+        columnsMs, structsMs);
+
+    delete host;
+    printf(ok ? "\nColumn and struct aggregates agree.\n" : "\nColumn and struct aggregates DIFFER.\n");
+    return ok ? 0 : 1;
+}
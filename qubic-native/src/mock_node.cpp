@@ -0,0 +1,648 @@
+// mock_node: local stand-in for a Qubic node hosting the PredictoR contract.
+//
+// Links qubic-contracts/HM25.h through contract_host.h and serves the
+// wire_protocol.h framing that qubic_clientd forwards, so the bridge, the
+// routes and the daemon can be load tested on one machine:
+//   - function calls run immediately against the current state,
+//   - transactions wait in a mempool and run in arrival order when the
+//     current tick ends; each gets its response at that point,
+//   - every --ticks-per-epoch ticks the contract's END_EPOCH and BEGIN_EPOCH
+//     run and the epoch advances.
+//
+// All transactions execute as the operator identity that ran Initialize, so
+// admin-only calls (CreateEvent, ResolveEvent) succeed.
+//
+// With --shards N the node hosts N contract instances at contract indices
+// 0..N-1, each configured with ConfigureShard(k, N), and runs every frame
+// against the instance its header names. Id translation between shards is
+// the client's job (shard_map.h, qubic-bridge/shard-map.ts).
+//
+// With --verify-settlement THREADS every ResolveEvent and ResolveEvents
+// transaction is rechecked by settlement_verifier.h against a copy of the
+// state taken just before it ran; mismatches are logged to stderr.
+//
+// With --snapshot FILE the state is written as a state_snapshot.h file
+// every --snapshot-every ticks (FILE.k for shard k), replaced by rename so
+// readers such as read_replica never see a partial file.
+//
+// With --checkpoints PREFIX the state is checkpointed by state_checkpoint.h
+// at start and whenever an epoch begins (PREFIX.<epoch>.ckpt, or
+// PREFIX.k.<epoch>.ckpt for shard k): a compressed delta against the
+// previous checkpoint, with a full base every --checkpoint-base-every
+// checkpoints. bin/checkpoints lists, verifies and restores them.
+//
+// Transactions are costed by tick_budget.h. With --tick-budget COST a tick
+// applies transactions per shard only while their estimated cost fits;
+// the rest are deferred to the next tick or, with --over-budget reject,
+// answered with STATUS_OVER_BUDGET. Each epoch line is followed by how close
+// the ticks came to the limit; --budget-log FILE writes one CSV row per tick
+// and shard.
+//
+// Usage: mock_node [--listen ENDPOINT] [--tick-ms N] [--ticks-per-epoch N] [--shards N]
+//                  [--verify-settlement THREADS] [--snapshot FILE [--snapshot-every N]]
+//                  [--checkpoints PREFIX [--checkpoint-base-every N]]
+//                  [--tick-budget COST [--over-budget defer|reject]] [--budget-log FILE] [--quiet]
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <sys/epoll.h>
+#include <unordered_map>
+#include <vector>
+
+#include "contract_host.h"
+#include "frame_io.h"
+#include "settlement_verifier.h"
+#include "state_checkpoint.h"
+#include "state_snapshot.h"
+#include "tick_budget.h"
+
+namespace
+{
+
+volatile sig_atomic_t stopRequested = 0;
+
+constexpr m256i OPERATOR_ID = { { 0x6f6d2d6e6f6465ULL, 0, 0, 0 } };
+
+uint64 nowMicroseconds()
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Options
+{
+    std::string listenEndpoint = "127.0.0.1:41841";
+    uint64 tickUs = 1000000;
+    uint32 ticksPerEpoch = 600;
+    uint32 shards = 1;
+    uint32 verifyThreads = 0;  // 0 = no settlement verification
+    std::string snapshotPath;
+    uint32 snapshotEvery = 1;
+    std::string checkpointPrefix;
+    uint32 checkpointBaseEvery = 8;
+    uint64 tickBudget = 0;  // Cost units per tick and shard, 0 = unlimited
+    OverBudgetPolicy overBudget = OVER_BUDGET_DEFER;
+    std::string budgetLogPath;
+    bool quiet = false;
+};
+
+struct PendingTransaction
+{
+    uint64 clientId;
+    wire::FrameHeader header;
+    std::vector<uint8> input;
+};
+
+// Reset at every epoch boundary
+struct EpochStats
+{
+    uint64 reads = 0;
+    uint64 transactions = 0;
+    uint64 applyTotalUs = 0;
+    uint64 applyMaxUs = 0;
+    size_t mempoolMax = 0;
+};
+
+class MockNode
+{
+public:
+    explicit MockNode(const Options& options)
+        : options(options)
+    {
+        for (uint32 shard = 0; shard < options.shards; shard++) {
+            hosts.emplace_back(new ContractHost(OPERATOR_ID));
+            if (options.shards > 1) {
+                ConfigureShardInput input = { shard, options.shards };
+                ConfigureShardOutput output;
+                hosts.back()->call(contract_abi::FUNCTION_CONFIGURE_SHARD, OPERATOR_ID, &input, sizeof(input), &output);
+            }
+        }
+        if (options.verifyThreads) {
+            verifier.reset(new SettlementVerifier(options.verifyThreads));
+            settlementBefore.reset(new CONTRACT_STATE);
+        }
+        for (uint32 shard = 0; !options.checkpointPrefix.empty() && shard < options.shards; shard++) {
+            checkpoints.emplace_back(new checkpoint::CheckpointWriter(
+                options.shards > 1 ? options.checkpointPrefix + "." + std::to_string(shard) : options.checkpointPrefix,
+                options.checkpointBaseEvery));
+        }
+        budgets.assign(options.shards, TickBudget(options.tickBudget));
+        budgetReports.resize(options.shards);
+        shardDeferring.resize(options.shards);
+    }
+
+    ~MockNode()
+    {
+        if (budgetLog) {
+            fclose(budgetLog);
+        }
+    }
+
+    bool start()
+    {
+        epollFd = epoll_create1(0);
+        listenFd = net::listenEndpoint(options.listenEndpoint);
+        if (epollFd < 0 || listenFd < 0) {
+            fprintf(stderr, "mock_node: cannot listen on %s\n", options.listenEndpoint.c_str());
+            return false;
+        }
+        if (!options.budgetLogPath.empty()) {
+            budgetLog = fopen(options.budgetLogPath.c_str(), "w");
+            if (!budgetLog) {
+                fprintf(stderr, "mock_node: cannot write %s\n", options.budgetLogPath.c_str());
+                return false;
+            }
+            fprintf(budgetLog, "tick,shard,spent,limit,admitted,deferred,rejected\n");
+        }
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+        writeCheckpoints();
+        nextTickUs = nowMicroseconds() + options.tickUs;
+        fprintf(stderr, "mock_node: listening on %s, tick %llu us, %u ticks per epoch, %u shard(s)\n",
+            options.listenEndpoint.c_str(), (unsigned long long)options.tickUs, options.ticksPerEpoch, options.shards);
+        return true;
+    }
+
+    void run()
+    {
+        epoll_event events[256];
+        while (!stopRequested) {
+            const uint64 now = nowMicroseconds();
+            const int timeoutMs = nextTickUs > now ? (int)((nextTickUs - now + 999) / 1000) : 0;
+            const int count = epoll_wait(epollFd, events, 256, timeoutMs);
+            for (int i = 0; i < count; i++) {
+                const int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (clientByFd.count(fd)) {
+                    handleClient(clientByFd[fd], events[i].events);
+                }
+            }
+
+            if (nowMicroseconds() >= nextTickUs) {
+                endTick();
+                nextTickUs += options.tickUs;
+            }
+            updateWriteInterest();
+        }
+
+        if (net::isUnixEndpoint(options.listenEndpoint)) {
+            unlink(options.listenEndpoint.c_str());
+        }
+    }
+
+private:
+    const Options options;
+    std::vector<std::unique_ptr<ContractHost>> hosts;  // Indexed by contractIndex
+    int epollFd = -1;
+    int listenFd = -1;
+
+    std::unordered_map<uint64, net::Connection> clients;
+    std::unordered_map<int, uint64> clientByFd;
+    uint64 nextClientId = 1;
+
+    std::vector<PendingTransaction> mempool;
+    std::vector<uint8> output;
+    uint64 nextTickUs = 0;
+    EpochStats stats;
+
+    std::vector<int> dirtyFds;
+
+    std::unique_ptr<SettlementVerifier> verifier;
+    std::unique_ptr<CONTRACT_STATE> settlementBefore;  // State before the resolution being verified
+
+    std::vector<std::unique_ptr<checkpoint::CheckpointWriter>> checkpoints;  // By shard, empty without --checkpoints
+
+    std::vector<TickBudget> budgets;             // By shard
+    std::vector<BudgetReport> budgetReports;     // By shard, reset every epoch
+    std::vector<uint8> shardDeferring;
+    FILE* budgetLog = nullptr;
+
+    void acceptClients()
+    {
+        for (;;) {
+            const int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            net::setNonBlocking(fd);
+            const uint64 id = nextClientId++;
+            clients[id].fd = fd;
+            clientByFd[fd] = id;
+
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+    }
+
+    void dropClient(uint64 clientId)
+    {
+        net::Connection& client = clients[clientId];
+        clientByFd.erase(client.fd);
+        client.reset();
+        clients.erase(clientId);
+    }
+
+    void handleClient(uint64 clientId, uint32 events)
+    {
+        net::Connection& client = clients[clientId];
+        if (events & EPOLLOUT) {
+            if (!client.flush()) {
+                dropClient(clientId);
+                return;
+            }
+        }
+        if (!(events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+            return;
+        }
+
+        const bool open = client.receive();
+        wire::FrameHeader header;
+        const uint8* payload;
+        bool malformed;
+        while (client.nextFrame(header, payload, malformed)) {
+            handleFrame(clientId, header, payload, header.size - (uint32)sizeof(header));
+        }
+
+        if (!open || malformed) {
+            dropClient(clientId);
+        }
+    }
+
+    void handleFrame(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        switch (header.type) {
+        case wire::FRAME_CALL_FUNCTION:
+            callFunction(clientId, header, payload, payloadSize);
+            break;
+        case wire::FRAME_SEND_TRANSACTION:
+            queueTransaction(clientId, header, payload, payloadSize);
+            break;
+        case wire::FRAME_TRANSACTION_BATCH: {
+            // Nested frames are answered individually by their own requestId
+            uint32 offset = 0;
+            wire::FrameHeader nested;
+            while (payloadSize - offset >= sizeof(nested)) {
+                memcpy(&nested, payload + offset, sizeof(nested));
+                if (nested.size < sizeof(nested) || nested.size > payloadSize - offset
+                    || nested.type != wire::FRAME_SEND_TRANSACTION) {
+                    respond(clientId, header, wire::STATUS_BAD_INPUT, nullptr, 0);
+                    break;
+                }
+                queueTransaction(clientId, nested, payload + offset + sizeof(nested), nested.size - (uint32)sizeof(nested));
+                offset += nested.size;
+            }
+            break;
+        }
+        case wire::FRAME_GET_TICK: {
+            // Shards advance together, so any instance has the node's tick
+            const wire::TickInfo tick = { hosts[0]->system().tick, hosts[0]->system().epoch, 0 };
+            respond(clientId, header, wire::STATUS_OK, &tick, sizeof(tick));
+            break;
+        }
+        default:
+            respond(clientId, header, wire::STATUS_BAD_INPUT, nullptr, 0);
+            break;
+        }
+    }
+
+    ContractHost* hostFor(const wire::FrameHeader& header)
+    {
+        return header.contractIndex < hosts.size() ? hosts[header.contractIndex].get() : nullptr;
+    }
+
+    void callFunction(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        ContractHost* host = hostFor(header);
+        const contract_abi::FunctionInfo* function = host ? host->function(header.inputType) : nullptr;
+        if (!function) {
+            respond(clientId, header, wire::STATUS_UNKNOWN_FUNCTION, nullptr, 0);
+            return;
+        }
+        if (payloadSize > function->inputSize) {
+            respond(clientId, header, wire::STATUS_BAD_INPUT, nullptr, 0);
+            return;
+        }
+
+        stats.reads++;
+        output.resize(function->outputSize);
+        host->call(header.inputType, OPERATOR_ID, payload, payloadSize, output.data());
+        respond(clientId, header, wire::STATUS_OK, output.data(), function->outputSize);
+    }
+
+    void queueTransaction(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        ContractHost* host = hostFor(header);
+        const contract_abi::FunctionInfo* function = host ? host->function(header.inputType) : nullptr;
+        if (!function) {
+            respond(clientId, header, wire::STATUS_UNKNOWN_FUNCTION, nullptr, 0);
+            return;
+        }
+        if (payloadSize < sizeof(wire::TransactionPrefix)
+            || payloadSize - sizeof(wire::TransactionPrefix) > function->inputSize) {
+            respond(clientId, header, wire::STATUS_BAD_INPUT, nullptr, 0);
+            return;
+        }
+
+        // The attached amount is accepted but not moved: HM25 keeps its own balances
+        PendingTransaction transaction;
+        transaction.clientId = clientId;
+        transaction.header = header;
+        transaction.input.assign(payload + sizeof(wire::TransactionPrefix), payload + payloadSize);
+        mempool.push_back(std::move(transaction));
+    }
+
+    // Applies the mempool in arrival order, then advances the tick and, on
+    // an epoch boundary, the epoch
+    void endTick()
+    {
+        const uint64 start = nowMicroseconds();
+        if (mempool.size() > stats.mempoolMax) {
+            stats.mempoolMax = mempool.size();
+        }
+
+        // With a tick budget, a transaction that does not fit is deferred
+        // together with every later one for its shard, keeping their order,
+        // or rejected on its own
+        std::fill(shardDeferring.begin(), shardDeferring.end(), 0);
+        std::vector<PendingTransaction> deferred;
+        uint64 applied = 0;
+        for (PendingTransaction& transaction : mempool) {
+            const uint16 shard = transaction.header.contractIndex;
+            ContractHost* host = hosts[shard].get();
+            TickBudget& budget = budgets[shard];
+            if (shardDeferring[shard] || !budget.admit(transaction.header.inputType)) {
+                if (options.overBudget == OVER_BUDGET_REJECT) {
+                    budget.reject();
+                    respond(transaction.clientId, transaction.header, wire::STATUS_OVER_BUDGET, nullptr, 0);
+                } else {
+                    shardDeferring[shard] = 1;
+                    budget.defer(1);
+                    deferred.push_back(std::move(transaction));
+                }
+                continue;
+            }
+
+            const contract_abi::FunctionInfo* function = host->function(transaction.header.inputType);
+            const bool settles = verifier && (transaction.header.inputType == contract_abi::FUNCTION_RESOLVE_EVENT
+                || transaction.header.inputType == contract_abi::FUNCTION_RESOLVE_EVENTS);
+            if (settles) {
+                *settlementBefore = host->instance().state;
+            }
+            output.resize(function->outputSize);
+            host->call(transaction.header.inputType, OPERATOR_ID, transaction.input.data(),
+                (uint32)transaction.input.size(), output.data());
+            budget.charge(host->instance().state, transaction.header.inputType);
+            applied++;
+            if (settles) {
+                verifySettlement(*host, transaction);
+            }
+            respond(transaction.clientId, transaction.header, wire::STATUS_OK, output.data(), function->outputSize);
+        }
+        stats.transactions += applied;
+        mempool.swap(deferred);
+
+        const uint64 elapsed = nowMicroseconds() - start;
+        stats.applyTotalUs += elapsed;
+        if (elapsed > stats.applyMaxUs) {
+            stats.applyMaxUs = elapsed;
+        }
+
+        for (uint32 shard = 0; shard < hosts.size(); shard++) {
+            const TickUsage usage = budgets[shard].endTick();
+            budgetReports[shard].add(usage, options.tickBudget);
+            if (budgetLog) {
+                fprintf(budgetLog, "%u,%u,%llu,%llu,%u,%u,%u\n", hosts[shard]->system().tick, shard,
+                    (unsigned long long)usage.spent, (unsigned long long)options.tickBudget, usage.admitted,
+                    usage.deferred, usage.rejected);
+            }
+        }
+        for (const std::unique_ptr<ContractHost>& host : hosts) {
+            host->advanceTick();
+        }
+        if (!options.snapshotPath.empty() && hosts[0]->system().tick % options.snapshotEvery == 0) {
+            writeSnapshots();
+        }
+        if (hosts[0]->system().tick % options.ticksPerEpoch == 0) {
+            if (!options.quiet) {
+                printEpoch();
+            }
+            for (const std::unique_ptr<ContractHost>& host : hosts) {
+                host->advanceEpoch();
+            }
+            writeCheckpoints();
+            stats = EpochStats();
+            std::fill(budgetReports.begin(), budgetReports.end(), BudgetReport());
+        }
+    }
+
+    void writeSnapshots()
+    {
+        for (uint32 shard = 0; shard < hosts.size(); shard++) {
+            const std::string path = hosts.size() > 1 ? options.snapshotPath + "." + std::to_string(shard) : options.snapshotPath;
+            const std::string temporary = path + ".tmp";
+            if (!snapshot::save(temporary.c_str(), hosts[shard]->instance().state, hosts[shard]->system())
+                || rename(temporary.c_str(), path.c_str()) != 0) {
+                fprintf(stderr, "mock_node: cannot write snapshot %s\n", path.c_str());
+            }
+        }
+    }
+
+    void writeCheckpoints()
+    {
+        for (uint32 shard = 0; shard < checkpoints.size(); shard++) {
+            checkpoint::CheckpointInfo info;
+            if (!checkpoints[shard]->write(hosts[shard]->instance().state, hosts[shard]->system(), &info)) {
+                fprintf(stderr, "mock_node: cannot write checkpoint of epoch %u, shard %u\n", hosts[shard]->system().epoch,
+                    shard);
+            } else if (!options.quiet) {
+                fprintf(stderr, "mock_node: checkpoint epoch %u shard %u: %s, %u units, %llu bytes (%.2f%% of state) in %lluus\n",
+                    info.epoch, shard, info.kind == checkpoint::CHECKPOINT_BASE ? "base" : "delta", info.changedUnits,
+                    (unsigned long long)info.fileBytes, 100.0 * info.fileBytes / sizeof(CONTRACT_STATE),
+                    (unsigned long long)info.micros);
+            }
+        }
+    }
+
+    // Rebuilds the resolution entries and reported results of the
+    // transaction just applied and rechecks them
+    void verifySettlement(ContractHost& host, const PendingTransaction& transaction)
+    {
+        std::vector<Resolution> resolutions;
+        std::vector<ResolutionResult> reported;
+        if (transaction.header.inputType == contract_abi::FUNCTION_RESOLVE_EVENT) {
+            ResolveEventInput input = {};
+            memcpy(&input, transaction.input.data(), std::min(transaction.input.size(), sizeof(input)));
+            const ResolveEventOutput* result = (const ResolveEventOutput*)output.data();
+            resolutions.push_back({ input.eventId, input.correctAnswer });
+            reported.push_back({ result->winnersCount, result->totalPayout, result->success });
+        } else {
+            ResolveEventsInput input = {};
+            memcpy(&input, transaction.input.data(), std::min(transaction.input.size(), sizeof(input)));
+            const ResolveEventsOutput* result = (const ResolveEventsOutput*)output.data();
+            for (uint32 i = 0; result->success && i < input.count; i++) {
+                resolutions.push_back({ input.eventIds[i], input.correctAnswers[i] });
+                reported.push_back({ result->winnersCount[i], result->totalPayout[i], result->resolved[i] });
+            }
+        }
+
+        const uint64 start = nowMicroseconds();
+        const SettlementReport report = verifier->verify(*settlementBefore, resolutions, reported, host.instance().state);
+        const uint64 elapsed = nowMicroseconds() - start;
+        if (!report.ok()) {
+            fprintf(stderr, "mock_node: settlement MISMATCH at tick %u on shard %u: %llu mismatches\n",
+                host.system().tick, transaction.header.contractIndex, (unsigned long long)report.mismatches);
+            for (const std::string& detail : report.details) {
+                fprintf(stderr, "mock_node:   %s\n", detail.c_str());
+            }
+        } else if (!options.quiet) {
+            fprintf(stderr, "mock_node: settlement verified at tick %u: %u events, %llu bets in %lluus\n",
+                host.system().tick, report.resolvedEvents, (unsigned long long)report.settledBets,
+                (unsigned long long)elapsed);
+        }
+    }
+
+    void respond(uint64 clientId, const wire::FrameHeader& request, uint16 status, const void* payload, uint32 payloadSize)
+    {
+        const auto client = clients.find(clientId);
+        if (client == clients.end()) {
+            return;
+        }
+
+        wire::FrameHeader response = request;
+        response.size = (uint32)sizeof(response) + payloadSize;
+        response.type = wire::FRAME_RESPONSE;
+        response.status = status;
+        client->second.queueFrame(response, payload, payloadSize);
+        dirtyFds.push_back(client->second.fd);
+    }
+
+    void updateWriteInterest()
+    {
+        for (int fd : dirtyFds) {
+            const auto client = clientByFd.find(fd);
+            if (client == clientByFd.end()) {
+                continue;
+            }
+
+            net::Connection& connection = clients[client->second];
+            connection.flush();
+            epoll_event event = {};
+            event.events = EPOLLIN | (connection.wantsWrite() ? (uint32)EPOLLOUT : 0u);
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+        dirtyFds.clear();
+    }
+
+    void printEpoch()
+    {
+        const uint32 ticks = options.ticksPerEpoch;
+        // Users are mirrored on every shard, so count them once
+        const uint32 users = hosts[0]->instance().state.userCount;
+        uint32 events = 0;
+        uint32 bets = 0;
+        for (const std::unique_ptr<ContractHost>& host : hosts) {
+            events += host->instance().state.eventCount;
+            bets += host->instance().state.betCount;
+        }
+        fprintf(stderr,
+            "mock_node: epoch %u done at tick %u: reads=%llu transactions=%llu "
+            "avgApply=%.1fus maxApply=%lluus maxMempool=%zu users=%u events=%u bets=%u\n",
+            hosts[0]->system().epoch, hosts[0]->system().tick,
+            (unsigned long long)stats.reads, (unsigned long long)stats.transactions,
+            (double)stats.applyTotalUs / ticks, (unsigned long long)stats.applyMaxUs, stats.mempoolMax,
+            users, events, bets);
+        for (uint32 shard = 0; shard < hosts.size(); shard++) {
+            fprintf(stderr, hosts.size() > 1 ? "mock_node:   shard %u " : "mock_node:   ", shard);
+            budgetReports[shard].print(stderr, options.tickBudget);
+            fprintf(stderr, "\n");
+        }
+    }
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--quiet") {
+            options.quiet = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--listen") {
+            options.listenEndpoint = value;
+        } else if (arg == "--tick-ms") {
+            options.tickUs = strtoull(value, nullptr, 10) * 1000;
+        } else if (arg == "--ticks-per-epoch") {
+            options.ticksPerEpoch = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--shards") {
+            options.shards = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--verify-settlement") {
+            options.verifyThreads = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--snapshot") {
+            options.snapshotPath = value;
+        } else if (arg == "--snapshot-every") {
+            options.snapshotEvery = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--checkpoints") {
+            options.checkpointPrefix = value;
+        } else if (arg == "--checkpoint-base-every") {
+            options.checkpointBaseEvery = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--tick-budget") {
+            options.tickBudget = strtoull(value, nullptr, 10);
+        } else if (arg == "--over-budget" && (!strcmp(value, "defer") || !strcmp(value, "reject"))) {
+            options.overBudget = strcmp(value, "defer") ? OVER_BUDGET_REJECT : OVER_BUDGET_DEFER;
+        } else if (arg == "--budget-log") {
+            options.budgetLogPath = value;
+        } else {
+            return false;
+        }
+    }
+    return options.tickUs && options.ticksPerEpoch && options.shards && options.shards <= MAX_SHARDS
+        && options.snapshotEvery && options.checkpointBaseEvery;
+}
+
+void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [--listen ENDPOINT] [--tick-ms N] [--ticks-per-epoch N] [--shards N]\n"
+            "       [--verify-settlement THREADS] [--snapshot FILE [--snapshot-every N]]\n"
+            "       [--checkpoints PREFIX [--checkpoint-base-every N]]\n"
+            "       [--tick-budget COST [--over-budget defer|reject]] [--budget-log FILE] [--quiet]\n", argv[0]);
+        return 2;
+    }
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    signal(SIGPIPE, SIG_IGN);
+
+    MockNode node(options);
+    if (!node.start()) {
+        return 1;
+    }
+    node.run();
+    return 0;
+}
@@ -0,0 +1,596 @@
+// qubic_clientd: long-lived client between the Node bridge and the node side.
+//
+// The bridge used to spawn qubic-cli for every read and transaction. This
+// daemon keeps node connections open instead and, on a local socket speaking
+// wire_protocol.h:
+//   - pipelines requests over the open connections (many in flight at once),
+//   - coalesces identical concurrent reads into one upstream request,
+//   - batches outgoing transactions into FRAME_TRANSACTION_BATCH frames.
+//
+// Reads are spread round-robin over the connections. Transactions all go
+// over one connection, the first connected one, and move on only when it
+// drops, so the node applies them in the order the daemon received them;
+// spread over connections, a later batch could overtake an earlier one.
+//
+// Upstreams speak wire_protocol.h, which is mock_node's framing (and
+// read_replica's for reads). A real Qubic node speaks its own peer protocol
+// and is not supported as an upstream; against one, use qubic-cli.
+//
+// Usage: qubic_clientd --listen PATH --node ENDPOINT [--node ENDPOINT ...]
+//                      [--connections N] [--batch-max N] [--batch-delay-us N]
+//                      [--stats-interval SECONDS]
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <sys/epoll.h>
+#include <unordered_map>
+#include <vector>
+
+#include "frame_io.h"
+
+namespace
+{
+
+volatile sig_atomic_t stopRequested = 0;
+
+uint64 nowMicroseconds()
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Options
+{
+    std::string listenEndpoint = "/tmp/qubic-clientd.sock";
+    std::vector<std::string> nodeEndpoints;
+    uint32 connectionsPerNode = 2;
+    uint32 batchMax = 64;
+    uint64 batchDelayUs = 500;
+    uint64 statsIntervalUs = 0;
+};
+
+struct Waiter
+{
+    uint64 clientId;
+    uint32 clientRequestId;
+    uint64 receivedAtUs;
+};
+
+struct PendingRequest
+{
+    std::string coalesceKey;  // Empty for transactions
+    size_t upstream;
+    std::vector<Waiter> waiters;
+};
+
+struct Upstream
+{
+    std::string endpoint;
+    net::Connection connection;
+    uint64 reconnectAtUs = 0;
+};
+
+struct Stats
+{
+    uint64 reads = 0;
+    uint64 coalescedReads = 0;
+    uint64 transactions = 0;
+    uint64 batches = 0;
+    uint64 responses = 0;
+    uint64 unavailable = 0;
+    uint64 latencyTotalUs = 0;
+    uint64 latencyMaxUs = 0;
+};
+
+class ClientDaemon
+{
+public:
+    explicit ClientDaemon(const Options& options)
+        : options(options)
+    {
+    }
+
+    bool start()
+    {
+        epollFd = epoll_create1(0);
+        listenFd = net::listenEndpoint(options.listenEndpoint);
+        if (epollFd < 0 || listenFd < 0) {
+            fprintf(stderr, "qubic_clientd: cannot listen on %s\n", options.listenEndpoint.c_str());
+            return false;
+        }
+        watch(listenFd, EPOLLIN);
+
+        for (const std::string& endpoint : options.nodeEndpoints) {
+            for (uint32 i = 0; i < options.connectionsPerNode; i++) {
+                Upstream upstream;
+                upstream.endpoint = endpoint;
+                upstreams.push_back(std::move(upstream));
+            }
+        }
+        for (size_t i = 0; i < upstreams.size(); i++) {
+            connectUpstream(i);
+        }
+
+        nextStatsUs = nowMicroseconds() + options.statsIntervalUs;
+        fprintf(stderr, "qubic_clientd: listening on %s, %zu upstream connections\n",
+            options.listenEndpoint.c_str(), upstreams.size());
+        return true;
+    }
+
+    void run()
+    {
+        epoll_event events[256];
+        while (!stopRequested) {
+            const int count = epoll_wait(epollFd, events, 256, pollTimeoutMs());
+            for (int i = 0; i < count; i++) {
+                const int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (upstreamByFd.count(fd)) {
+                    handleUpstream(upstreamByFd[fd], events[i].events);
+                } else if (clientByFd.count(fd)) {
+                    handleClient(clientByFd[fd], events[i].events);
+                }
+            }
+
+            const uint64 now = nowMicroseconds();
+            if (batchCount && now >= batchDeadlineUs) {
+                flushBatch();
+            }
+            for (size_t i = 0; i < upstreams.size(); i++) {
+                if (upstreams[i].connection.fd < 0 && now >= upstreams[i].reconnectAtUs) {
+                    connectUpstream(i);
+                }
+            }
+            if (options.statsIntervalUs && now >= nextStatsUs) {
+                printStats();
+                nextStatsUs = now + options.statsIntervalUs;
+            }
+            updateWriteInterest();
+        }
+
+        if (net::isUnixEndpoint(options.listenEndpoint)) {
+            unlink(options.listenEndpoint.c_str());
+        }
+    }
+
+private:
+    const Options options;
+    int epollFd = -1;
+    int listenFd = -1;
+
+    std::vector<Upstream> upstreams;
+    std::unordered_map<int, size_t> upstreamByFd;
+    size_t nextUpstream = 0;
+    size_t writeUpstream = 0;  // Carries every transaction batch while connected
+
+    std::unordered_map<uint64, net::Connection> clients;
+    std::unordered_map<int, uint64> clientByFd;
+    uint64 nextClientId = 1;
+
+    std::unordered_map<uint32, PendingRequest> pending;
+    std::unordered_map<std::string, uint32> inFlightReads;
+    uint32 nextRequestId = 1;
+
+    std::vector<uint8> batch;
+    std::vector<uint32> batchRequestIds;
+    uint32 batchCount = 0;
+    uint64 batchDeadlineUs = 0;
+
+    std::vector<int> dirtyFds;
+    uint64 nextStatsUs = 0;
+    Stats stats;
+
+    void watch(int fd, uint32 events)
+    {
+        epoll_event event = {};
+        event.events = events;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    }
+
+    int pollTimeoutMs() const
+    {
+        uint64 timeoutUs = 100000;
+        const uint64 now = nowMicroseconds();
+        if (batchCount) {
+            timeoutUs = batchDeadlineUs > now ? batchDeadlineUs - now : 0;
+        }
+        return (int)((timeoutUs + 999) / 1000);
+    }
+
+    void connectUpstream(size_t index)
+    {
+        Upstream& upstream = upstreams[index];
+        upstream.connection.reset();
+        upstream.connection.fd = net::connectEndpoint(upstream.endpoint);
+        if (upstream.connection.fd < 0) {
+            upstream.reconnectAtUs = nowMicroseconds() + 1000000;
+            return;
+        }
+        upstreamByFd[upstream.connection.fd] = index;
+        watch(upstream.connection.fd, EPOLLIN);
+    }
+
+    // Round-robin over connected upstreams; false when none is connected
+    bool pickUpstream(size_t& index)
+    {
+        for (size_t attempt = 0; attempt < upstreams.size(); attempt++) {
+            const size_t candidate = nextUpstream++ % upstreams.size();
+            if (upstreams[candidate].connection.fd >= 0) {
+                index = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // The connection transactions go over: writeUpstream while it is
+    // connected, else the next connected one, which takes its place
+    bool pickWriteUpstream(size_t& index)
+    {
+        for (size_t attempt = 0; attempt < upstreams.size(); attempt++) {
+            const size_t candidate = (writeUpstream + attempt) % upstreams.size();
+            if (upstreams[candidate].connection.fd >= 0) {
+                writeUpstream = candidate;
+                index = candidate;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void dropUpstream(size_t index)
+    {
+        Upstream& upstream = upstreams[index];
+        upstreamByFd.erase(upstream.connection.fd);
+        upstream.connection.reset();
+        upstream.reconnectAtUs = nowMicroseconds() + 1000000;
+
+        // Everything still waiting on this connection fails
+        for (auto it = pending.begin(); it != pending.end();) {
+            if (it->second.upstream == index) {
+                failWaiters(it->second, wire::STATUS_UNAVAILABLE);
+                if (!it->second.coalesceKey.empty()) {
+                    inFlightReads.erase(it->second.coalesceKey);
+                }
+                it = pending.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void acceptClients()
+    {
+        for (;;) {
+            const int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            net::setNonBlocking(fd);
+            const uint64 id = nextClientId++;
+            clients[id].fd = fd;
+            clientByFd[fd] = id;
+            watch(fd, EPOLLIN);
+        }
+    }
+
+    void dropClient(uint64 clientId)
+    {
+        net::Connection& client = clients[clientId];
+        clientByFd.erase(client.fd);
+        client.reset();
+        clients.erase(clientId);
+    }
+
+    void handleClient(uint64 clientId, uint32 events)
+    {
+        net::Connection& client = clients[clientId];
+        if (events & EPOLLOUT) {
+            if (!client.flush()) {
+                dropClient(clientId);
+                return;
+            }
+        }
+        if (!(events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+            return;
+        }
+
+        const bool open = client.receive();
+        wire::FrameHeader header;
+        const uint8* payload;
+        bool malformed;
+        while (client.nextFrame(header, payload, malformed)) {
+            const uint32 payloadSize = header.size - (uint32)sizeof(header);
+            switch (header.type) {
+            case wire::FRAME_CALL_FUNCTION:
+            case wire::FRAME_GET_TICK:
+                forwardRead(clientId, header, payload, payloadSize);
+                break;
+            case wire::FRAME_SEND_TRANSACTION:
+                queueTransaction(clientId, header, payload, payloadSize);
+                break;
+            default:
+                respondStatus(clientId, header.requestId, wire::STATUS_BAD_INPUT);
+                break;
+            }
+        }
+
+        if (!open || malformed) {
+            dropClient(clientId);
+        }
+    }
+
+    void forwardRead(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        stats.reads++;
+        const Waiter waiter = { clientId, header.requestId, nowMicroseconds() };
+
+        std::string key((const char*)&header.type, sizeof(header.type));
+        key.append((const char*)&header.inputType, sizeof(header.inputType));
+        key.append((const char*)&header.contractIndex, sizeof(header.contractIndex));
+        key.append((const char*)payload, payloadSize);
+
+        const auto inFlight = inFlightReads.find(key);
+        if (inFlight != inFlightReads.end()) {
+            // Same read already on the wire: share its response
+            stats.coalescedReads++;
+            pending[inFlight->second].waiters.push_back(waiter);
+            return;
+        }
+
+        size_t upstream;
+        if (!pickUpstream(upstream)) {
+            stats.unavailable++;
+            respondStatus(clientId, header.requestId, wire::STATUS_UNAVAILABLE);
+            return;
+        }
+
+        const uint32 requestId = nextRequestId++;
+        PendingRequest& request = pending[requestId];
+        request.coalesceKey = key;
+        request.upstream = upstream;
+        request.waiters.push_back(waiter);
+        inFlightReads[key] = requestId;
+
+        wire::FrameHeader forwarded = header;
+        forwarded.requestId = requestId;
+        upstreams[upstream].connection.queueFrame(forwarded, payload, payloadSize);
+        dirtyFds.push_back(upstreams[upstream].connection.fd);
+    }
+
+    void queueTransaction(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        stats.transactions++;
+        const uint32 requestId = nextRequestId++;
+        pending[requestId].waiters.push_back({ clientId, header.requestId, nowMicroseconds() });
+
+        wire::FrameHeader forwarded = header;
+        forwarded.requestId = requestId;
+        const uint8* headerBytes = (const uint8*)&forwarded;
+        batch.insert(batch.end(), headerBytes, headerBytes + sizeof(forwarded));
+        batch.insert(batch.end(), payload, payload + payloadSize);
+        batchRequestIds.push_back(requestId);
+
+        if (batchCount++ == 0) {
+            batchDeadlineUs = nowMicroseconds() + options.batchDelayUs;
+        }
+        if (batchCount >= options.batchMax) {
+            flushBatch();
+        }
+    }
+
+    void flushBatch()
+    {
+        size_t upstream;
+        if (!pickWriteUpstream(upstream)) {
+            stats.unavailable += batchCount;
+            for (uint32 requestId : batchRequestIds) {
+                failWaiters(pending[requestId], wire::STATUS_UNAVAILABLE);
+                pending.erase(requestId);
+            }
+        } else {
+            stats.batches++;
+            for (uint32 requestId : batchRequestIds) {
+                pending[requestId].upstream = upstream;
+            }
+
+            wire::FrameHeader header = {};
+            header.size = (uint32)(sizeof(header) + batch.size());
+            header.type = wire::FRAME_TRANSACTION_BATCH;
+            header.requestId = nextRequestId++;
+            upstreams[upstream].connection.queueFrame(header, batch.data(), (uint32)batch.size());
+            dirtyFds.push_back(upstreams[upstream].connection.fd);
+        }
+
+        batch.clear();
+        batchRequestIds.clear();
+        batchCount = 0;
+    }
+
+    void handleUpstream(size_t index, uint32 events)
+    {
+        net::Connection& connection = upstreams[index].connection;
+        if (events & EPOLLOUT) {
+            if (!connection.flush()) {
+                dropUpstream(index);
+                return;
+            }
+        }
+        if (!(events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+            return;
+        }
+
+        const bool open = connection.receive();
+        wire::FrameHeader header;
+        const uint8* payload;
+        bool malformed;
+        while (connection.nextFrame(header, payload, malformed)) {
+            if (header.type == wire::FRAME_RESPONSE) {
+                deliver(header, payload, header.size - (uint32)sizeof(header));
+            }
+        }
+
+        if (!open || malformed) {
+            fprintf(stderr, "qubic_clientd: lost connection to %s\n", upstreams[index].endpoint.c_str());
+            dropUpstream(index);
+        }
+    }
+
+    void deliver(const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        const auto it = pending.find(header.requestId);
+        if (it == pending.end()) {
+            return;
+        }
+
+        const uint64 now = nowMicroseconds();
+        for (const Waiter& waiter : it->second.waiters) {
+            const auto client = clients.find(waiter.clientId);
+            if (client == clients.end()) {
+                continue;
+            }
+
+            wire::FrameHeader response = header;
+            response.requestId = waiter.clientRequestId;
+            client->second.queueFrame(response, payload, payloadSize);
+            dirtyFds.push_back(client->second.fd);
+
+            const uint64 latency = now - waiter.receivedAtUs;
+            stats.responses++;
+            stats.latencyTotalUs += latency;
+            if (latency > stats.latencyMaxUs) {
+                stats.latencyMaxUs = latency;
+            }
+        }
+
+        if (!it->second.coalesceKey.empty()) {
+            inFlightReads.erase(it->second.coalesceKey);
+        }
+        pending.erase(it);
+    }
+
+    void respondStatus(uint64 clientId, uint32 requestId, uint16 status)
+    {
+        const auto client = clients.find(clientId);
+        if (client == clients.end()) {
+            return;
+        }
+
+        wire::FrameHeader response = {};
+        response.size = sizeof(response);
+        response.type = wire::FRAME_RESPONSE;
+        response.requestId = requestId;
+        response.status = status;
+        client->second.queueFrame(response, nullptr, 0);
+        dirtyFds.push_back(client->second.fd);
+    }
+
+    void failWaiters(const PendingRequest& request, uint16 status)
+    {
+        for (const Waiter& waiter : request.waiters) {
+            respondStatus(waiter.clientId, waiter.clientRequestId, status);
+        }
+    }
+
+    // Try to write everything queued this iteration; poll for EPOLLOUT only
+    // on sockets that could not take it all
+    void updateWriteInterest()
+    {
+        for (int fd : dirtyFds) {
+            net::Connection* connection = nullptr;
+            const auto client = clientByFd.find(fd);
+            if (client != clientByFd.end()) {
+                connection = &clients[client->second];
+            } else {
+                const auto upstream = upstreamByFd.find(fd);
+                if (upstream != upstreamByFd.end()) {
+                    connection = &upstreams[upstream->second].connection;
+                }
+            }
+            if (!connection || connection->fd < 0) {
+                continue;
+            }
+
+            connection->flush();
+            epoll_event event = {};
+            event.events = EPOLLIN | (connection->wantsWrite() ? (uint32)EPOLLOUT : 0u);
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+        dirtyFds.clear();
+    }
+
+    void printStats()
+    {
+        fprintf(stderr,
+            "qubic_clientd: reads=%llu coalesced=%llu tx=%llu batches=%llu responses=%llu "
+            "unavailable=%llu avgLatency=%.1fus maxLatency=%lluus inFlight=%zu\n",
+            (unsigned long long)stats.reads, (unsigned long long)stats.coalescedReads,
+            (unsigned long long)stats.transactions, (unsigned long long)stats.batches,
+            (unsigned long long)stats.responses, (unsigned long long)stats.unavailable,
+            stats.responses ? (double)stats.latencyTotalUs / stats.responses : 0.0,
+            (unsigned long long)stats.latencyMaxUs, pending.size());
+    }
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--listen") {
+            options.listenEndpoint = value;
+        } else if (arg == "--node") {
+            options.nodeEndpoints.push_back(value);
+        } else if (arg == "--connections") {
+            options.connectionsPerNode = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--batch-max") {
+            options.batchMax = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--batch-delay-us") {
+            options.batchDelayUs = strtoull(value, nullptr, 10);
+        } else if (arg == "--stats-interval") {
+            options.statsIntervalUs = strtoull(value, nullptr, 10) * 1000000;
+        } else {
+            return false;
+        }
+    }
+    return !options.nodeEndpoints.empty() && options.connectionsPerNode && options.batchMax;
+}
+
+void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr,
+            "usage: %s --listen PATH --node ENDPOINT [--node ENDPOINT ...]\n"
+            "          [--connections N] [--batch-max N] [--batch-delay-us N] [--stats-interval SECONDS]\n",
+            argv[0]);
+        return 2;
+    }
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    signal(SIGPIPE, SIG_IGN);
+
+    ClientDaemon daemon(options);
+    if (!daemon.start()) {
+        return 1;
+    }
+    daemon.run();
+    return 0;
+}
@@ -0,0 +1,356 @@
+// read_replica: off-chain read replica of the PredictoR contract state.
+//
+// Mirrors the state_snapshot.h file a node keeps current (mock_node
+// --snapshot), reloading it whenever it changes, and holds the bet table in
+// columns (bet_scan.h). Serves wire_protocol.h frames on a local socket:
+//   - FRAME_QUERY_BETS: bets by user, by event, unsettled and stake range,
+//     any combination, paged; answered by the scalar or AVX2 scan kernel,
+//     chosen by --kernel or per query,
+//   - FRAME_GET_TICK: the tick of the mirrored snapshot.
+// Queries before the first snapshot loads get STATUS_UNAVAILABLE.
+//
+// Usage: read_replica --snapshot FILE [--listen ENDPOINT] [--poll-ms N] [--kernel scalar|avx2] [--quiet]
+
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/stat.h>
+#include <unordered_map>
+#include <vector>
+
+#include "bet_scan.h"
+#include "frame_io.h"
+#include "state_snapshot.h"
+
+namespace
+{
+
+volatile sig_atomic_t stopRequested = 0;
+
+uint64 nowMicroseconds()
+{
+    return (uint64)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct Options
+{
+    std::string snapshotPath;
+    std::string listenEndpoint = "/tmp/predictor-replica.sock";
+    uint32 pollMs = 200;
+    ScanKernel kernel = SCAN_AVX2;
+    bool quiet = false;
+};
+
+class ReadReplica
+{
+public:
+    explicit ReadReplica(const Options& options)
+        : options(options), state(new CONTRACT_STATE)
+    {
+    }
+
+    bool start()
+    {
+        epollFd = epoll_create1(0);
+        listenFd = net::listenEndpoint(options.listenEndpoint);
+        if (epollFd < 0 || listenFd < 0) {
+            fprintf(stderr, "read_replica: cannot listen on %s\n", options.listenEndpoint.c_str());
+            return false;
+        }
+
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = listenFd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, listenFd, &event);
+
+        fprintf(stderr, "read_replica: listening on %s, mirroring %s, %s kernel\n", options.listenEndpoint.c_str(),
+            options.snapshotPath.c_str(), options.kernel == SCAN_AVX2 ? "avx2" : "scalar");
+        refresh();
+        return true;
+    }
+
+    void run()
+    {
+        epoll_event events[256];
+        uint64 nextPollUs = nowMicroseconds() + options.pollMs * 1000ULL;
+        while (!stopRequested) {
+            const uint64 now = nowMicroseconds();
+            const int timeoutMs = nextPollUs > now ? (int)((nextPollUs - now + 999) / 1000) : 0;
+            const int count = epoll_wait(epollFd, events, 256, timeoutMs);
+            for (int i = 0; i < count; i++) {
+                const int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (clientByFd.count(fd)) {
+                    handleClient(clientByFd[fd], events[i].events);
+                }
+            }
+
+            if (nowMicroseconds() >= nextPollUs) {
+                refresh();
+                nextPollUs = nowMicroseconds() + options.pollMs * 1000ULL;
+            }
+            updateWriteInterest();
+        }
+    }
+
+private:
+    const Options options;
+    std::unique_ptr<CONTRACT_STATE> state;
+    ContractSystem system = {};
+    BetColumns bets;
+    bool loaded = false;
+    timespec snapshotTime = {};
+    off_t snapshotSize = 0;
+
+    int epollFd = -1;
+    int listenFd = -1;
+    std::unordered_map<uint64, net::Connection> clients;
+    std::unordered_map<int, uint64> clientByFd;
+    uint64 nextClientId = 1;
+    std::vector<int> dirtyFds;
+
+    std::vector<uint32> slots;
+    std::vector<uint8> response;
+
+    // Reloads the snapshot when its file changed. The node replaces it by
+    // rename, so a load never sees a half-written file; a failed load keeps
+    // the previous state.
+    void refresh()
+    {
+        struct stat info;
+        if (stat(options.snapshotPath.c_str(), &info) != 0) {
+            return;
+        }
+        if (loaded && info.st_mtim.tv_sec == snapshotTime.tv_sec && info.st_mtim.tv_nsec == snapshotTime.tv_nsec
+            && info.st_size == snapshotSize) {
+            return;
+        }
+
+        const uint64 start = nowMicroseconds();
+        if (!snapshot::load(options.snapshotPath.c_str(), *state, &system)) {
+            fprintf(stderr, "read_replica: cannot load %s (partial, or from another build of HM25.h)\n",
+                options.snapshotPath.c_str());
+            return;
+        }
+        bets.load(*state);
+        loaded = true;
+        snapshotTime = info.st_mtim;
+        snapshotSize = info.st_size;
+        if (!options.quiet) {
+            fprintf(stderr, "read_replica: tick %u loaded: %u users, %u events, %u bets in %lluus\n", system.tick,
+                state->userCount, state->eventCount, bets.count, (unsigned long long)(nowMicroseconds() - start));
+        }
+    }
+
+    void acceptClients()
+    {
+        for (;;) {
+            const int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            net::setNonBlocking(fd);
+            const uint64 id = nextClientId++;
+            clients[id].fd = fd;
+            clientByFd[fd] = id;
+
+            epoll_event event = {};
+            event.events = EPOLLIN;
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+        }
+    }
+
+    void dropClient(uint64 clientId)
+    {
+        net::Connection& client = clients[clientId];
+        clientByFd.erase(client.fd);
+        client.reset();
+        clients.erase(clientId);
+    }
+
+    void handleClient(uint64 clientId, uint32 events)
+    {
+        net::Connection& client = clients[clientId];
+        if (events & EPOLLOUT) {
+            if (!client.flush()) {
+                dropClient(clientId);
+                return;
+            }
+        }
+        if (!(events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+            return;
+        }
+
+        const bool open = client.receive();
+        wire::FrameHeader header;
+        const uint8* payload;
+        bool malformed;
+        while (client.nextFrame(header, payload, malformed)) {
+            handleFrame(clientId, header, payload, header.size - (uint32)sizeof(header));
+        }
+
+        if (!open || malformed) {
+            dropClient(clientId);
+        }
+    }
+
+    void handleFrame(uint64 clientId, const wire::FrameHeader& header, const uint8* payload, uint32 payloadSize)
+    {
+        if (header.type != wire::FRAME_QUERY_BETS && header.type != wire::FRAME_GET_TICK) {
+            respond(clientId, header, wire::STATUS_UNKNOWN_FUNCTION, nullptr, 0);
+            return;
+        }
+        if (!loaded) {
+            respond(clientId, header, wire::STATUS_UNAVAILABLE, nullptr, 0);
+            return;
+        }
+        if (header.type == wire::FRAME_GET_TICK) {
+            const wire::TickInfo info = { system.tick, system.epoch, 0 };
+            respond(clientId, header, wire::STATUS_OK, &info, sizeof(info));
+            return;
+        }
+
+        // Short input is zero-padded, as for contract calls
+        wire::BetQuery query = {};
+        if (payloadSize <= sizeof(query)) {
+            memcpy(&query, payload, payloadSize);
+        }
+        if (payloadSize > sizeof(query) || query.kernel > SCAN_AVX2) {
+            respond(clientId, header, wire::STATUS_BAD_INPUT, nullptr, 0);
+            return;
+        }
+        queryBets(clientId, header, query);
+    }
+
+    void queryBets(uint64 clientId, const wire::FrameHeader& header, const wire::BetQuery& query)
+    {
+        BetFilter filter;
+        filter.userId = query.userId;
+        filter.eventId = query.eventId;
+        filter.minAmount = query.minAmount;
+        filter.maxAmount = query.maxAmount;
+        filter.unsettledOnly = query.unsettledOnly != 0;
+        const uint32 limit = std::min<uint32>(query.limit, wire::MAX_QUERY_BETS);
+        const ScanKernel kernel = query.kernel ? (ScanKernel)query.kernel : options.kernel;
+
+        const uint64 start = nowMicroseconds();
+        slots.clear();
+        wire::BetQueryResult result = {};
+        result.total = scanBets(bets, filter, kernel, query.offset, limit, slots);
+        result.count = (uint32)slots.size();
+        result.tick = system.tick;
+        result.scanMicros = (uint32)(nowMicroseconds() - start);
+
+        response.resize(sizeof(result) + slots.size() * sizeof(wire::BetRecord));
+        memcpy(response.data(), &result, sizeof(result));
+        wire::BetRecord* records = (wire::BetRecord*)(response.data() + sizeof(result));
+        for (size_t i = 0; i < slots.size(); i++) {
+            const uint32 slot = slots[i];
+            const uint8 flags = bets.flags[slot];
+            records[i] = { bets.id[slot], bets.userId[slot], bets.eventId[slot], bets.amount[slot], bets.createdAt[slot],
+                bets.prediction[slot], (uint8)((flags & BET_WON) != 0),
+                (uint8)((flags & BET_PROCESSED) != 0), 0 };
+        }
+        respond(clientId, header, wire::STATUS_OK, response.data(), (uint32)response.size());
+    }
+
+    void respond(uint64 clientId, const wire::FrameHeader& request, uint16 status, const void* payload, uint32 payloadSize)
+    {
+        const auto client = clients.find(clientId);
+        if (client == clients.end()) {
+            return;
+        }
+
+        wire::FrameHeader response = request;
+        response.size = (uint32)sizeof(response) + payloadSize;
+        response.type = wire::FRAME_RESPONSE;
+        response.status = status;
+        client->second.queueFrame(response, payload, payloadSize);
+        dirtyFds.push_back(client->second.fd);
+    }
+
+    void updateWriteInterest()
+    {
+        for (int fd : dirtyFds) {
+            const auto client = clientByFd.find(fd);
+            if (client == clientByFd.end()) {
+                continue;
+            }
+
+            net::Connection& connection = clients[client->second];
+            connection.flush();
+            epoll_event event = {};
+            event.events = EPOLLIN | (connection.wantsWrite() ? (uint32)EPOLLOUT : 0u);
+            event.data.fd = fd;
+            epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+        dirtyFds.clear();
+    }
+};
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--quiet") {
+            options.quiet = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const std::string value = argv[++i];
+        if (arg == "--snapshot") {
+            options.snapshotPath = value;
+        } else if (arg == "--listen") {
+            options.listenEndpoint = value;
+        } else if (arg == "--poll-ms") {
+            options.pollMs = (uint32)strtoul(value.c_str(), nullptr, 10);
+        } else if (arg == "--kernel" && (value == "scalar" || value == "avx2")) {
+            options.kernel = value == "avx2" ? SCAN_AVX2 : SCAN_SCALAR;
+        } else {
+            return false;
+        }
+    }
+    return !options.snapshotPath.empty() && options.pollMs;
+}
+
+void requestStop(int)
+{
+    stopRequested = 1;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s --snapshot FILE [--listen ENDPOINT] [--poll-ms N] [--kernel scalar|avx2] [--quiet]\n",
+            argv[0]);
+        return 2;
+    }
+    if (options.kernel == SCAN_AVX2 && !avx2Supported()) {
+        fprintf(stderr, "read_replica: no AVX2 on this CPU, using the scalar kernel\n");
+        options.kernel = SCAN_SCALAR;
+    }
+
+    signal(SIGINT, requestStop);
+    signal(SIGTERM, requestStop);
+    signal(SIGPIPE, SIG_IGN);
+
+    ReadReplica replica(options);
+    if (!replica.start()) {
+        return 1;
+    }
+    replica.run();
+    return 0;
+}
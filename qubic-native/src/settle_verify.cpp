@@ -0,0 +1,284 @@
+// settle_verify: checks ResolveEvent / ResolveEvents results off chain with
+// settlement_verifier.h.
+//
+// Self-test (default): builds a contract holding --bets flat bets plus
+// order book activity on --events events, snapshots it, resolves every event
+// with ResolveEvents and verifies the result at 1, 2, 4 and 8 threads. Then
+// tampers with a balance and a bet flag and expects both to be caught.
+// --save DIR also writes DIR/before.snap, DIR/after.snap and the matching
+// --resolve arguments for the file mode.
+//
+// File mode: verifies two state_snapshot.h files against the reported
+// result of each entry, given as EVENT:ANSWER:WINNERS:PAYOUT (0 = NO, 1 = YES)
+// or EVENT:ANSWER:- for an entry the contract skipped.
+//
+// Usage: settle_verify [--bets N] [--events N] [--threads N] [--save DIR]
+//        settle_verify --before FILE --after FILE [--threads N] --resolve ENTRY...
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "contract_host.h"
+#include "settlement_verifier.h"
+#include "state_snapshot.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x736574746c65ULL, 0, 0, 0 } };
+constexpr uint32 BENCH_USERS = 5000;
+constexpr uint32 BENCH_BALANCE = 1000000;
+
+struct Options
+{
+    uint32 bets = MAX_BETS;
+    uint32 events = MAX_RESOLVE_BATCH;
+    uint32 threads = 0;  // 0 = sweep 1, 2, 4, 8
+    std::string saveDir;
+    std::string beforePath;
+    std::string afterPath;
+    std::vector<std::string> entries;
+};
+
+double millisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void printReport(const SettlementReport& report)
+{
+    for (const std::string& detail : report.details) {
+        printf("  %s\n", detail.c_str());
+    }
+    if (report.mismatches > report.details.size()) {
+        printf("  ... %llu more\n", (unsigned long long)(report.mismatches - report.details.size()));
+    }
+}
+
+// Fastest of a few runs, so thread start-up and page faults are not timed
+double timeVerify(SettlementVerifier& verifier, const CONTRACT_STATE& before, const std::vector<Resolution>& resolutions,
+    const std::vector<ResolutionResult>& reported, const CONTRACT_STATE& after, SettlementReport& report)
+{
+    double best = 1e30;
+    for (uint32 run = 0; run < 5; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        report = verifier.verify(before, resolutions, reported, after);
+        best = std::min(best, millisecondsSince(start));
+    }
+    return best;
+}
+
+int selfTest(const Options& options)
+{
+    ContractHost* host = new ContractHost(OPERATOR_ID);
+    CONTRACT_STATE& state = host->instance().state;
+    for (uint32 i = 1; i < BENCH_USERS; i++) {
+        RegisterUserInput input = {};
+        RegisterUserOutput output;
+        host->call(0, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+    for (uint32 i = 0; i < BENCH_USERS; i++) {
+        state.users[i].balance = BENCH_BALANCE;
+    }
+    while (state.eventCount < options.events) {
+        CreateEventInput input = {};
+        CreateEventOutput output;
+        host->call(1, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+
+    // Order book trades first, so positions and resting orders need settling too
+    std::mt19937 rng(23);
+    for (uint32 i = 0; i < options.events * 20; i++) {
+        PlaceOrderInput input = { (uint32)(1 + rng() % BENCH_USERS), (uint32)(1 + rng() % options.events),
+            (uint32)(1 + rng() % 10), (uint8)(rng() & 1), (uint8)(40 + rng() % 21) };
+        PlaceOrderOutput output;
+        host->call(8, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+    while (state.betCount < options.bets) {
+        PlaceBetInput input = {};
+        input.userId = 1 + rng() % BENCH_USERS;
+        input.eventId = 1 + rng() % options.events;
+        input.prediction = (uint8)(rng() & 1);
+        input.amount = 1 + rng() % 20;
+        PlaceBetOutput output;
+        host->call(2, OPERATOR_ID, &input, sizeof(input), &output);
+    }
+
+    CONTRACT_STATE* before = new CONTRACT_STATE(state);
+    ResolveEventsInput input = {};
+    std::vector<Resolution> resolutions;
+    for (uint32 eventId = 1; eventId <= options.events; eventId++) {
+        input.eventIds[eventId - 1] = eventId;
+        input.correctAnswers[eventId - 1] = (uint8)(rng() & 1);
+        resolutions.push_back({ eventId, input.correctAnswers[eventId - 1] });
+    }
+    input.count = (uint8)options.events;
+    ResolveEventsOutput output;
+    const auto start = std::chrono::steady_clock::now();
+    host->call(16, OPERATOR_ID, &input, sizeof(input), &output);
+    const double contractMs = millisecondsSince(start);
+
+    std::vector<ResolutionResult> reported;
+    for (uint32 i = 0; i < options.events; i++) {
+        reported.push_back({ output.winnersCount[i], output.totalPayout[i], output.resolved[i] });
+    }
+
+    printf("%u bets, %u positions, %u events resolved by ResolveEvents in %.2f ms\n\n",
+        before->betCount, before->positionCount, output.resolvedCount, contractMs);
+    printf("%8s %12s %12s %12s\n", "threads", "verify ms", "bets", "mismatches");
+
+    bool ok = true;
+    std::vector<uint32> threadCounts = { 1, 2, 4, 8 };
+    if (options.threads) {
+        threadCounts = { options.threads };
+    }
+    for (uint32 threads : threadCounts) {
+        SettlementVerifier verifier(threads);
+        SettlementReport report;
+        const double ms = timeVerify(verifier, *before, resolutions, reported, state, report);
+        printf("%8u %12.2f %12llu %12llu\n", threads, ms, (unsigned long long)report.settledBets,
+            (unsigned long long)report.mismatches);
+        printReport(report);
+        ok = ok && report.ok() && report.resolvedEvents == options.events;
+    }
+
+    // The verifier must catch a wrong balance and a wrong bet outcome
+    SettlementVerifier verifier(threadCounts.back());
+    CONTRACT_STATE* tampered = new CONTRACT_STATE(state);
+    tampered->users[BENCH_USERS / 2].balance++;
+    tampered->bets[before->betCount / 3].isWon ^= 1;
+    const SettlementReport caught = verifier.verify(*before, resolutions, reported, *tampered);
+    printf("\ntampered state: %llu mismatches\n", (unsigned long long)caught.mismatches);
+    printReport(caught);
+    ok = ok && caught.mismatches == 2;
+
+    if (!options.saveDir.empty()) {
+        const std::string beforePath = options.saveDir + "/before.snap";
+        const std::string afterPath = options.saveDir + "/after.snap";
+        if (!snapshot::save(beforePath.c_str(), *before, host->system())
+            || !snapshot::save(afterPath.c_str(), state, host->system())) {
+            fprintf(stderr, "settle_verify: cannot write snapshots to %s\n", options.saveDir.c_str());
+            ok = false;
+        } else {
+            const std::string argsPath = options.saveDir + "/resolve.args";
+            FILE* args = fopen(argsPath.c_str(), "w");
+            if (args) {
+                for (uint32 i = 0; i < options.events; i++) {
+                    fprintf(args, "%u:%u:%u:%u\n", resolutions[i].eventId, resolutions[i].correctAnswer,
+                        reported[i].winnersCount, reported[i].totalPayout);
+                }
+                fclose(args);
+            }
+            printf("\nwrote %s, %s and %s\n", beforePath.c_str(), afterPath.c_str(), argsPath.c_str());
+        }
+    }
+
+    delete tampered;
+    delete before;
+    delete host;
+    printf(ok ? "\nSettlement verified, and tampering detected.\n" : "\nSettlement check FAILED.\n");
+    return ok ? 0 : 1;
+}
+
+bool parseEntry(const std::string& text, Resolution& resolution, ResolutionResult& result)
+{
+    unsigned eventId;
+    unsigned answer;
+    unsigned winners;
+    unsigned payout;
+    char skipped;
+    if (sscanf(text.c_str(), "%u:%u:%u:%u", &eventId, &answer, &winners, &payout) == 4) {
+        result = { winners, payout, 1 };
+    } else if (sscanf(text.c_str(), "%u:%u:%c", &eventId, &answer, &skipped) == 3 && skipped == '-') {
+        result = { 0, 0, 0 };
+    } else {
+        return false;
+    }
+    resolution = { eventId, (uint8)answer };
+    return answer <= 1;
+}
+
+int verifyFiles(const Options& options)
+{
+    std::vector<Resolution> resolutions(options.entries.size());
+    std::vector<ResolutionResult> reported(options.entries.size());
+    for (size_t i = 0; i < options.entries.size(); i++) {
+        if (!parseEntry(options.entries[i], resolutions[i], reported[i])) {
+            fprintf(stderr, "settle_verify: bad entry '%s'\n", options.entries[i].c_str());
+            return 2;
+        }
+    }
+
+    CONTRACT_STATE* before = new CONTRACT_STATE;
+    CONTRACT_STATE* after = new CONTRACT_STATE;
+    if (!snapshot::load(options.beforePath.c_str(), *before) || !snapshot::load(options.afterPath.c_str(), *after)) {
+        fprintf(stderr, "settle_verify: cannot load snapshots (missing, or from another build of HM25.h)\n");
+        return 1;
+    }
+
+    SettlementVerifier verifier(options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency()));
+    SettlementReport report;
+    const double ms = timeVerify(verifier, *before, resolutions, reported, *after, report);
+    printf("%u events, %llu bets verified on %u threads in %.2f ms: %llu mismatches\n", report.resolvedEvents,
+        (unsigned long long)report.settledBets, verifier.threads(), ms, (unsigned long long)report.mismatches);
+    printReport(report);
+
+    delete before;
+    delete after;
+    return report.ok() ? 0 : 1;
+}
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "--resolve") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') {
+                options.entries.push_back(argv[++i]);
+            }
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--bets") {
+            options.bets = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--events") {
+            options.events = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--threads") {
+            options.threads = (uint32)strtoul(value, nullptr, 10);
+        } else if (arg == "--save") {
+            options.saveDir = value;
+        } else if (arg == "--before") {
+            options.beforePath = value;
+        } else if (arg == "--after") {
+            options.afterPath = value;
+        } else {
+            return false;
+        }
+    }
+    if (!options.beforePath.empty() || !options.afterPath.empty()) {
+        return !options.beforePath.empty() && !options.afterPath.empty() && !options.entries.empty();
+    }
+    return options.bets && options.bets <= MAX_BETS && options.events >= 4 && options.events <= MAX_RESOLVE_BATCH;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [--bets N] [--events N] [--threads N] [--save DIR]\n", argv[0]);
+        fprintf(stderr, "       %s --before FILE --after FILE [--threads N] --resolve EVENT:ANSWER:WINNERS:PAYOUT...\n", argv[0]);
+        return 2;
+    }
+    return options.beforePath.empty() ? selfTest(options) : verifyFiles(options);
+}
@@ -0,0 +1,125 @@
+// state_layout: size, alignment and padding of the record structs in
+// CONTRACT_STATE (state_layout.h), and what their arrays cost at the
+// configured capacities. Checks them against the budgets in state_layout.h
+// and exits 1 on any regression, so `make layout` can gate a change.
+//
+// --json prints the same report as one JSON object for scripts and CI.
+//
+// Usage: state_layout [--json]
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "state_layout.h"
+
+namespace
+{
+
+using namespace state_layout;
+
+std::vector<std::string> findRegressions()
+{
+    std::vector<std::string> regressions;
+    char line[160];
+    for (const StructInfo& info : STRUCTS) {
+        if (info.size > info.sizeBudget) {
+            snprintf(line, sizeof(line), "%s size %u exceeds budget %u", info.name, info.size, info.sizeBudget);
+            regressions.push_back(line);
+        }
+        if (padding(info) > info.paddingBudget) {
+            snprintf(line, sizeof(line), "%s padding %u exceeds budget %u", info.name, padding(info), info.paddingBudget);
+            regressions.push_back(line);
+        }
+    }
+    if (sizeof(CONTRACT_STATE) > STATE_SIZE_BUDGET) {
+        snprintf(line, sizeof(line), "CONTRACT_STATE size %zu exceeds budget %llu", sizeof(CONTRACT_STATE),
+            (unsigned long long)STATE_SIZE_BUDGET);
+        regressions.push_back(line);
+    }
+    return regressions;
+}
+
+void printText(const std::vector<std::string>& regressions)
+{
+    uint64 records = 0;
+    uint64 wasted = 0;
+    printf("%-12s %6s %5s %6s %7s %9s %12s %11s holes\n", "struct", "size", "align", "fields", "padding", "capacity",
+        "array bytes", "padding");
+    for (const StructInfo& info : STRUCTS) {
+        printf("%-12s %6u %5u %6u %7u %9u %12llu %11llu", info.name, info.size, info.align, fieldBytes(info),
+            padding(info), info.capacity, (unsigned long long)arrayBytes(info), (unsigned long long)arrayPadding(info));
+        for (uint32 i = 1; i <= info.fieldCount; i++) {
+            if (holeBefore(info, i)) {
+                printf(" %u after %s", holeBefore(info, i), info.fields[i - 1].name);
+            }
+        }
+        printf("\n");
+        records += arrayBytes(info);
+        wasted += arrayPadding(info);
+    }
+
+    const uint64 stateSize = sizeof(CONTRACT_STATE);
+    printf("\nCONTRACT_STATE %llu bytes (%.2f MiB), budget %llu\n", (unsigned long long)stateSize,
+        stateSize / 1048576.0, (unsigned long long)STATE_SIZE_BUDGET);
+    printf("record arrays %llu bytes (%.1f%% of state), %llu of them padding (%.1f%%)\n", (unsigned long long)records,
+        100.0 * records / stateSize, (unsigned long long)wasted, 100.0 * wasted / stateSize);
+    for (const std::string& regression : regressions) {
+        printf("REGRESSION: %s\n", regression.c_str());
+    }
+}
+
+void printJson(const std::vector<std::string>& regressions)
+{
+    uint64 records = 0;
+    uint64 wasted = 0;
+    printf("{\n  \"structs\": [\n");
+    for (uint32 s = 0; s < STRUCT_COUNT; s++) {
+        const StructInfo& info = STRUCTS[s];
+        printf("    {\"name\": \"%s\", \"size\": %u, \"align\": %u, \"fieldBytes\": %u, \"padding\": %u, "
+            "\"capacity\": %u, \"arrayBytes\": %llu, \"arrayPadding\": %llu, \"sizeBudget\": %u, "
+            "\"paddingBudget\": %u, \"holes\": [", info.name, info.size, info.align, fieldBytes(info), padding(info),
+            info.capacity, (unsigned long long)arrayBytes(info), (unsigned long long)arrayPadding(info),
+            info.sizeBudget, info.paddingBudget);
+        const char* separator = "";
+        for (uint32 i = 1; i <= info.fieldCount; i++) {
+            if (holeBefore(info, i)) {
+                printf("%s{\"after\": \"%s\", \"offset\": %u, \"bytes\": %u}", separator, info.fields[i - 1].name,
+                    info.fields[i - 1].offset + info.fields[i - 1].size, holeBefore(info, i));
+                separator = ", ";
+            }
+        }
+        printf("]}%s\n", s + 1 < STRUCT_COUNT ? "," : "");
+        records += arrayBytes(info);
+        wasted += arrayPadding(info);
+    }
+
+    printf("  ],\n  \"stateSize\": %zu,\n  \"stateBudget\": %llu,\n  \"recordBytes\": %llu,\n  \"paddingBytes\": %llu,\n",
+        sizeof(CONTRACT_STATE), (unsigned long long)STATE_SIZE_BUDGET, (unsigned long long)records,
+        (unsigned long long)wasted);
+    printf("  \"regressions\": [");
+    for (size_t i = 0; i < regressions.size(); i++) {
+        printf("%s\"%s\"", i ? ", " : "", regressions[i].c_str());
+    }
+    printf("]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const bool json = argc == 2 && !strcmp(argv[1], "--json");
+    if (argc > 2 || (argc == 2 && !json)) {
+        fprintf(stderr, "usage: %s [--json]\n", argv[0]);
+        return 2;
+    }
+
+    const std::vector<std::string> regressions = findRegressions();
+    if (json) {
+        printJson(regressions);
+    } else {
+        printText(regressions);
+    }
+    return regressions.empty() ? 0 : 1;
+}
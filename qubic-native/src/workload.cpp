@@ -0,0 +1,302 @@
+// workload: drives the PredictoR contract in-process with scenario files
+// (see scenario.h) and reports throughput and p50/p99/p99.9 latency per
+// procedure, plus tick time, so skewed workloads can be compared on one box.
+//
+// Reads run as they are issued. Transactions (bets, resolutions) queue up
+// and are applied at the end of the tick under the scenario's tick_budget,
+// as mock_node applies its mempool.
+//
+// Usage: workload scenario.ini [scenario.ini ...]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <vector>
+
+#include "contract_host.h"
+#include "scenario.h"
+
+namespace
+{
+
+constexpr m256i OPERATOR_ID = { { 0x776f726b6c6f6164ULL, 0, 0, 0 } };
+
+const char* const CONTRACT_REJECTION_REASONS[REJECT_REASON_COUNT] = {
+    "contractInactive", "capacityFull", "unauthorized", "userNotFound",
+    "insufficientBalance", "eventNotFound", "eventClosed", "invalidOrder", "orderNotFound",
+    "noMarketMaker", "invalidConfig", "invalidBatch", "exposureLimit", "invalidOutcome",
+};
+
+struct QueuedTransaction
+{
+    uint16 function;
+    std::function<void()> apply;
+};
+
+struct ProcedureStats
+{
+    const char* name = nullptr;
+    LatencyRecorder latency;
+    uint64 failures = 0;
+};
+
+class WorkloadRun
+{
+public:
+    explicit WorkloadRun(const Scenario& scenario)
+        : scenario(scenario), host(OPERATOR_ID), rng(scenario.seed), zipf(scenario.events, scenario.zipfSkew),
+          budget(scenario.tickBudget)
+    {
+        procedures[STAT_REGISTER_USER].name = "RegisterUser";
+        procedures[STAT_CREATE_EVENT].name = "CreateEvent";
+        procedures[STAT_PLACE_BET].name = "PlaceBet";
+        procedures[STAT_RESOLVE_EVENT].name = "ResolveEvent";
+        procedures[STAT_GET_BALANCE].name = "GetBalance";
+    }
+
+    void run()
+    {
+        // Initialize created user 1; register the rest
+        for (uint32 i = 1; i < scenario.users; i++) {
+            RegisterUserInput input = {};
+            snprintf(input.username, sizeof(input.username), "user%u", i + 1);
+            RegisterUserOutput output;
+            call(STAT_REGISTER_USER, input, output);
+        }
+
+        markets.resize(scenario.events);
+        for (uint32 rank = 0; rank < scenario.events; rank++) {
+            markets[rank] = createMarket();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32 tick = 0; tick < scenario.ticks; tick++) {
+            const auto tickStart = std::chrono::steady_clock::now();
+            runTick(tick);
+            tickLatency.record(elapsedNanoseconds(tickStart));
+
+            host.advanceTick();
+            if (host.system().tick % scenario.ticksPerEpoch == 0) {
+                host.advanceEpoch();
+            }
+        }
+        wallNanoseconds = elapsedNanoseconds(start);
+    }
+
+    void report()
+    {
+        printf("== %s ==\n", scenario.name.c_str());
+        printf("users=%u events=%u outcomes=%u zipf_skew=%.2f ticks=%u bets/tick=%u reads/tick=%u resolve every %u ticks x%u\n",
+            scenario.users, scenario.events, scenario.outcomes, scenario.zipfSkew, scenario.ticks, scenario.betsPerTick,
+            scenario.readsPerTick, scenario.resolveEveryTicks, scenario.resolveCount);
+        printf("hottest market takes %.1f%% of bets, hottest 10 take %.1f%%\n\n",
+            zipf.headShare(1) * 100, zipf.headShare(10) * 100);
+
+        const double tickTotal = (double)tickNanosecondsInProcedures();
+        printf("%-14s %9s %9s %12s %10s %10s %10s %8s\n",
+            "procedure", "calls", "failed", "calls/s", "p50 us", "p99 us", "p99.9 us", "tick %");
+        for (ProcedureStats& procedure : procedures) {
+            if (!procedure.name || procedure.latency.count() == 0) {
+                continue;
+            }
+            const double seconds = procedure.latency.totalNanoseconds() / 1e9;
+            printf("%-14s %9zu %9llu %12.0f %10.2f %10.2f %10.2f %7.1f%%\n",
+                procedure.name, procedure.latency.count(), (unsigned long long)procedure.failures,
+                procedure.latency.count() / seconds,
+                procedure.latency.percentile(0.5) / 1e3, procedure.latency.percentile(0.99) / 1e3,
+                procedure.latency.percentile(0.999) / 1e3,
+                tickTotal == 0 ? 0.0 : procedureTickNanoseconds[&procedure - procedures] * 100.0 / tickTotal);
+        }
+
+        printf("\ntick time: p50 %.1f us, p99 %.1f us, p99.9 %.1f us; %.0f ticks/s\n",
+            tickLatency.percentile(0.5) / 1e3, tickLatency.percentile(0.99) / 1e3,
+            tickLatency.percentile(0.999) / 1e3, scenario.ticks / (wallNanoseconds / 1e9));
+
+        const CONTRACT_STATE& state = host.instance().state;
+        budgetReport.print(stdout, scenario.tickBudget);
+        printf("%s, max queue %zu\n", !scenario.tickBudget ? "" : scenario.overBudget == OVER_BUDGET_REJECT ? " (reject)" : " (defer)",
+            queueMax);
+        printf("contract: users=%u events=%u bets=%u settlementBacklog=%u\n",
+            state.userCount, state.eventCount, state.betCount, state.settlementBacklog);
+        printf("rejections:");
+        for (uint32 reason = 0; reason < REJECT_REASON_COUNT; reason++) {
+            if (state.rejectionCount[reason]) {
+                printf(" %s=%u", CONTRACT_REJECTION_REASONS[reason], state.rejectionCount[reason]);
+            }
+        }
+        printf("\n\n");
+    }
+
+private:
+    const Scenario& scenario;
+    ContractHost host;
+    std::mt19937_64 rng;
+    ZipfSampler zipf;
+
+    std::vector<uint32> markets;  // Event id per popularity rank
+    uint32 nextResolveRank = 0;
+
+    ProcedureStats procedures[STAT_PROCEDURE_COUNT];
+    uint64 procedureTickNanoseconds[STAT_PROCEDURE_COUNT] = {};
+    LatencyRecorder tickLatency;
+    uint64 wallNanoseconds = 0;
+    bool inTick = false;
+
+    std::deque<QueuedTransaction> queue;  // Deferred transactions stay at the front
+    size_t queueMax = 0;
+    TickBudget budget;
+    BudgetReport budgetReport;
+
+    static uint64 elapsedNanoseconds(std::chrono::steady_clock::time_point start)
+    {
+        return (uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    uint64 tickNanosecondsInProcedures() const
+    {
+        uint64 total = 0;
+        for (uint32 i = 0; i < STAT_PROCEDURE_COUNT; i++) {
+            total += procedureTickNanoseconds[i];
+        }
+        return total;
+    }
+
+    // Times one contract call; every HM25 output struct carries `success`
+    template <typename Input, typename Output>
+    void call(uint32 functionIndex, const Input& input, Output& output)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        host.call((uint16)functionIndex, OPERATOR_ID, &input, sizeof(input), &output);
+        const uint64 elapsed = elapsedNanoseconds(start);
+
+        ProcedureStats& procedure = procedures[functionIndex];
+        procedure.latency.record(elapsed);
+        if (!output.success) {
+            procedure.failures++;
+        }
+        if (inTick) {
+            procedureTickNanoseconds[functionIndex] += elapsed;
+        }
+    }
+
+    // 1 = YES with probability yesFraction in a binary market, uniform otherwise
+    uint8 randomOutcome(double yesFraction)
+    {
+        if (scenario.outcomes > 2) {
+            return (uint8)std::uniform_int_distribution<uint32>(0, scenario.outcomes - 1)(rng);
+        }
+        return std::bernoulli_distribution(yesFraction)(rng) ? 1 : 0;
+    }
+
+    uint32 createMarket()
+    {
+        CreateEventInput input = {};
+        snprintf(input.title, sizeof(input.title), "Workload market %u", host.instance().state.eventCount + 1);
+        snprintf(input.category, sizeof(input.category), "Load");
+        input.endsAt = host.system().tick + scenario.ticks;
+        input.outcomeCount = (uint8)scenario.outcomes;
+        CreateEventOutput output;
+        call(STAT_CREATE_EVENT, input, output);
+        return output.eventId;
+    }
+
+    void runTick(uint32 tick)
+    {
+        inTick = true;
+
+        // Interleave bets and reads in random order
+        uint32 betsLeft = scenario.betsPerTick;
+        uint32 readsLeft = scenario.readsPerTick;
+        while (betsLeft + readsLeft) {
+            if (std::uniform_int_distribution<uint32>(1, betsLeft + readsLeft)(rng) <= betsLeft) {
+                betsLeft--;
+                PlaceBetInput input;
+                input.userId = randomUser();
+                input.eventId = markets[zipf.sample(rng)];
+                input.prediction = randomOutcome(scenario.yesFraction);
+                input.amount = sampleBetSize(scenario, rng);
+                queue.push_back({ STAT_PLACE_BET, [this, input] {
+                    PlaceBetOutput output;
+                    call(STAT_PLACE_BET, input, output);
+                } });
+            } else {
+                readsLeft--;
+                GetBalanceInput input;
+                input.userId = randomUser();
+                GetBalanceOutput output;
+                call(STAT_GET_BALANCE, input, output);
+            }
+        }
+
+        if (scenario.resolveEveryTicks && (tick + 1) % scenario.resolveEveryTicks == 0) {
+            for (uint32 i = 0; i < scenario.resolveCount; i++) {
+                const uint32 rank = nextResolveRank++ % scenario.events;
+                ResolveEventInput input;
+                input.eventId = markets[rank];
+                input.correctAnswer = randomOutcome(0.5);
+                input.confidence = 100;
+                queue.push_back({ STAT_RESOLVE_EVENT, [this, input, rank] {
+                    ResolveEventOutput output;
+                    call(STAT_RESOLVE_EVENT, input, output);
+                    markets[rank] = createMarket();
+                } });
+            }
+        }
+
+        applyQueue();
+        inTick = false;
+    }
+
+    // Applies queued transactions in order while they fit the tick budget
+    void applyQueue()
+    {
+        queueMax = std::max(queueMax, queue.size());
+        while (!queue.empty()) {
+            const QueuedTransaction& transaction = queue.front();
+            if (!budget.admit(transaction.function)) {
+                if (scenario.overBudget == OVER_BUDGET_DEFER) {
+                    budget.defer((uint32)queue.size());
+                    break;
+                }
+                budget.reject();
+                procedures[transaction.function].failures++;
+                queue.pop_front();
+                continue;
+            }
+            transaction.apply();
+            budget.charge(host.instance().state, transaction.function);
+            queue.pop_front();
+        }
+        budgetReport.add(budget.endTick(), scenario.tickBudget);
+    }
+
+    uint32 randomUser()
+    {
+        return std::uniform_int_distribution<uint32>(1, scenario.users)(rng);
+    }
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s scenario.ini [scenario.ini ...]\n", argv[0]);
+        return 2;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        Scenario scenario;
+        if (!loadScenario(argv[i], scenario)) {
+            return 1;
+        }
+
+        WorkloadRun run(scenario);
+        run.run();
+        run.report();
+    }
+    return 0;
+}